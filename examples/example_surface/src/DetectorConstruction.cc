@@ -127,7 +127,9 @@ G4VPhysicalVolume *DetectorConstruction::Construct() {
                                   240, 240, // repeat loaded volume in x and y
                                   cubeMaterial, // material
                                   world_mat, // material of envelope
-                                  verboseLvl}; // verbose level
+                                  verboseLvl, // verbose level
+                                  Surface::LogicalSurface::PlacementMode::Replica,
+                                  false}; // check overlaps of elements
 
   //top
   const auto shift_to_zero = surface->get_shift_to_zero();
@@ -6,13 +6,20 @@
  */
 
 #include "DetectorConstruction.hh"
-#include "G4RunManager.hh"
 #include "G4UIExecutive.hh"
 #include "G4UImanager.hh"
+#include "G4Version.hh"
 #include "G4VisExecutive.hh"
 #include "PhysicsList.hh"
 #include "ActionInitialization.hh"
-#include "RunAction.hh"
+
+#if G4VERSION_NUMBER >= 1070
+#include "G4RunManagerFactory.hh"
+#elif defined(G4MULTITHREADED)
+#include "G4MTRunManager.hh"
+#else
+#include "G4RunManager.hh"
+#endif
 
 int main(int argc, char **argv) {
   G4cout << "Surface test application starting ..." << G4endl;
@@ -25,9 +32,16 @@ int main(int argc, char **argv) {
     const G4String command = argv[1];
     ui = new G4UIExecutive(argc, argv, command);
   }
-  // Construct the default run manager
+  // Construct the run manager, number of threads is set with
+  // /run/numberOfThreads in the macro
+#if G4VERSION_NUMBER >= 1070
+  auto *runManager =
+      G4RunManagerFactory::CreateRunManager(G4RunManagerType::Default);
+#elif defined(G4MULTITHREADED)
+  auto *runManager = new G4MTRunManager;
+#else
   auto *runManager = new G4RunManager;
-
+#endif
 
   // Initialize visualization
   G4VisManager *visManager = new G4VisExecutive();
@@ -40,7 +54,6 @@ int main(int argc, char **argv) {
   // Detector construction
   runManager->SetUserInitialization(new DetectorConstruction());
   runManager->SetUserInitialization(new ActionInitialization());
-  runManager->SetUserAction(new RunAction());
   // Get the pointer to the User Interface manager
   G4UImanager *UImanager = G4UImanager::GetUIpointer();
 
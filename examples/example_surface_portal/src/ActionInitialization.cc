@@ -6,15 +6,19 @@
 
 #include "ActionInitialization.hh"
 #include "PrimaryGeneratorAction.hh"
+#include "RunAction.hh"
 #include "SteppingAction.hh"
 
 ActionInitialization::ActionInitialization() : G4VUserActionInitialization() {}
 
 ActionInitialization::~ActionInitialization() = default;
 
-void ActionInitialization::BuildForMaster() const {}
+void ActionInitialization::BuildForMaster() const {
+  SetUserAction(new RunAction());
+}
 
 void ActionInitialization::Build() const {
+  SetUserAction(new RunAction());
   SetUserAction(new PrimaryGeneratorAction);
   SetUserAction(new SteppingAction());
 }
\ No newline at end of file
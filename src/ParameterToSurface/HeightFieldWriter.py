@@ -0,0 +1,40 @@
+from numpy.typing import NDArray
+import numpy as np
+import struct
+
+class HeightFieldWriter:
+    """
+    Writes the height map as binary height field file, read by Surface::HeightFieldSolid.
+    Layout (little endian): char[8] "SC4HMAP", uint32 version, uint32 nx, uint32 ny,
+    float64 length_x, length_y, body_height, float32 height[ny][nx]. Lengths in um.
+    """
+
+    def __init__(self, heightmap: NDArray, length: tuple[float, float], body_height: float, output_file: str) -> None:
+        self.magic = b"SC4HMAP"
+        self.version = 1
+        self.extension = ".hmap"
+        heights = np.ascontiguousarray(heightmap, dtype="<f4")
+        if heights.ndim != 2 or heights.shape[0] < 2 or heights.shape[1] < 2:
+            raise ValueError("Stopped generation of height field file, height map needs at least 2x2 points!")
+        if body_height <= 0 or np.any(heights + body_height <= 0):
+            raise ValueError("Stopped generation of height field file, surface must lie above bottom of body!")
+        self.write_height_field(heights, length, body_height, output_file)
+
+    def write_height_field(self, heights: NDArray, length: tuple[float, float], body_height: float,
+                           output_file: str) -> None:
+        ny, nx = heights.shape
+        header = struct.pack("<8sIIIddd", self.magic, self.version, nx, ny,
+                             float(length[0]), float(length[1]), float(body_height))
+        output_file = output_file + self.extension
+        with open(output_file, "wb") as file:
+            file.write(header)
+            file.write(heights.tobytes())
+
+
+def main():
+    heightmap = np.array([[0.0, 1.0, 0.0], [1.0, 2.0, 1.0]])
+    HeightFieldWriter(heightmap, (2.0, 1.0), 10.0, "test_height_field")
+
+
+if __name__ == "__main__":
+    main()
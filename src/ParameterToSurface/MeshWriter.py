@@ -0,0 +1,45 @@
+from numpy.typing import NDArray
+import numpy as np
+import struct
+
+class MeshWriter:
+    """
+    Writes a triangle mesh as binary mesh file, read (memory mapped) by Surface::MeshFile.
+    Layout (little endian): char[8] "SC4MESH", uint32 version, uint32 vertex_bytes, uint64 n_vertices,
+    uint64 n_faces, float64 length_unit (mm), vertex[n_vertices][3], uint32 face[n_faces][3].
+    """
+
+    def __init__(self, vertices: NDArray[tuple[float,float,float]], faces: NDArray[tuple[int,int,int]],
+                 output_file: str, double_precision: bool = True) -> None:
+        self.magic = b"SC4MESH"
+        self.version = 1
+        self.unit = 1e-3  # um, same as GDMLWriter
+        self.extension = ".smesh"
+        vertex_type = "<f8" if double_precision else "<f4"
+        vertices = np.ascontiguousarray(vertices, dtype=vertex_type)
+        faces = np.asarray(faces)
+        if vertices.ndim != 2 or vertices.shape[1] != 3 or faces.ndim != 2 or faces.shape[1] != 3:
+            raise ValueError("Stopped generation of mesh file, vertices and faces need 3 columns!")
+        if faces.size == 0 or faces.min() < 0 or faces.max() >= len(vertices) or len(vertices) > 0xFFFFFFFF:
+            raise ValueError("Stopped generation of mesh file, face index out of range!")
+        faces = np.ascontiguousarray(faces, dtype="<u4")
+        self.write_mesh(vertices, faces, output_file)
+
+    def write_mesh(self, vertices: NDArray, faces: NDArray, output_file: str) -> None:
+        header = struct.pack("<8sIIQQd", self.magic, self.version, vertices.itemsize,
+                             len(vertices), len(faces), self.unit)
+        output_file = output_file + self.extension
+        with open(output_file, "wb") as file:
+            file.write(header)
+            file.write(vertices.tobytes())
+            file.write(faces.tobytes())
+
+
+def main():
+    vertices = np.array([[0.0,1.0,0.0],[0.0,0.0,1.0],[0.0,0.0,0.0],[0.0,1.0,1.0]])
+    faces = np.array([[0,1,2],[0,1,3]])
+    MeshWriter(vertices, faces, "test_mesh")
+
+
+if __name__ == "__main__":
+    main()
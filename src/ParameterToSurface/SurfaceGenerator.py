@@ -5,6 +5,8 @@ from pathlib import Path
 import sys
 
 from GDMLWriter import GDMLWriter
+from HeightFieldWriter import HeightFieldWriter
+from MeshWriter import MeshWriter
 from HeightMap import HeightMap, HeightMapParameters
 from Surface import Surface
 
@@ -110,7 +112,8 @@ def exec_program(config: Config, control) -> None:
         return
 
     heightmap = None
-    if control["heightmap"] or control["parameters"] or control["surface"] or control["gdml"]:
+    if (control["heightmap"] or control["parameters"] or control["surface"] or control["gdml"]
+            or control["mesh"] or control["heightfield"]):
         # --- Generate height map
         heightmap = HeightMap(n=(config["grid_nx"], config["grid_ny"]),length=(config["grid_lx"], config["grid_ly"]))
 
@@ -134,7 +137,7 @@ def exec_program(config: Config, control) -> None:
         heightmap.plot(plot_heightmap_export_path, show=show_plot)
 
     surface = None
-    if control["surface"] or control["parameters"] or control["gdml"]:
+    if control["surface"] or control["parameters"] or control["gdml"] or control["mesh"]:
         surface = Surface(heightmap=heightmap, body_height=config["body_height"])
 
         if control["surface"] and not control["silent"]:
@@ -152,6 +155,15 @@ def exec_program(config: Config, control) -> None:
         solid_name = config["solid_name"]
         GDMLWriter(surface.mesh.vertices, surface.mesh.faces, solid_name, gdml_filename)
 
+    if control["mesh"]:
+        mesh_filename = config["export_name"]
+        MeshWriter(surface.mesh.vertices, surface.mesh.faces, mesh_filename)
+
+    if control["heightfield"]:
+        height_field_filename = config["export_name"]
+        HeightFieldWriter(heightmap.heightmap, (config["grid_lx"], config["grid_ly"]), config["body_height"],
+                          height_field_filename)
+
 
 def main():
     parser = argparse.ArgumentParser(description='CLI tool to generate surface',
@@ -172,6 +184,8 @@ def main():
         "parameters": "Calculate parameters",
         "surface": "Plot surface",
         "gdml": "Generate GDML file",
+        "mesh": "Generate binary mesh file (.smesh)",
+        "heightfield": "Generate height field file (.hmap)",
         "silent": "Generate no graphical output"
     }
     for name, description in control_params.items():
@@ -13,7 +13,7 @@
 #include "ParticleGenerator/include/PointShift.hh"
 #include "Portal/include/MultipleSubworld.hh"
 #include "Portal/include/SubworldGrid.hh"
-#include "Service/include/VSampler.hh"
+#include "Service/include/AliasTable.hh"
 
 namespace Surface {
 
@@ -24,6 +24,19 @@ struct Coord {
 
 std::ostream &operator<<(std::ostream &os, const Coord &coord);
 
+/**
+ * @brief Samples primaries on the surfaces of the subworlds of a portal
+ * @details Sampling is done in two steps. First a subworld type is selected
+ * with a weight of its surface area times its number of cells in the grid,
+ * then a cell of this type is selected uniformly. Types covering at least
+ * kListShare of the grid are sampled by rejection over the grid. For rarer
+ * types the cells are listed once by PrepareSampler(), which also counts the
+ * cells of each type. Hashed grids with more than kMaxScannedCells cells are
+ * not scanned, their weights use the cell counts expected from the density
+ * and all their types are sampled by rejection. If the rejection of such a
+ * type fails, its cells are listed by a scan of the grid. A type without any
+ * cell gets weight zero and the type is drawn again.
+ */
 class MultiSubworldSampler : public G4VPrimaryGenerator {
  public:
   MultiSubworldSampler(G4String name, G4String portalName,
@@ -39,9 +52,24 @@ class MultiSubworldSampler : public G4VPrimaryGenerator {
 
   inline G4bool IsSamplerReady() const { return fSamplerReady; }
 
+  /**
+   * @brief Samples n vertices into a vertex file, see VertexStream
+   * @details Vertices are sampled as by GeneratePrimaryVertex() and stored
+   * with their surface normal and grid position. Blocks are written by a
+   * background thread while the next block is sampled.
+   * @return false if the file could not be written
+   */
+  G4bool WriteVertices(const G4String &filename, std::size_t n);
+
  private:
+  void FindSubworld();
   void PrepareSampler();
-  G4ThreeVector GetRandom();
+  G4ThreeVector GetRandom(G4ThreeVector &surfaceNormal);
+  Coord SampleCell(std::size_t type);
+  /// counts the cells of all types and lists the cells of the rare types
+  void FillCellLists();
+  /// lists the cells of one type, @return false if the type has no cell
+  G4bool ListCells(std::size_t type);
   std::string Information() const;
 
  private:
@@ -50,7 +78,15 @@ class MultiSubworldSampler : public G4VPrimaryGenerator {
   SubworldGrid<MultipleSubworld> *fSubworld{nullptr};
   Surface::PointShift fShift;
   const G4bool fShiftActive;
-  VSampler<Coord> fSubworldSampler;
+  std::vector<MultipleSubworld *> fTypes;  // subworld types in grid
+  std::vector<G4double> fTypeCells;        // cells of each type, expected
+                                           // for large hashed grids
+  std::vector<G4double> fTypeWeight;       // area times cells of each type
+  // cells of each rare type, empty if the type is sampled by rejection
+  std::vector<std::vector<std::size_t>> fTypeCellList;
+  static constexpr G4double kListShare{1. / 16.};
+  static constexpr std::size_t kMaxScannedCells{std::size_t{1} << 24};
+  AliasTable fTypeSampler;
   G4bool fSamplerReady;
   Logger fLogger;
   G4GeneralParticleSource *fParticleGenerator;
@@ -42,6 +42,8 @@ private:
   G4UIcmdWithADoubleAndUnit *fCmdSetMinShift;
   G4UIcmdWithADoubleAndUnit *fCmdSetMaxShift;
   G4UIcmdWithAString *fCmdConfineToMaterial;
+  G4UIcmdWithAString *fCmdConfinementMode;
+  G4UIcmdWithoutParameter *fCmdPrintConfinementStatistics;
 };
 } // namespace Surface
 
@@ -0,0 +1,69 @@
+/**
+ * @brief Definition of class VertexStream
+ * @author agent
+ * @date 2026-10-17
+ * @file VertexStream.hh
+ */
+
+#ifndef SRC_PARTICLEGENERATOR_INCLUDE_VERTEXSTREAM_HH
+#define SRC_PARTICLEGENERATOR_INCLUDE_VERTEXSTREAM_HH
+
+#include <cstdint>
+
+#include "G4GeneralParticleSource.hh"
+#include "G4ThreeVector.hh"
+#include "G4VPrimaryGenerator.hh"
+#include "Service/include/Logger.hh"
+#include "Service/include/VertexFile.hh"
+
+namespace Surface {
+
+class VertexStreamMessenger;
+
+/**
+ * @brief Replays the vertices of a vertex file as primary vertices
+ * @details The file is written by MultiSubworldSampler::WriteVertices() or
+ * Source::write_vertices(). Particle, energy and direction come from a
+ * G4GeneralParticleSource as for the samplers, only the position is replaced.
+ * Primaries of vertices with a grid position carry it as
+ * SubworldPrimaryInformation. Jobs sharing one file select disjoint shards
+ * with SetShard() or /Surface/VertexStream/<name>/setShard. If a job needs more events than its shard holds, the shard
+ * is replayed again and a warning is written.
+ */
+class VertexStream : public G4VPrimaryGenerator {
+ public:
+  VertexStream(G4String name, G4String filename,
+               VerboseLevel verboseLvl = VerboseLevel::Default);
+  ~VertexStream() override;
+  void GeneratePrimaryVertex(G4Event *event) override;
+
+  /// Replays shard index of count equal shards of the file
+  void SetShard(std::uint64_t index, std::uint64_t count);
+  /// Replays the records [first, first + count) of the file
+  void SetRange(std::uint64_t first, std::uint64_t count);
+
+  /// Surface normal of the last generated vertex
+  inline const G4ThreeVector &GetNormal() const { return fNormal; }
+
+ private:
+  void Open();
+
+ private:
+  const G4String fName;
+  const G4String fFilename;
+  VertexFileReader fReader;
+  G4bool fOpen{false};
+  std::uint64_t fShardIndex{0};
+  std::uint64_t fShardCount{1};
+  std::uint64_t fFirst{0};
+  std::uint64_t fCount{0};
+  G4bool fUseRange{false};
+  std::uint64_t fWarnedRestarts{0};
+  G4ThreeVector fNormal;
+  Logger fLogger;
+  G4GeneralParticleSource *fParticleGenerator;
+  VertexStreamMessenger *fMessenger;
+};
+}  // namespace Surface
+
+#endif  // SRC_PARTICLEGENERATOR_INCLUDE_VERTEXSTREAM_HH
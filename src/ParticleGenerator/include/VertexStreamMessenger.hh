@@ -0,0 +1,43 @@
+/**
+ * @brief Definition of class VertexStreamMessenger
+ * @author agent
+ * @date 2026-10-17
+ * @file VertexStreamMessenger.hh
+ */
+
+#ifndef SRC_PARTICLEGENERATOR_INCLUDE_VERTEXSTREAMMESSENGER_HH
+#define SRC_PARTICLEGENERATOR_INCLUDE_VERTEXSTREAMMESSENGER_HH
+
+#include "G4String.hh"
+#include "G4UImessenger.hh"
+
+class G4UIcommand;
+class G4UIdirectory;
+
+namespace Surface {
+
+class VertexStream;
+
+/**
+ * @brief Selects the replayed records of a VertexStream via macro files
+ * @details Commands in /Surface/VertexStream/<name>/, the selection is applied
+ * when the next vertex is generated.
+ */
+class VertexStreamMessenger : public G4UImessenger {
+ public:
+  VertexStreamMessenger(Surface::VertexStream *stream, const G4String &name);
+  ~VertexStreamMessenger() override;
+
+  void SetNewValue(G4UIcommand *command, G4String newValues) override;
+
+ private:
+  Surface::VertexStream *fStream;
+  G4UIdirectory *fDirectory;
+  G4UIdirectory *fSubDirectory;
+  G4UIdirectory *fStreamName;
+  G4UIcommand *fCmdSetShard;
+  G4UIcommand *fCmdSetRange;
+};
+}  // namespace Surface
+
+#endif  // SRC_PARTICLEGENERATOR_INCLUDE_VERTEXSTREAMMESSENGER_HH
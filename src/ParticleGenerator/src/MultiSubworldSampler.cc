@@ -5,16 +5,22 @@
  * @file MultiSubworldSampler.cc
  */
 
+#include <algorithm>
+#include <map>
 #include <utility>
 
 #include "G4GeneralParticleSource.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
 #include "G4ThreeVector.hh"
 #include "ParticleGenerator/include/MultiSubworldSampler.hh"
 #include "Portal/include/MultipleSubworld.hh"
 #include "Portal/include/PortalStore.hh"
 #include "Portal/include/SubworldGrid.hh"
+#include "Portal/include/SubworldTrackInformation.hh"
 #include "Service/include/Locator.hh"
-#include "SurfaceGenerator/include/Calculator.hh"
+#include "Service/include/Profiler.hh"
+#include "Service/include/VertexFile.hh"
 #include "SurfaceGenerator/include/FacetStore.hh"
 
 std::ostream &Surface::operator<<(std::ostream &os, const Coord &coord) {
@@ -29,7 +35,6 @@ Surface::MultiSubworldSampler::MultiSubworldSampler(G4String name,
       fPortalName{std::move(portalName)},
       fShift{verboseLvl},
       fShiftActive(false),
-      fSubworldSampler(VSampler<Coord>{"MultiSubworldSampler_" + fName}),
       fSamplerReady(false),
       fLogger("MultiSubworldSampler_" + fName, verboseLvl),
       fParticleGenerator(new G4GeneralParticleSource) {
@@ -42,7 +47,6 @@ Surface::MultiSubworldSampler::MultiSubworldSampler(
       fPortalName(std::move(portalName)),
       fShift(shiftFilename, verboseLvl),
       fShiftActive(true),
-      fSubworldSampler(VSampler<Coord>{"MultiSubworldSampler_" + fName}),
       fSamplerReady(false),
       fLogger("MultiSubworldSampler_" + fName, verboseLvl),
       fParticleGenerator(new G4GeneralParticleSource) {
@@ -52,86 +56,228 @@ Surface::MultiSubworldSampler::~MultiSubworldSampler() {
 
 }
 
-void Surface::MultiSubworldSampler::GeneratePrimaryVertex(G4Event *event) {
-  if (!fSamplerReady) {  // if Sampler not ready
-    fLogger.WriteInfo("Sampler not ready -> now preparing ...");
-
-    Surface::PortalStore pStore = Surface::Locator::GetPortalStore();
-    const G4int portalId = pStore.FindPortalId(fPortalName);
-    if (portalId < 0) {
-      fLogger.WriteError("Error: No portal with name \"" + fPortalName +
-                         "\" found!!");
-      G4String possible_names = "Possible names: ";
-      fLogger.WriteError("Possible portals in Store are:");
-      for (auto &portal : pStore) {
-        possible_names = possible_names + ", " + portal->GetName();
-        fLogger.WriteError(portal->GetName());
-      }
-      G4String error_msg = "Error: No portal with name " + fPortalName + " found!\n" + possible_names;
-      G4Exception("MultiSubworldSampler::GeneratePrimaryVertex()",
-                  "",
-                  FatalException,
-                  error_msg);
+void Surface::MultiSubworldSampler::FindSubworld() {
+  fLogger.WriteInfo("Sampler not ready -> now preparing ...");
+
+  const Surface::PortalStore &pStore = Surface::Locator::GetPortalStore();
+  const G4int portalId = pStore.FindPortalId(fPortalName);
+  if (portalId < 0) {
+    fLogger.WriteError("Error: No portal with name \"" + fPortalName +
+                       "\" found!!");
+    G4String possible_names = "Possible names: ";
+    fLogger.WriteError("Possible portals in Store are:");
+    for (auto &portal : pStore) {
+      possible_names = possible_names + ", " + portal->GetName();
+      fLogger.WriteError(portal->GetName());
     }
+    G4String error_msg = "Error: No portal with name " + fPortalName + " found!\n" + possible_names;
+    G4Exception("MultiSubworldSampler::GeneratePrimaryVertex()",
+                "",
+                FatalException,
+                error_msg);
+  }
+
+  auto *subworld =
+      dynamic_cast<Surface::MultipleSubworld *>(pStore[portalId]);
+  SetSubworld(subworld->GetSubworldGrid());
+}
 
-    auto *subworld =
-        dynamic_cast<Surface::MultipleSubworld *>(pStore[portalId]);
-    SetSubworld(subworld->GetSubworldGrid());
+void Surface::MultiSubworldSampler::GeneratePrimaryVertex(G4Event *event) {
+  if (!fSamplerReady) {  // if Sampler not ready
+    FindSubworld();
   }
 
   fParticleGenerator->GeneratePrimaryVertex(event);
-  const G4ThreeVector position = GetRandom();
-  event->GetPrimaryVertex()->SetPosition(position.x(), position.y(),
-                                         position.z());
+  G4ThreeVector surfaceNormal;
+  const G4ThreeVector position = GetRandom(surfaceNormal);
+  G4PrimaryVertex *vertex = event->GetPrimaryVertex();
+  vertex->SetPosition(position.x(), position.y(), position.z());
+  // primaries keep their subworld, independent of other tracks
+  const GridPosition gridPosition{fSubworld->CurrentPosX(),
+                                  fSubworld->CurrentPosY()};
+  for (G4int i = 0; i < vertex->GetNumberOfParticle(); ++i) {
+    vertex->GetPrimary(i)->SetUserInformation(
+        new SubworldPrimaryInformation(gridPosition));
+  }
+}
+
+G4bool Surface::MultiSubworldSampler::WriteVertices(const G4String &filename,
+                                                    const std::size_t n) {
+  if (!fSamplerReady) {
+    FindSubworld();
+  }
+  VertexFileWriter writer(filename);
+  if (!writer.Open()) {
+    fLogger.WriteError("Cannot create vertex file " + filename);
+    return false;
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    G4ThreeVector normal;
+    const G4ThreeVector position = GetRandom(normal);
+    writer.Append(VertexRecord{{position.x(), position.y(), position.z()},
+                               {normal.x(), normal.y(), normal.z()},
+                               fSubworld->CurrentPosX(),
+                               fSubworld->CurrentPosY()});
+  }
+  if (!writer.Close()) {
+    fLogger.WriteError("Writing vertex file " + filename + " failed");
+    return false;
+  }
+  fLogger.WriteInfo("Wrote " + std::to_string(n) + " vertices to " + filename);
+  return true;
 }
 
-G4ThreeVector Surface::MultiSubworldSampler::GetRandom() {
+G4ThreeVector Surface::MultiSubworldSampler::GetRandom(
+    G4ThreeVector &surfaceNormal) {
+  SCORE4_PROFILE_SCOPE("MultiSubworldSampler::GetRandom");
   if (!fSamplerReady) {
     PrepareSampler();
   }
 
-  const Coord randomCoord = fSubworldSampler.GetRandom();
+  const Coord randomCoord = SampleCell(fTypeSampler.Sample());
 
   fSubworld->SetCurrentX(randomCoord.x);
   fSubworld->SetCurrentY(randomCoord.y);
   MultipleSubworld *subworld = fSubworld->GetSubworld();
   FacetStore *facetStore = subworld->GetFacetStore();
 
-  if (!facetStore->GetIsStoreClosed()) {
-    facetStore->CloseFacetStore();
-  }
-
-  G4ThreeVector surfaceNormal;
   G4ThreeVector randomPoint = facetStore->GetRandomPoint(surfaceNormal);
   if (fShiftActive) {
     fShift.DoShift(randomPoint, surfaceNormal);
   }
-  fLogger.WriteDebugInfo(
-      "Selected Subworld X: " + std::to_string(randomCoord.x) +
-      " Y: " + std::to_string(randomCoord.y));
+  SCORE4_LOG_DEBUG(fLogger,
+                   "Selected Subworld X: " + std::to_string(randomCoord.x) +
+                       " Y: " + std::to_string(randomCoord.y));
   return randomPoint;
 }
 
-void Surface::MultiSubworldSampler::PrepareSampler() {
-  const std::set<MultipleSubworld *> unique = fSubworld->GetUniqueSubworlds();
-  std::map<MultipleSubworld *, G4double> surfaceArea;
-  for (auto *subworld : unique) {
-    fLogger.WriteDetailInfo("From Subworld: " + subworld->GetName());
-    FacetStore *facetStore = subworld->GetFacetStore();
-    fLogger.WriteDetailInfo("get FacetStore: " + facetStore->GetStoreName());
-    Calculator calc(facetStore);
-    surfaceArea[subworld] = calc.GetArea();
+Surface::Coord Surface::MultiSubworldSampler::SampleCell(
+    const std::size_t type) {
+  const G4int maxY = fSubworld->MaxY();
+  const std::size_t nCells = fSubworld->NumberOfCells();
+  const MultipleSubworld *subworld = fTypes[type];
+  auto cellToCoord = [maxY](const std::size_t cell) {
+    return Coord{static_cast<G4int>(cell / maxY),
+                 static_cast<G4int>(cell % maxY)};
+  };
+  auto randomIndex = [](const std::size_t size) {
+    const auto idx =
+        static_cast<std::size_t>(G4UniformRand() * static_cast<G4double>(size));
+    return std::min(idx, size - 1);
+  };
+  const std::vector<std::size_t> &cellList = fTypeCellList[type];
+  if (!cellList.empty()) {
+    return cellToCoord(cellList[randomIndex(cellList.size())]);
+  }
+  // expected number of tries is nCells / fTypeCells[type]
+  const G4double maxTries =
+      100. * static_cast<G4double>(nCells) / std::max(fTypeCells[type], 1.);
+  for (G4double tries = 0; tries < maxTries; ++tries) {
+    const Coord coord = cellToCoord(randomIndex(nCells));
+    if (fSubworld->GetSubworld(coord.x, coord.y) == subworld) {
+      return coord;
+    }
   }
+  // only reached for a large hashed grid holding far fewer cells of the type
+  // than its density predicts
+  fLogger.WriteWarning("Subworld " + subworld->GetName() +
+                       " not found by rejection, listing its cells");
+  if (ListCells(type)) {
+    return SampleCell(type);
+  }
+  fLogger.WriteWarning("Subworld " + subworld->GetName() +
+                       " has no cell in the grid, its weight is set to zero");
+  fTypeCells[type] = 0.;
+  fTypeWeight[type] = 0.;
+  fTypeSampler.Build(fTypeWeight);
+  return SampleCell(fTypeSampler.Sample());
+}
 
-  const G4int maxX = fSubworld->MaxX();
+G4bool Surface::MultiSubworldSampler::ListCells(const std::size_t type) {
+  const MultipleSubworld *subworld = fTypes[type];
+  std::vector<std::size_t> &cellList = fTypeCellList[type];
+  cellList.clear();
   const G4int maxY = fSubworld->MaxY();
-  for (G4int x = 0; x < maxX; ++x) {
+  for (G4int x = 0; x < fSubworld->MaxX(); ++x) {
     for (G4int y = 0; y < maxY; ++y) {
-      auto *subworld = fSubworld->GetSubworld(x, y);
-      fSubworldSampler.AppendValue(Coord{x, y});
-      fSubworldSampler.AppendProbability(surfaceArea[subworld]);
+      if (fSubworld->GetSubworld(x, y) == subworld) {
+        cellList.push_back(static_cast<std::size_t>(x) *
+                               static_cast<std::size_t>(maxY) +
+                           static_cast<std::size_t>(y));
+      }
     }
   }
+  return !cellList.empty();
+}
+
+void Surface::MultiSubworldSampler::FillCellLists() {
+  const auto nCells = static_cast<G4double>(fSubworld->NumberOfCells());
+  std::map<const MultipleSubworld *, std::size_t> typeIndex;
+  std::vector<G4bool> rare(fTypes.size(), false);
+  for (std::size_t type = 0; type < fTypes.size(); ++type) {
+    typeIndex.emplace(fTypes[type], type);
+    if (fTypeCells[type] < kListShare * nCells) {
+      rare[type] = true;
+      fTypeCellList[type].reserve(static_cast<std::size_t>(fTypeCells[type]));
+    }
+  }
+  std::vector<std::size_t> count(fTypes.size(), 0);
+  const G4int maxY = fSubworld->MaxY();
+  for (G4int x = 0; x < fSubworld->MaxX(); ++x) {
+    for (G4int y = 0; y < maxY; ++y) {
+      const auto it = typeIndex.find(fSubworld->GetSubworld(x, y));
+      if (it == typeIndex.end()) {
+        continue;
+      }
+      ++count[it->second];
+      if (rare[it->second]) {
+        fTypeCellList[it->second].push_back(
+            static_cast<std::size_t>(x) * static_cast<std::size_t>(maxY) +
+            static_cast<std::size_t>(y));
+      }
+    }
+  }
+  // hashed grids only predict the counts
+  for (std::size_t type = 0; type < fTypes.size(); ++type) {
+    fTypeCells[type] = static_cast<G4double>(count[type]);
+  }
+}
+
+void Surface::MultiSubworldSampler::PrepareSampler() {
+  fTypes.clear();
+  fTypeCells.clear();
+  fTypeWeight.clear();
+  const std::map<MultipleSubworld *, G4double> cells =
+      fSubworld->CountSubworlds();
+  for (const auto &ele : cells) {
+    if (ele.second > 0.) {
+      fTypes.push_back(ele.first);
+    }
+  }
+  // fixed order of types, random numbers are used reproducibly
+  std::sort(fTypes.begin(), fTypes.end(),
+            [](const MultipleSubworld *a, const MultipleSubworld *b) {
+              return a->GetName() < b->GetName();
+            });
+  for (auto *subworld : fTypes) {
+    fLogger.WriteDetailInfo("From Subworld: " + subworld->GetName());
+    FacetStore *facetStore = subworld->GetFacetStore();
+    fLogger.WriteDetailInfo("get FacetStore: " + facetStore->GetStoreName());
+    if (!facetStore->GetIsStoreClosed()) {
+      facetStore->CloseFacetStore();
+    }
+    fTypeCells.push_back(cells.at(subworld));
+  }
+  fTypeCellList.assign(fTypes.size(), {});
+  if (fSubworld->GetStorage() != GridStorage::Hashed ||
+      fSubworld->NumberOfCells() <= kMaxScannedCells) {
+    FillCellLists();
+  }
+  for (std::size_t type = 0; type < fTypes.size(); ++type) {
+    fTypeWeight.push_back(fTypes[type]->GetFacetStore()->GetArea() *
+                          fTypeCells[type]);
+  }
+  fTypeSampler.Build(fTypeWeight);
 
   fSamplerReady = true;
   fLogger.WriteInfo("MultiSubworldSampler is ready.");
@@ -155,17 +301,16 @@ std::string Surface::MultiSubworldSampler::Information() const {
   ss << "Subworlds: (Name) , (FacetStoreName) , (SurfaceArea), (Placement)\n";
   ss << "\n";
 
-  const std::set<MultipleSubworld *> unique = fSubworld->GetUniqueSubworlds();
-  std::map<MultipleSubworld *, G4double> surfaceArea;
-  for (auto *subworld : unique) {
-    FacetStore *facetStore = subworld->GetFacetStore();
-    Calculator calc(facetStore);
+  for (std::size_t i = 0; i < fTypes.size(); ++i) {
+    const MultipleSubworld *subworld = fTypes[i];
+    const FacetStore *facetStore = subworld->GetFacetStore();
     const G4ThreeVector facetStoreTrafo = facetStore->GetTransformation();
     ss << std::setw(20) << std::right << subworld->GetName()
        << " FacetStore: " << std::setw(20) << facetStore->GetStoreName()
-       << " Area: " << calc.GetArea() / (CLHEP::mm * CLHEP::mm)
+       << " Area: " << facetStore->GetArea() / (CLHEP::mm * CLHEP::mm)
        << " mm^2 Placement:" << facetStoreTrafo.x() << " "
-       << facetStoreTrafo.y() << " " << facetStoreTrafo.z() << "\n";
+       << facetStoreTrafo.y() << " " << facetStoreTrafo.z()
+       << " Sampled: " << fTypeSampler.GetProbability(i) * 100. << " %\n";
   }
   ss << "\n";
   ss << fSubworld->StreamStatistic().str();
@@ -7,87 +7,36 @@
 
 #include "ParticleGenerator/include/PointShift.hh"
 
-#include <cstdlib>
-#include <fstream>
-#include <limits>
 #include <string>
 
-#include "G4Material.hh"
-#include "G4SystemOfUnits.hh"
 #include "G4ThreeVector.hh"
-#include "G4TransportationManager.hh"
 #include "G4Types.hh"
-#include "G4VPhysicalVolume.hh"
 #include "ParticleGenerator/include/PointShiftMessenger.hh"
-#include "Randomize.hh"
+#include "Service/include/Profiler.hh"
 
 Surface::PointShift::PointShift(const VerboseLevel verbose)
-    : fShiftTableReady(false),
-      fMinShift(0.),
-      fMaxShift(DBL_MAX),
-      fConfineMaterialName(""),
-      fLogger("Shift", verbose),
+    : fLogger("Shift", verbose),
       fMessenger(new Surface::PointShiftMessenger(this)) {}
 
 Surface::PointShift::PointShift(const G4String &filename, const VerboseLevel verbose)
-    : fShiftTableReady(false),
-      fMinShift(0.),
-      fMaxShift(DBL_MAX),
-      fConfineMaterialName(""),
-      fLogger("Shift", verbose),
+    : fLogger("Shift", verbose),
       fMessenger(new Surface::PointShiftMessenger(this)) {
   LoadShiftTable(filename);
 }
 
-G4double Surface::PointShift::CalcShift() {
-  G4double random = G4UniformRand();
-  for (size_t i = 0; i < fBarProbability.size(); ++i) {
-    if (random <= fBarProbability[i]) {
-      return Interpolate(i) * CLHEP::nm;
-    }
-  }
-  G4Exception("PointShift::CalcShift()",
-              "",
-              FatalException,
-              "should never happen.");
-}
-
 void Surface::PointShift::DoShift(G4ThreeVector &position,
                              const G4ThreeVector &direction) {
-  if (!fShiftTableReady) {
+  SCORE4_PROFILE_SCOPE("PointShift::DoShift");
+  if (!fShiftTable.IsReady()) {
     fLogger.WriteError(
         "Shift called, but ShiftTable not ready\n"
         "No shift done!");
     return;
   }
 
-  G4int counter{0};
-  while (true) {
-    const G4double shift = CalcShift();
-
-    const G4ThreeVector normedDirection = direction / direction.r();
-    const G4ThreeVector newPosition = position - normedDirection * shift;
-
-    ++counter;
-    if (counter > 10000) {
-      fLogger.WriteError(
-          "Counter of ShiftTable > 10,000! Now performing shift "
-          "with value outside marked area");
-      position = newPosition;
-      return;
-    }
-
-    if (fMinShift > shift || shift > fMaxShift) {
-      continue;
-    }
-
-    if (!IsConfinedToMaterial(newPosition)) {
-      continue;
-    }
-    fLogger.WriteDebugInfo("Shift done: " + std::to_string(shift));
-    position = newPosition;
-    return;
-  }
+  const G4ThreeVector normedDirection = direction / direction.r();
+  position -= normedDirection * fConfinement.SampleShift(
+      fShiftTable, position, normedDirection, fLogger);
 }
 
 void Surface::PointShift::DoShiftByValue(const G4double shift,
@@ -98,15 +47,7 @@ void Surface::PointShift::DoShiftByValue(const G4double shift,
 }
 
 std::stringstream Surface::PointShift::StreamShiftTable() const {
-  std::stringstream ss;
-  ss << "Shift table:\n";
-  for (size_t i = 0; i < fProbability.size(); ++i) {
-    ss << "Shift: " << std::setw(10) << fShift[i]
-       << " Counts: " << std::setw(10) << fProbability[i]
-       << " Summed probability: " << std::setw(10) << fBarProbability[i]
-       << "\n";
-  }
-  return ss;
+  return fShiftTable.StreamInfo();
 }
 
 void Surface::PointShift::PrintShiftTable() {
@@ -114,105 +55,46 @@ void Surface::PointShift::PrintShiftTable() {
 }
 
 void Surface::PointShift::LoadShiftTable(const std::string &filename) {
-  std::ifstream file;
-  file.open(filename);
-  if (!file.is_open()) {
+  if (!fShiftTable.Load(filename)) {
     fLogger.WriteError("File for shift table not found at: " + filename);
     return;
   }
-  std::string line;
-  const std::string delimiter = ",";
-  while (getline(file, line)) {
-    const auto pos = line.find(delimiter);
-    const G4double depth = std::stod(line.substr(0, pos));
-    const G4double counts = std::stod(line.substr(pos + 1, pos + line.size()));
-    fShift.push_back(depth);
-    fProbability.push_back(counts);
-  }
-  file.close();
-  G4double counts{0};
-  for (size_t i = 0; i < fProbability.size() - 1; ++i) {
-    counts += Interpolate(0.5, fProbability.at(i), fProbability.at(i + 1));
-  }
-
-  G4double probability{0};
-  for (size_t i = 0; i < fProbability.size() - 1; ++i) {
-    probability +=
-        Interpolate(0.5, fProbability.at(i), fProbability.at(i + 1)) / counts;
-    fBarProbability.push_back(probability);
-  }
-  fShiftTableReady = true;
-}
-
-G4double Surface::PointShift::Interpolate(const G4double xNormed,
-                                     const G4double lowerY,
-                                     const G4double upperY) {
-  const G4double k = (upperY - lowerY);
-  const G4double result = lowerY + xNormed * k;
-  return result;
-}
-
-G4double Surface::PointShift::Interpolate(const size_t idx) {
-  const G4double a = fProbability[idx];
-  const G4double b = fProbability[idx + 1];
-  const G4double rand = G4UniformRand();
-  const G4double minShift = fShift[idx];
-  const G4double maxShift = fShift[idx + 1];
-  auto IsZero = [](const G4double a) {
-    const G4double numeric_limit =
-        std::numeric_limits<G4double>::epsilon() * 10;
-    return fabs(a) < numeric_limit;
-  };
-  G4double tmp = 0;
-  if (IsZero(b - a)) {
-    tmp = rand;
-  } else {
-    tmp = sqrt(a * a * (1 - rand) + b * b * rand);
-    tmp -= a;
-    tmp /= (b - a);
+  if (!fShiftTable.IsReady()) {
+    fLogger.WriteError("Shift table without counts in: " + filename);
   }
-  const G4double shift = minShift + tmp * (maxShift - minShift);
-  // fLogger.WriteDebugInfo("prob[idx]: " + std::to_string(lowProb) +
-  //                        " prob[idx + 1]: " + std::to_string(highProb) +
-  //                        " minShift: " + std::to_string(minShift) +
-  //                        " maxShift: " + std::to_string(maxShift) +
-  //                        " rand: " + std::to_string(rand) +
-  //                        " result: " + std::to_string(shift));
-  return shift;
+  WarnIfRangeEmpty();
 }
 
 void Surface::PointShift::SetMinShift(const G4double min) {
-  fMinShift = min;
+  fShiftTable.SetMin(min);
   fLogger.WriteInfo("Min shift set to " + std::to_string(min));
+  WarnIfRangeEmpty();
 }
 void Surface::PointShift::SetMaxShift(const G4double max) {
-  fMaxShift = max;
+  fShiftTable.SetMax(max);
   fLogger.WriteInfo("Max shift set to " + std::to_string(max));
+  WarnIfRangeEmpty();
 }
 
-G4bool Surface::PointShift::IsConfinedToMaterial(const G4ThreeVector &point) {
-  if (fConfineMaterialName.empty()) {
-    return true;
+void Surface::PointShift::WarnIfRangeEmpty() const {
+  if (fShiftTable.IsReady() && fShiftTable.IsRangeEmpty()) {
+    fLogger.WriteWarning(
+        "No shift of the table between min and max shift, shifts are drawn "
+        "from the full table");
   }
-  G4ThreeVector null(0., 0., 0.);
-
-  const G4VPhysicalVolume *physVol =
-      G4TransportationManager::GetTransportationManager()
-          ->GetNavigatorForTracking()
-          ->LocateGlobalPointAndSetup(point, &null, true);
+}
 
-  const G4String matName =
-      physVol->GetLogicalVolume()->GetMaterial()->GetName();
+void Surface::PointShift::ConfineToMaterial(const G4String &materialName) {
+  fConfinement.SetMaterial(materialName);
+}
 
-  fLogger.WriteDebugInfo("Material Name of physical Volume is: " + matName);
-  if (matName == fConfineMaterialName) {
-    return true;
-  }
-  return false;
+void Surface::PointShift::SetConfinementMode(
+    const MaterialConfinement::Mode mode) {
+  fConfinement.SetMode(mode);
 }
 
-void Surface::PointShift::ConfineToMaterial(const G4String &materialName) {
-  fConfineMaterialName = materialName;
+void Surface::PointShift::PrintConfinementStatistics() const {
+  fLogger.WriteInfo(fConfinement.StreamStatistics().str());
 }
 
 void Surface::PointShift::SetVerboseLvl(const VerboseLevel verboseLvl) {
@@ -20,7 +20,8 @@ Surface::PointShiftMessenger::PointShiftMessenger(Surface::PointShift *shift)
     : fShift(shift), fDirectory(nullptr), fCmdVerbose(nullptr),
       fCmdPrintShiftTable(nullptr), fCmdLoadShiftTable(nullptr),
       fCmdSetMinShift(nullptr), fCmdSetMaxShift(nullptr),
-      fCmdConfineToMaterial(nullptr) {
+      fCmdConfineToMaterial(nullptr), fCmdConfinementMode(nullptr),
+      fCmdPrintConfinementStatistics(nullptr) {
 
   fDirectory = new G4UIdirectory("/shift/");
   fDirectory->SetGuidance("Controls the shift of the particle source");
@@ -61,6 +62,23 @@ Surface::PointShiftMessenger::PointShiftMessenger(Surface::PointShift *shift)
                                             G4State_Idle);
   fCmdConfineToMaterial->SetGuidance("Confine shift point to material");
   fCmdConfineToMaterial->SetDefaultValue("");
+
+  fCmdConfinementMode =
+      new G4UIcmdWithAString("/shift/setConfinementMode", this);
+  fCmdConfinementMode->AvailableForStates(G4State_PreInit, G4State_Init,
+                                          G4State_Idle);
+  fCmdConfinementMode->SetGuidance(
+      "boundary: draw depths within the material found along the shift "
+      "direction, rejection: draw until the point is in the material");
+  fCmdConfinementMode->SetCandidates("boundary rejection");
+  fCmdConfinementMode->SetDefaultValue("boundary");
+
+  fCmdPrintConfinementStatistics =
+      new G4UIcmdWithoutParameter("/shift/printConfinementStatistics", this);
+  fCmdPrintConfinementStatistics->AvailableForStates(
+      G4State_PreInit, G4State_Init, G4State_Idle);
+  fCmdPrintConfinementStatistics->SetGuidance(
+      "Print locates per shift done for the material confinement");
 }
 
 Surface::PointShiftMessenger::~PointShiftMessenger() {
@@ -78,6 +96,10 @@ Surface::PointShiftMessenger::~PointShiftMessenger() {
   fCmdSetMaxShift = nullptr;
   delete fCmdConfineToMaterial;
   fCmdConfineToMaterial = nullptr;
+  delete fCmdConfinementMode;
+  fCmdConfinementMode = nullptr;
+  delete fCmdPrintConfinementStatistics;
+  fCmdPrintConfinementStatistics = nullptr;
 }
 
 void Surface::PointShiftMessenger::SetNewValue(G4UIcommand *command,
@@ -94,5 +116,11 @@ void Surface::PointShiftMessenger::SetNewValue(G4UIcommand *command,
     fShift->SetMaxShift(G4UIcmdWithADoubleAndUnit::GetNewDoubleValue(newValues));
   } else if (command == fCmdConfineToMaterial) {
     fShift->ConfineToMaterial(newValues);
+  } else if (command == fCmdConfinementMode) {
+    fShift->SetConfinementMode(newValues == "rejection"
+                                   ? MaterialConfinement::Mode::Rejection
+                                   : MaterialConfinement::Mode::Boundary);
+  } else if (command == fCmdPrintConfinementStatistics) {
+    fShift->PrintConfinementStatistics();
   }
 }
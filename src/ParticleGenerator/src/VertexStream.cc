@@ -0,0 +1,103 @@
+/**
+ * @brief Implementation of class VertexStream
+ * @author agent
+ * @date 2026-10-17
+ * @file VertexStream.cc
+ */
+
+#include "ParticleGenerator/include/VertexStream.hh"
+
+#include <string>
+#include <utility>
+
+#include "G4Event.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+#include "ParticleGenerator/include/VertexStreamMessenger.hh"
+#include "Portal/include/SubworldTrackInformation.hh"
+
+Surface::VertexStream::VertexStream(G4String name, G4String filename,
+                                    const VerboseLevel verboseLvl)
+    : fName(std::move(name)),
+      fFilename(std::move(filename)),
+      fLogger("VertexStream_" + fName, verboseLvl),
+      fParticleGenerator(new G4GeneralParticleSource),
+      fMessenger(new VertexStreamMessenger(this, fName)) {}
+
+Surface::VertexStream::~VertexStream() {
+  delete fMessenger;
+  delete fParticleGenerator;
+}
+
+void Surface::VertexStream::SetShard(const std::uint64_t index,
+                                     const std::uint64_t count) {
+  if (count == 0 || index >= count) {
+    G4Exception("VertexStream::SetShard()", "", FatalException,
+                ("Shard " + std::to_string(index) + " of " +
+                 std::to_string(count) + " does not exist")
+                    .c_str());
+  }
+  fShardIndex = index;
+  fShardCount = count;
+  fUseRange = false;
+  fOpen = false;
+}
+
+void Surface::VertexStream::SetRange(const std::uint64_t first,
+                                     const std::uint64_t count) {
+  fFirst = first;
+  fCount = count;
+  fUseRange = true;
+  fOpen = false;
+}
+
+void Surface::VertexStream::Open() {
+  if (!fReader.Open(fFilename)) {
+    G4Exception("VertexStream::Open()", "", FatalException,
+                ("Cannot read vertex file " + fFilename).c_str());
+  }
+  const std::uint64_t size = fReader.GetSize();
+  if (fUseRange) {
+    fReader.SetRange(fFirst, fCount);
+  } else {
+    fReader.SetShard(fShardIndex, fShardCount);
+  }
+  if (fReader.GetRangeSize() == 0) {
+    G4Exception("VertexStream::Open()", "", FatalException,
+                ("No vertices in the selected range of " + fFilename).c_str());
+  }
+  fWarnedRestarts = 0;
+  fOpen = true;
+  fLogger.WriteInfo("Replaying " + std::to_string(fReader.GetRangeSize()) +
+                    " of " + std::to_string(size) + " vertices from " +
+                    fFilename + ", starting at " +
+                    std::to_string(fReader.GetRangeBegin()));
+}
+
+void Surface::VertexStream::GeneratePrimaryVertex(G4Event *event) {
+  if (!fOpen) {
+    Open();
+  }
+  const VertexRecord &record = fReader.Next();
+  if (fReader.GetRestarts() > fWarnedRestarts) {
+    fWarnedRestarts = fReader.GetRestarts();
+    fLogger.WriteWarning("All vertices of " + fFilename +
+                         " used, replaying them again (pass " +
+                         std::to_string(fWarnedRestarts + 1) + ")");
+  }
+  fNormal.set(record.normal[0], record.normal[1], record.normal[2]);
+
+  fParticleGenerator->GeneratePrimaryVertex(event);
+  // the vertex just added, the event may hold vertices of other generators
+  G4PrimaryVertex *vertex =
+      event->GetPrimaryVertex(event->GetNumberOfPrimaryVertex() - 1);
+  vertex->SetPosition(record.position[0], record.position[1],
+                      record.position[2]);
+  if (record.cellX >= 0 && record.cellY >= 0) {
+    const GridPosition gridPosition{record.cellX, record.cellY};
+    for (G4int i = 0; i < vertex->GetNumberOfParticle(); ++i) {
+      vertex->GetPrimary(i)->SetUserInformation(
+          new SubworldPrimaryInformation(gridPosition));
+    }
+  }
+}
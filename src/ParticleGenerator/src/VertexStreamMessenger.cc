@@ -0,0 +1,74 @@
+/**
+ * @brief Implementation of class VertexStreamMessenger
+ * @author agent
+ * @date 2026-10-17
+ * @file VertexStreamMessenger.cc
+ */
+
+#include "ParticleGenerator/include/VertexStreamMessenger.hh"
+
+#include <cstdint>
+#include <sstream>
+
+#include "G4ApplicationState.hh"
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+#include "ParticleGenerator/include/VertexStream.hh"
+
+Surface::VertexStreamMessenger::VertexStreamMessenger(
+    Surface::VertexStream *stream, const G4String &name)
+    : fStream(stream) {
+  fDirectory = new G4UIdirectory("/Surface/");
+  fDirectory->SetGuidance("Controls the Surface library.");
+  fSubDirectory = new G4UIdirectory("/Surface/VertexStream/");
+  fSubDirectory->SetGuidance("Controls the replay of vertex files.");
+  const G4String ctrlPath = "/Surface/VertexStream/" + name + "/";
+  fStreamName = new G4UIdirectory(ctrlPath);
+  fStreamName->SetGuidance("Controls the VertexStream " + name + ".");
+
+  fCmdSetShard = new G4UIcommand(ctrlPath + "setShard", this);
+  fCmdSetShard->AvailableForStates(G4State_PreInit, G4State_Init,
+                                   G4State_Idle);
+  fCmdSetShard->SetGuidance(
+      "Replay shard index of count equal shards of the vertex file");
+  auto *shardIndex = new G4UIparameter("index", 'i', false);
+  shardIndex->SetParameterRange("index >= 0");
+  fCmdSetShard->SetParameter(shardIndex);
+  auto *shardCount = new G4UIparameter("count", 'i', false);
+  shardCount->SetParameterRange("count >= 1");
+  fCmdSetShard->SetParameter(shardCount);
+
+  fCmdSetRange = new G4UIcommand(ctrlPath + "setRange", this);
+  fCmdSetRange->AvailableForStates(G4State_PreInit, G4State_Init,
+                                   G4State_Idle);
+  fCmdSetRange->SetGuidance(
+      "Replay the records [first, first + count) of the vertex file");
+  auto *rangeFirst = new G4UIparameter("first", 'i', false);
+  rangeFirst->SetParameterRange("first >= 0");
+  fCmdSetRange->SetParameter(rangeFirst);
+  auto *rangeCount = new G4UIparameter("count", 'i', false);
+  rangeCount->SetParameterRange("count >= 1");
+  fCmdSetRange->SetParameter(rangeCount);
+}
+
+Surface::VertexStreamMessenger::~VertexStreamMessenger() {
+  delete fCmdSetRange;
+  delete fCmdSetShard;
+  delete fStreamName;
+  delete fSubDirectory;
+  delete fDirectory;
+}
+
+void Surface::VertexStreamMessenger::SetNewValue(G4UIcommand *command,
+                                                 G4String newValues) {
+  std::istringstream values(newValues);
+  std::uint64_t first{0};
+  std::uint64_t count{0};
+  values >> first >> count;
+  if (command == fCmdSetShard) {
+    fStream->SetShard(first, count);
+  } else if (command == fCmdSetRange) {
+    fStream->SetRange(first, count);
+  }
+}
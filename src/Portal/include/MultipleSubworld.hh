@@ -40,14 +40,6 @@ class MultipleSubworld : public VPortal {
     Z_DOWN
   };
 
-  /**
-   * @brief definition of portation type
-   * @details Enter: enters portal volume
-   * Exit: exits portal volume
-   * Periodic: enters another subworld (only possible if already in portal)
-   */
-  enum class PortationType { ENTER, EXIT, PERIODIC };
-
  public:
   MultipleSubworld(const G4String &name, G4VPhysicalVolume *volume,
                    const G4ThreeVector &vec, VerboseLevel verbose = VerboseLevel::Default,
@@ -62,7 +54,8 @@ class MultipleSubworld : public VPortal {
   void DoPortation(G4Step *step) override;
 
   // Setter
-  void SetGrid(G4int nX, G4int nY, VerboseLevel verbose = VerboseLevel::Default);
+  void SetGrid(G4int nX, G4int nY, VerboseLevel verbose = VerboseLevel::Default,
+               GridStorage storage = GridStorage::Dense);
 
   void SetGrid(SubworldGrid<MultipleSubworld> *grid);
 
@@ -97,6 +90,11 @@ class MultipleSubworld : public VPortal {
 
   Direction GetNearestSurface(const G4Step *step);
 
+  Direction GetNearestSurfaceBox(const G4ThreeVector &point,
+                                 const G4ThreeVector &direction) const;
+
+  static Direction CombineDirections(Direction X, Direction Y, Direction Z);
+
   PortationType GetPortationType(Direction);
 
   void DoPeriodicTransform(G4ThreeVector &vec, Direction);
@@ -114,6 +112,11 @@ class MultipleSubworld : public VPortal {
   MultipleSubworld *fPortal{};  // TO DO: replace this or delete it!! In transform
                               // function, example values must be set
   G4double fEdgeX{}, fEdgeY{}, fEdgeZ{};
+  // Extents of fPortal, cached by SetOtherPortal(..)
+  G4ThreeVector fOtherExtent;
+  G4ThreeVector fOtherHalfExtent;
+  G4ThreeVector fInvOtherExtent;
+  G4double fScaleZ{1.};  // z-extent of fPortal / z-extent of this volume
   G4bool fIsPortal;  // True if it is the portal, false if it is the periodic
                      // subworld
   SubworldGrid<MultipleSubworld> *fSubworldGrid;
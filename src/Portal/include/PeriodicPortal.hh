@@ -7,9 +7,11 @@
 #ifndef SRC_PORTAL_INCLUDE_PERIODICPORTAL_HH_
 #define SRC_PORTAL_INCLUDE_PERIODICPORTAL_HH_
 
+#include "G4Cache.hh"
 #include "G4Step.hh"
 #include "G4ThreeVector.hh"
 #include "G4VPhysicalVolume.hh"
+#include "Portal/include/SubworldGrid.hh"
 #include "Portal/include/VPortal.hh"
 #include "Service/include/Logger.hh"
 
@@ -25,6 +27,7 @@ namespace Surface {
  * If the particle exits one simulation volume which is ON the edge of the grid with no neighboring
  * gridpoint in the exit direction, the particle exits the portal.
  * The grid has indices from (0,0) -> (Nx-1,Ny-1)
+ * The current gridpoint is stored per thread, the portal itself is shared.
  */
 class PeriodicPortal : public VPortal {
   enum class SingleSurface {
@@ -39,7 +42,6 @@ class PeriodicPortal : public VPortal {
     Z_UP,
     Z_DOWN
   };
-  enum class PortationType { ENTER, EXIT, PERIODIC };
 
  public:
   PeriodicPortal(const G4String &name, G4VPhysicalVolume *volume,
@@ -58,8 +60,8 @@ class PeriodicPortal : public VPortal {
   // Getter
   inline G4int GetMaxNX() const { return fMaxNX; }
   inline G4int GetMaxNY() const { return fMaxNY; }
-  inline G4int GetCurrentNX() const { return fCurrentNX; }
-  inline G4int GetCurrentNY() const { return fCurrentNY; }
+  inline G4int GetCurrentNX() const { return fCurrent.Get().x; }
+  inline G4int GetCurrentNY() const { return fCurrent.Get().y; }
 
   // Check
   inline G4bool IsPortal() const { return fIsPortal; }
@@ -74,6 +76,11 @@ class PeriodicPortal : public VPortal {
  * @return
  */
   SingleSurface GetNearestSurface(const G4Step *step);
+  /**
+   * @brief Analytic variant of GetNearestSurface(..) for box shaped volumes
+   * @param point post step point in local coordinates
+   */
+  SingleSurface GetNearestSurfaceBox(const G4ThreeVector &point) const;
   /**
    * @brief Returns the needed portation type based on the closest surface
    * @return
@@ -87,11 +94,14 @@ class PeriodicPortal : public VPortal {
 
  private:
   PeriodicPortal *fOtherPortal{}; /// handle to the periodic subworld
+  G4ThreeVector fOtherExtent; /// cached extent of fOtherPortal, set by SetOtherPortal
+  G4ThreeVector fOtherHalfExtent; /// cached half-lengths of fOtherPortal
+  G4ThreeVector fInvOtherExtent; /// cached inverse extent of fOtherPortal
+  G4double fScaleZ{1.}; /// z-extent of fOtherPortal / z-extent of this volume
   G4bool fIsPortal;  /// True if it is the portal, false if it is the periodic subworld
   G4int fMaxNX; /// Grid size in  X direction
   G4int fMaxNY; /// Grid size in Y direction
-  G4int fCurrentNX; /// Current grid location of tracked particle in X dimension
-  G4int fCurrentNY; /// Current grid location of tracked particle in Y dimension
+  G4Cache<GridPosition> fCurrent; /// Current grid location of tracked particle, one per thread
 };
 }  // namespace Surface
 #endif  // SRC_PORTAL_INCLUDE_PERIODICPORTAL_HH_
@@ -20,13 +20,21 @@ namespace Surface {
 class PortalControl {
  public:
   explicit PortalControl(VerboseLevel verboseLvl = VerboseLevel::Default);
+  ~PortalControl();
   void DoStep(G4Step *step);
   void DoStep(const G4Step *step);
   void DoPortation(G4Step *step, const G4VPhysicalVolume *volume);
+  void DoPortation(G4Step *step, VPortal *portal);
   G4bool EnterPortalCheck(const G4Step *step);
   void SetVerbose(VerboseLevel verboseLvl);
   G4bool IsVolumeInsidePortal(const G4VPhysicalVolume *volume) const;
   void UsePortal(G4Step *step);
+  /**
+   * @brief Skips the navigator relocation for crossings between copies of the
+   * same subworld, enabled by default
+   */
+  static void SetFastRelocation(G4bool enable);
+  std::string RelocationStatisticString() const;
 
  private:
   PortalStore &fPortalStore;
@@ -0,0 +1,138 @@
+/**
+ * @brief Counters of the portal traffic
+ * @author agent
+ * @date 2026-10-17
+ * @file PortalStatistics.hh
+ */
+
+#ifndef SRC_PORTAL_INCLUDE_PORTALSTATISTICS_HH
+#define SRC_PORTAL_INCLUDE_PORTALSTATISTICS_HH
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "G4String.hh"
+#include "G4Threading.hh"
+#include "G4Types.hh"
+
+/**
+ * @brief Portal statistics compiled into the binary
+ * @details Set with -DSCORE4_PORTAL_STATISTICS=<ON|OFF>, off by default. If
+ * off, all counting is removed by the compiler. If on, every step reads the
+ * counters of the thread and compares the track ID, every full relocation
+ * reads the clock twice.
+ */
+#ifndef SCORE4_PORTAL_STATISTICS
+#define SCORE4_PORTAL_STATISTICS 0
+#endif
+
+namespace Surface {
+
+constexpr G4bool kPortalStatistics = SCORE4_PORTAL_STATISTICS != 0;
+
+/**
+ * @brief definition of portation type
+ * @details Enter: enters portal volume
+ * Exit: exits portal volume
+ * Periodic: enters another subworld (only possible if already in portal)
+ */
+enum class PortationType { ENTER, EXIT, PERIODIC };
+
+/**
+ * @brief PortalStatistics counts the traffic through the portals
+ * @details Every thread counts into its own counters: portations per portal
+ * and PortationType, visits per subworld, portations per track as histogram
+ * and the time spent in full navigator relocations. Portations of a track are
+ * kept under its track ID until the track ends, so tracks suspended and resumed
+ * later keep their count. Counters are summed over
+ * all threads when a summary is requested, which must only happen while no
+ * events are processed (e.g. between runs). Portals get their index at
+ * construction, portals are built by the master thread.
+ */
+class PortalStatistics {
+ public:
+  /// Bin i > 0 of the hop histogram counts tracks with [2^(i-1), 2^i) hops
+  static constexpr std::size_t kHopBins{32};
+
+  /**
+   * @brief Registers a portal
+   * @return index of the portal in the statistics
+   */
+  static G4int Register(const G4String &name);
+
+  /// Counters of the calling thread
+  static PortalStatistics &Local() {
+    if (fLocal == nullptr) {
+      fLocal = Create();
+    }
+    return *fLocal;
+  }
+
+  inline void CountPortation(const G4int portal, const PortationType type) {
+    ++Counts(portal)[static_cast<std::size_t>(type)];
+    ++fTrackHops;
+  }
+  inline void CountVisit(const G4int portal) { ++Counts(portal)[kVisit]; }
+  /**
+   * @brief Selects the track following portations are counted for
+   * @details Called every step, only a change of the track ID or the first
+   * step of a track does more than two comparisons. Track 1 at step 1 starts
+   * a new event, tracks of the last event still open are added to the
+   * histogram.
+   */
+  inline void SetTrack(const G4int trackId, const G4int stepNumber) {
+    if (trackId != fTrackId || stepNumber == 1) {
+      SwitchTrack(trackId, stepNumber);
+    }
+  }
+  /// Adds the portations of the current track, which ended, to the histogram
+  void EndTrack();
+  inline void CountRelocation(const std::chrono::steady_clock::duration time) {
+    ++fRelocations;
+    fRelocationTime += time;
+  }
+
+  /// Human readable summary of all threads
+  static std::string Summary();
+  /// Summary of all threads as JSON
+  static std::string Json();
+  /// @return false if the file could not be written
+  static G4bool WriteJson(const G4String &filename);
+  static void Reset();
+
+ private:
+  static constexpr std::size_t kVisit{3};
+  using PortalCounts = std::array<G4long, 4>;  ///< enter, exit, periodic, visit
+
+  PortalStatistics() = default;
+  static PortalStatistics *Create();
+  inline PortalCounts &Counts(const G4int portal) {
+    const auto idx = static_cast<std::size_t>(portal);
+    if (idx >= fPortals.size()) {
+      fPortals.resize(idx + 1, PortalCounts{});
+    }
+    return fPortals[idx];
+  }
+  void SwitchTrack(G4int trackId, G4int stepNumber);
+  void CloseOpenTracks();
+  void FillHops(G4long hops);
+  /// Sum of the counters of all threads
+  static PortalStatistics Total();
+
+ private:
+  std::vector<PortalCounts> fPortals;
+  std::array<G4long, kHopBins> fHops{};
+  G4long fTrackHops{0};  ///< portations of the current track
+  G4int fTrackId{-1};    ///< current track, -1 if none
+  std::unordered_map<G4int, G4long> fOpenTracks;  ///< suspended tracks
+  G4long fRelocations{0};
+  std::chrono::steady_clock::duration fRelocationTime{0};
+  static G4ThreadLocal PortalStatistics *fLocal;
+};
+}  // namespace Surface
+
+#endif  // SRC_PORTAL_INCLUDE_PORTALSTATISTICS_HH
@@ -0,0 +1,49 @@
+/**
+ * @brief Messenger for PortalStatistics
+ * @author agent
+ * @date 2026-10-17
+ * @file PortalStatisticsMessenger.hh
+ */
+
+#ifndef SRC_PORTAL_INCLUDE_PORTALSTATISTICSMESSENGER_HH
+#define SRC_PORTAL_INCLUDE_PORTALSTATISTICSMESSENGER_HH
+
+#include "G4ApplicationState.hh"
+#include "G4String.hh"
+#include "G4UImessenger.hh"
+#include "G4VStateDependent.hh"
+
+class G4UIcommand;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithoutParameter;
+
+namespace Surface {
+
+/**
+ * @brief Commands of the portal statistics in /Surface/Portal/
+ * @details Writes the JSON summary at the end of every run if a file is set.
+ * The end of a run is taken from the state change GeomClosed -> Idle of the
+ * master thread.
+ */
+class PortalStatisticsMessenger final : public G4UImessenger,
+                                        public G4VStateDependent {
+ public:
+  PortalStatisticsMessenger();
+  ~PortalStatisticsMessenger() override;
+
+  void SetNewValue(G4UIcommand *command, G4String newValues) override;
+  G4bool Notify(G4ApplicationState requestedState) override;
+
+ private:
+  G4UIdirectory *fDirectory;
+  G4UIdirectory *fSubDirectory;
+  G4UIcmdWithoutParameter *fCmdPrintStatistics;
+  G4UIcmdWithoutParameter *fCmdResetStatistics;
+  G4UIcmdWithAString *fCmdSetStatisticsFile;
+  G4String fFilename;
+  G4ApplicationState fState;  ///< last state seen by Notify()
+};
+}  // namespace Surface
+
+#endif  // SRC_PORTAL_INCLUDE_PORTALSTATISTICSMESSENGER_HH
@@ -7,6 +7,8 @@
 #ifndef SRC_PORTAL_INCLUDE_PORTALSTORE_HH
 #define SRC_PORTAL_INCLUDE_PORTALSTORE_HH
 
+#include <atomic>
+#include <unordered_map>
 #include <vector>
 
 #include "G4LogicalVolume.hh"
@@ -17,10 +19,33 @@ namespace Surface {
 /**
  * @brief Stores a handle to all used portals
  * @details Stores a handle to all used portals/triggers. Portals/Triggers can be found based
- * on it G4PhysicalVolume oder G4LogicalVolume or name
+ * on it G4PhysicalVolume oder G4LogicalVolume or name. Portals are only changed
+ * through the members below, every change invalidates the trigger index.
  */
-class PortalStore : public std::vector<VPortal *> {
+class PortalStore : private std::vector<VPortal *> {
+  using Base = std::vector<VPortal *>;
+
  public:
+  using Base::const_iterator;
+  using Base::empty;
+  using Base::size;
+  using Base::size_type;
+  using Base::value_type;
+
+  inline const_iterator begin() const { return Base::begin(); }
+  inline const_iterator end() const { return Base::end(); }
+  inline VPortal *operator[](const size_type idx) const {
+    return Base::operator[](idx);
+  }
+  inline VPortal *at(const size_type idx) const { return Base::at(idx); }
+
+  // Modifiers
+  void push_back(VPortal *portal);
+  const_iterator erase(const_iterator position);
+  /// replaces the portal at idx
+  void SetPortal(size_type idx, VPortal *portal);
+  void clear();
+
   /**
    * @brief Checks if volume is logical portal
    * @param volume to check
@@ -65,6 +90,35 @@ class PortalStore : public std::vector<VPortal *> {
    * @return pointer to portal, nullptr if does not exist
    */
   VPortal *GetPortal(const G4VPhysicalVolume *volume) const;
+
+  /**
+   * @brief returns pointer to portal based on its physical trigger volume
+   * @details Single lookup in a pointer keyed trigger index, no allocation
+   * @param volume physical trigger volume
+   * @return pointer to portal, nullptr if volume is no trigger
+   */
+  VPortal *GetPortalOfTrigger(const G4VPhysicalVolume *volume) const;
+
+  /**
+   * @brief Builds the pointer keyed trigger index of all stored portals
+   * @details Called by the master after the geometry is built, lookups are
+   * then read-only. If portals are changed afterwards, the index is rebuilt
+   * on the next lookup. The store must not be changed while events are
+   * processed.
+   */
+  void BuildTriggerIndex() const;
+
+ private:
+  inline void InvalidateTriggerIndex() {
+    fTriggerIndexValid.store(false, std::memory_order_release);
+  }
+  /// fills the index, the caller holds the index mutex
+  void FillTriggerIndex() const;
+
+ private:
+  mutable std::unordered_map<const G4VPhysicalVolume *, G4int> fTriggerIndex;
+  /// published after the index is filled, read by all threads
+  mutable std::atomic<G4bool> fTriggerIndexValid{false};
 };
 }  // namespace Surface
 
@@ -30,6 +30,7 @@ class SimplePortal : public VPortal {
 
  private:
   SimplePortal *fOtherPortal{nullptr};
+  G4ThreeVector fScale{1., 1., 1.};  // extent of fOtherPortal / extent of this volume
 };
 
 }  // namespace Surface
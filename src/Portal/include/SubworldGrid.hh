@@ -8,69 +8,167 @@
 #ifndef SRC_PORTAL_INCLUDE_SUBWORLDGRID_HH
 #define SRC_PORTAL_INCLUDE_SUBWORLDGRID_HH
 
+#include <cstdint>
+#include <iomanip>
 #include <map>
 #include <numeric>
 #include <set>
 #include <sstream>
 #include <vector>
 
+#include "G4Cache.hh"
 #include "Randomize.hh"
 #include "Service/include/Logger.hh"
 
 namespace Surface {
+/**
+ * @brief Position of a tracked particle in a subworld grid
+ */
+struct GridPosition {
+  G4int x{-1};
+  G4int y{-1};
+};
+
+/**
+ * @brief Storage of the grid layout
+ * @details Dense stores a pointer per cell. Indexed stores a palette of
+ * subworld types and one byte per cell. Hashed stores only the palette and
+ * derives the type of a cell on demand from a seeded hash of (x, y), memory
+ * and build time do not depend on the grid size.
+ */
+enum class GridStorage { Dense, Indexed, Hashed };
+
 /**
  * @brief Implementation of SubworldGrid template
  * @details Provides a grid structure with pointers to objects T.
- * Stores position in grid.
+ * The grid layout is shared between threads and not changed during tracking,
+ * the current position in the grid is stored per thread.
  * @tparam T template object
  */
 template <class T>
 class SubworldGrid {
  public:
-
-  SubworldGrid(const G4int sizeX, const G4int sizeY, const VerboseLevel verboseLvl = VerboseLevel::Default)
+  SubworldGrid(const G4int sizeX, const G4int sizeY,
+               const VerboseLevel verboseLvl = VerboseLevel::Default,
+               const GridStorage storage = GridStorage::Dense)
       : fColumnSize(sizeY),
         fMaxX(sizeX),
         fMaxY(sizeY),
-        fCurrentX(-1),
-        fCurrentY(-1),
+        fStorage(storage),
         fLogger("SubworldGrid", verboseLvl) {
     // col major order
-    fGrid = new T *[sizeX * sizeY];
+    if (fStorage == GridStorage::Dense) {
+      fGrid.resize(NumberOfCells(), nullptr);
+    } else if (fStorage == GridStorage::Indexed) {
+      fIndex.resize(NumberOfCells(), 0);
+    }
     fLogger.WriteDebugInfo("SubworldGrid of size " +
-                           std::to_string(sizeX * sizeY) + " initialized");
+                           std::to_string(NumberOfCells()) + " initialized");
   }
 
-  ~SubworldGrid() {
-    delete[] fGrid;
-  }  // only destructs the array of pointers but not the Portals, they are
-     // handled in the PortalStore
+  // only the grid is owned, the subworlds are handled in the PortalStore
+  ~SubworldGrid() = default;
 
   void SetSubworld(const G4int x, const G4int y, T *subworld) {
-    fLogger.WriteDebugInfo("Set Subworld " + subworld->GetName() + " at X: " +
-                           std::to_string(x) + " Y: " + std::to_string(y) +
-                           " at id: " + std::to_string(x * fColumnSize + y));
-    fGrid[x * fColumnSize + y] = subworld;
+    fLogger.WriteDebugInfo([&] {
+      return "Set Subworld " + subworld->GetName() + " at X: " +
+             std::to_string(x) + " Y: " + std::to_string(y) +
+             " at id: " + std::to_string(CellId(x, y));
+    });
+    switch (fStorage) {
+      case GridStorage::Dense:
+        fGrid[CellId(x, y)] = subworld;
+        break;
+      case GridStorage::Indexed:
+        fIndex[CellId(x, y)] = PaletteIndex(subworld);
+        break;
+      case GridStorage::Hashed:
+        fLogger.WriteError("Cells of a hashed grid can not be set");
+        exit(EXIT_FAILURE);
+    }
+  }
+
+  /**
+   * @brief Sets the subworld types used by an indexed or hashed grid
+   * @details At most 256 types are supported.
+   */
+  void SetPalette(const std::vector<T *> &palette) {
+    if (palette.empty() || palette.size() > 256) {
+      fLogger.WriteError("Palette needs between 1 and 256 subworld types");
+      exit(EXIT_FAILURE);
+    }
+    fPalette = palette;
+  }
+
+  /**
+   * @brief Sets the palette index of a cell of an indexed grid
+   */
+  inline void SetSubworldIndex(const G4int x, const G4int y,
+                               const std::uint8_t id) {
+    fIndex[CellId(x, y)] = id;
+  }
+
+  /**
+   * @brief Defines the layout of a hashed grid
+   * @param palette subworld types
+   * @param density share of each type, does not need to be normalized
+   * @param seed seed of the hash
+   */
+  void SetHashedLayout(const std::vector<T *> &palette,
+                       const std::vector<G4double> &density,
+                       const std::uint64_t seed) {
+    if (fStorage != GridStorage::Hashed) {
+      fLogger.WriteError("Grid does not use hashed storage");
+      exit(EXIT_FAILURE);
+    }
+    SetPalette(palette);
+    const G4double sum =
+        std::accumulate(std::begin(density), std::end(density), 0.);
+    fShare.clear();
+    fCumulative.clear();
+    G4double cumulative{0};
+    for (const G4double val : density) {
+      cumulative += val / sum;
+      fShare.push_back(val / sum);
+      fCumulative.push_back(cumulative);
+    }
+    fCumulative.back() = 1.;
+    fSeed = seed;
   }
 
   T *GetSubworld(const G4int x, const G4int y) const {
-    return fGrid[x * fColumnSize + y];
+    switch (fStorage) {
+      case GridStorage::Dense:
+        return fGrid[CellId(x, y)];
+      case GridStorage::Indexed:
+        return fPalette[fIndex[CellId(x, y)]];
+      case GridStorage::Hashed:
+        return fPalette[HashedIndex(x, y)];
+    }
+    return nullptr;
   }
 
-  T *GetSubworld() const { return GetSubworld(fCurrentX, fCurrentY); }
+  T *GetSubworld() const {
+    const GridPosition &current = fCurrent.Get();
+    return GetSubworld(current.x, current.y);
+  }
 
   inline G4int MaxX() const { return fMaxX; }
   inline G4int MaxY() const { return fMaxY; }
-  inline G4int CurrentPosX() const { return fCurrentX; }
-  inline G4int CurrentPosY() const { return fCurrentY; }
+  inline std::size_t NumberOfCells() const {
+    return static_cast<std::size_t>(fMaxX) * static_cast<std::size_t>(fMaxY);
+  }
+  inline GridStorage GetStorage() const { return fStorage; }
+  inline G4int CurrentPosX() const { return fCurrent.Get().x; }
+  inline G4int CurrentPosY() const { return fCurrent.Get().y; }
 
-  inline void SetCurrentX(const G4int x) { fCurrentX = x; }
-  inline void SetCurrentY(const G4int y) { fCurrentY = y; }
+  inline void SetCurrentX(const G4int x) { fCurrent.Get().x = x; }
+  inline void SetCurrentY(const G4int y) { fCurrent.Get().y = y; }
 
-  inline void IncrX() { ++fCurrentX; }
-  inline void DecrX() { --fCurrentX; }
-  inline void IncrY() { ++fCurrentY; }
-  inline void DecrY() { --fCurrentY; }
+  inline void IncrX() { ++fCurrent.Get().x; }
+  inline void DecrX() { --fCurrent.Get().x; }
+  inline void IncrY() { ++fCurrent.Get().y; }
+  inline void DecrY() { --fCurrent.Get().y; }
 
   std::stringstream StreamGrid(const G4int minX, const G4int maxX,
                                const G4int minY, const G4int maxY) const {
@@ -78,7 +176,7 @@ class SubworldGrid {
     auto symbols = GetLegend();
     for (G4int x = minX; x < maxX; ++x) {
       for (G4int y = minY; y < maxY; ++y) {
-        T *subworld = fGrid[x * fColumnSize + y];
+        T *subworld = GetSubworld(x, y);
         ss << symbols[subworld] << " ";
       }
       ss << "\n";
@@ -91,13 +189,47 @@ class SubworldGrid {
     G4cout << StreamGrid(minX, maxX, minY, maxY).str() << G4endl;
   }
 
+  /**
+   * @brief Counts the cells of each subworld, expected count for hashed grids
+   */
+  std::map<T *, G4double> CountSubworlds() const {
+    std::map<T *, G4double> counter;
+    switch (fStorage) {
+      case GridStorage::Dense:
+        for (T *subworld : fGrid) {
+          if (subworld != nullptr) {
+            counter[subworld] += 1.;
+          }
+        }
+        break;
+      case GridStorage::Indexed: {
+        std::vector<std::size_t> count(fPalette.size(), 0);
+        for (const std::uint8_t id : fIndex) {
+          ++count[id];
+        }
+        for (std::size_t i = 0; i < fPalette.size(); ++i) {
+          if (count[i] > 0) {
+            counter[fPalette[i]] += static_cast<G4double>(count[i]);
+          }
+        }
+        break;
+      }
+      case GridStorage::Hashed:
+        for (std::size_t i = 0; i < fPalette.size(); ++i) {
+          counter[fPalette[i]] +=
+              fShare[i] * static_cast<G4double>(NumberOfCells());
+        }
+        break;
+    }
+    return counter;
+  }
+
   std::set<T *> GetUniqueSubworlds() const {
     std::set<T *> uniqueSubworlds;
-    const size_t N = fMaxX * fMaxY;
-    for (size_t i = 0; i < N; ++i) {
-      fLogger.WriteDebugInfo("Added " + fGrid[i]->GetName() + " to with id: " +
-                             std::to_string(i) + " to unique set");
-      uniqueSubworlds.insert(fGrid[i]);
+    for (const auto &ele : CountSubworlds()) {
+      if (ele.second > 0.) {
+        uniqueSubworlds.insert(ele.first);
+      }
     }
     return uniqueSubworlds;
   }
@@ -116,23 +248,27 @@ class SubworldGrid {
     G4cout << StreamUniqueSubworlds().str() << G4endl;
   }
 
+  /**
+   * @brief Streams the share of each subworld in the grid
+   * @details For hashed grids the expected share is given.
+   */
   std::stringstream StreamStatistic() const {
-    std::map<T *, G4int> counter;
-    const size_t N = fMaxX * fMaxY;
-    for (size_t i = 0; i < N; ++i) {
-      counter[fGrid[i]] += 1;
-    }
-    const G4int sum = std::accumulate(
+    const std::map<T *, G4double> counter = CountSubworlds();
+    const G4double sum = std::accumulate(
         std::begin(counter), std::end(counter), 0.,
         [](const G4double value,
-           const typename std::map<T *, G4int>::value_type &ele) {
+           const typename std::map<T *, G4double>::value_type &ele) {
           return value + ele.second;
         });
 
-    const G4double invertedSum = 100. / static_cast<G4double>(sum);
+    const G4double invertedSum = 100. / sum;
 
     std::stringstream ss;
-    ss << "Used subworlds in % / total\n";
+    ss << "Used subworlds in % / total";
+    if (fStorage == GridStorage::Hashed) {
+      ss << " (expected)";
+    }
+    ss << "\n";
     ss << "\n";
 
     for (auto ele : counter) {
@@ -160,6 +296,42 @@ class SubworldGrid {
   void PrintLegend() { G4cout << StreamLegend().str() << G4endl; }
 
  private:
+  inline std::size_t CellId(const G4int x, const G4int y) const {
+    return static_cast<std::size_t>(x) * fColumnSize + y;
+  }
+
+  std::uint8_t PaletteIndex(T *subworld) {
+    for (std::size_t i = 0; i < fPalette.size(); ++i) {
+      if (fPalette[i] == subworld) {
+        return static_cast<std::uint8_t>(i);
+      }
+    }
+    if (fPalette.size() == 256) {
+      fLogger.WriteError("Indexed grid supports at most 256 subworld types");
+      exit(EXIT_FAILURE);
+    }
+    fPalette.push_back(subworld);
+    return static_cast<std::uint8_t>(fPalette.size() - 1);
+  }
+
+  /**
+   * @brief Palette index of cell (x,y), counter based hash (splitmix64)
+   */
+  std::size_t HashedIndex(const G4int x, const G4int y) const {
+    std::uint64_t z = fSeed + ((static_cast<std::uint64_t>(x) << 32) |
+                               static_cast<std::uint32_t>(y)) *
+                                  0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z = z ^ (z >> 31);
+    const G4double random = static_cast<G4double>(z >> 11) / 9007199254740992.;  // 2^53
+    std::size_t id = 0;
+    while (id < fCumulative.size() - 1 && random >= fCumulative[id]) {
+      ++id;
+    }
+    return id;
+  }
+
   std::map<T *, char> GetLegend() const {
     std::set<T *> uniqueSubworlds = GetUniqueSubworlds();
 
@@ -167,7 +339,7 @@ class SubworldGrid {
     G4int counter = 0;
     std::map<T *, char> legend;
     for (T *subworld : uniqueSubworlds) {
-      legend[subworld] = symbols[counter];
+      legend[subworld] = symbols[counter % 10];
       ++counter;
     }
     return legend;
@@ -177,11 +349,16 @@ class SubworldGrid {
   const G4int fColumnSize;
   const G4int fMaxX;
   const G4int fMaxY;
-  G4int fCurrentX;
-  G4int fCurrentY;
+  const GridStorage fStorage;
+  G4Cache<GridPosition> fCurrent;  // current position, one per thread
   Logger fLogger;
 
-  T **fGrid;
+  std::vector<T *> fGrid;             // Dense: subworld of each cell
+  std::vector<T *> fPalette;          // Indexed, Hashed: subworld types
+  std::vector<std::uint8_t> fIndex;   // Indexed: palette index of each cell
+  std::vector<G4double> fShare;       // Hashed: share of each type
+  std::vector<G4double> fCumulative;  // Hashed: cumulative share
+  std::uint64_t fSeed{0};             // Hashed: seed of the hash
 };
 
 /////////////////////////////////////////////////////////////
@@ -214,16 +391,23 @@ class HelperFillSubworldGrid {
     fLogger.WriteDetailInfo("Link Grid to Subworlds");
   }
 
+  /**
+   * @brief Fills the grid randomly based on the densities of the subworlds
+   * @details Hashed grids only get the palette and a seed, the layout of the
+   * cells is derived on demand.
+   */
   void FillGrid(SubworldGrid<T> *grid) {
     G4double sumOfProb{0};
-    std::vector<G4double> probability;
-    for (G4double &val : fDensity) {
+    for (const G4double val : fDensity) {
       sumOfProb += val;
-      probability.push_back(sumOfProb);
     }
-    for (G4double &val : fDensity) {
-      val = val / sumOfProb;
+    std::vector<G4double> probability;
+    G4double cumulative{0};
+    for (const G4double val : fDensity) {
+      cumulative += val / sumOfProb;
+      probability.push_back(cumulative);
     }
+    probability.back() = 1.;
     SetGridInSubworlds(grid);
     const G4int gridMaxX = grid->MaxX();
     const G4int gridMaxY = grid->MaxY();
@@ -231,14 +415,30 @@ class HelperFillSubworldGrid {
                             << "Start filling Grid of size:\n"
                             << "Nx : " << gridMaxX << "\n"
                             << "Ny : " << gridMaxY << "\n");
+    if (grid->GetStorage() == GridStorage::Hashed) {
+      // seed from the engine, layout is reproducible with the engine seed
+      const auto high =
+          static_cast<std::uint64_t>(G4UniformRand() * 4294967296.);
+      const auto low =
+          static_cast<std::uint64_t>(G4UniformRand() * 4294967296.);
+      grid->SetHashedLayout(fAvailableSubworlds, fDensity, (high << 32) | low);
+      return;
+    }
+    const G4bool isIndexed = grid->GetStorage() == GridStorage::Indexed;
+    if (isIndexed) {
+      grid->SetPalette(fAvailableSubworlds);
+    }
     for (G4int x = 0; x < gridMaxX; ++x) {
       for (G4int y = 0; y < gridMaxY; ++y) {
         const G4double random = G4UniformRand();
-        for (size_t i = 0; i < probability.size(); ++i) {
-          if (random <= probability.at(i)) {
-            grid->SetSubworld(x, y, fAvailableSubworlds[i]);
-            break;
-          }
+        std::size_t id = 0;
+        while (id < probability.size() - 1 && random > probability[id]) {
+          ++id;
+        }
+        if (isIndexed) {
+          grid->SetSubworldIndex(x, y, static_cast<std::uint8_t>(id));
+        } else {
+          grid->SetSubworld(x, y, fAvailableSubworlds[id]);
         }
       }
     }
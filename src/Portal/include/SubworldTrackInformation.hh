@@ -0,0 +1,80 @@
+/**
+ * @brief Stores the subworld grid position of a track
+ * @author agent
+ * @date 2026-10-17
+ * @file SubworldTrackInformation.hh
+ */
+
+#ifndef SRC_PORTAL_INCLUDE_SUBWORLDTRACKINFORMATION_HH
+#define SRC_PORTAL_INCLUDE_SUBWORLDTRACKINFORMATION_HH
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4VUserPrimaryParticleInformation.hh"
+#include "G4VUserTrackInformation.hh"
+#include "Portal/include/SubworldGrid.hh"
+
+namespace Surface {
+/**
+ * @brief Subworld grid position of a primary particle
+ * @details Set by the sampler for primaries which start inside a subworld.
+ * Handed over to the SubworldTrackInformation of the primary track.
+ */
+class SubworldPrimaryInformation : public G4VUserPrimaryParticleInformation {
+ public:
+  explicit SubworldPrimaryInformation(const GridPosition &position)
+      : fPosition(position) {}
+
+  inline const GridPosition &GetPosition() const { return fPosition; }
+  void Print() const override;
+
+ private:
+  GridPosition fPosition;
+};
+
+/**
+ * @brief Subworld grid position of a track
+ * @details Each track carries its own position in the subworld grid, so
+ * portation does not depend on the order in which tracks are processed.
+ * Secondaries inherit the position of their parent at creation.
+ */
+class SubworldTrackInformation : public G4VUserTrackInformation {
+ public:
+  explicit SubworldTrackInformation(const GridPosition &position)
+      : G4VUserTrackInformation("SubworldTrackInformation"),
+        fPosition(position) {}
+
+  inline const GridPosition &GetPosition() const { return fPosition; }
+  inline void SetPosition(const GridPosition &position) {
+    fPosition = position;
+  }
+  void Print() const override;
+
+  /**
+   * @brief Returns the grid information of a track
+   * @details If the track has no information yet, it is created from the
+   * information of its primary particle.
+   * @param track
+   * @return grid information, nullptr if the grid position is unknown
+   */
+  static SubworldTrackInformation *Find(const G4Track *track);
+  /**
+   * @brief Attaches the grid position to a track or updates it
+   * @param track
+   * @param position position in subworld grid
+   * @return false if track carries user information of another type
+   */
+  static G4bool Store(const G4Track *track, const GridPosition &position);
+  /**
+   * @brief Hands over the grid position of the track to the secondaries of the
+   * current step
+   * @param step
+   */
+  static void PassToSecondaries(const G4Step *step);
+
+ private:
+  GridPosition fPosition;
+};
+}  // namespace Surface
+
+#endif  // SRC_PORTAL_INCLUDE_SUBWORLDTRACKINFORMATION_HH
@@ -13,6 +13,7 @@
 #include "G4Step.hh"
 #include "G4ThreeVector.hh"
 #include "G4VPhysicalVolume.hh"
+#include "Portal/include/PortalStatistics.hh"
 #include "Service/include/Logger.hh"
 
 namespace Surface {
@@ -42,6 +43,17 @@ class VPortal {
   inline const G4String &GetName() const { return fName; }
   inline PortalType GetPortalType() const { return fPortalType; }
   inline G4VPhysicalVolume *GetTrigger() const { return fTrigger; }
+  inline const G4ThreeVector &GetExtent() const { return fExtent; } ///full size of the portal volume
+  inline const G4ThreeVector &GetHalfExtent() const { return fHalfExtent; } ///half-lengths of the portal volume
+  inline G4bool IsBox() const { return fIsBox; } ///true if the portal solid is a G4Box
+  inline G4int GetStatisticsId() const { return fStatisticsId; } ///index in PortalStatistics
+
+  // Relocation
+  static void SetFastRelocation(G4bool enable); ///skip the relocation within the same trigger
+  static inline G4bool IsFastRelocation() { return fFastRelocation; }
+  static inline G4long GetNumberOfFullRelocations() { return fFullRelocations; } ///of this thread
+  static inline G4long GetNumberOfFastRelocations() { return fFastRelocations; } ///of this thread
+  static inline G4long GetNumberOfSameTriggerFullRelocations() { return fSameTriggerFullRelocations; } ///of this thread
 
   // Setter
   void SetGlobalCoord(G4ThreeVector vec);
@@ -49,13 +61,56 @@ class VPortal {
   void SetTrigger(G4VPhysicalVolume *volume); ///set the trigger of a portal (when trigger is entered, the portal is used)
 
  protected:
+  /**
+   * @brief Faces of a box the point lies on, per axis -1 (lower), 0 (none), +1 (upper)
+   */
+  struct BoxFace {
+    G4int x;
+    G4int y;
+    G4int z;
+  };
+
   G4ThreeVector GetLocalCoordSystem() const;
+  BoxFace GetBoxFace(const G4ThreeVector &localPoint) const;
+
+  /// Counts a portation of this portal in PortalStatistics
+  inline void CountPortation(const PortationType type) const {
+    if (kPortalStatistics) {
+      PortalStatistics::Local().CountPortation(fStatisticsId, type);
+    }
+  }
+  /// Counts a visit of the subworld a particle was moved into
+  static inline void CountVisit(const VPortal *subworld) {
+    if (kPortalStatistics && subworld != nullptr) {
+      PortalStatistics::Local().CountVisit(subworld->fStatisticsId);
+    }
+  }
 
   void TransformToLocalCoordinate(G4ThreeVector &vec);
   void TransformToGlobalCoordinate(G4ThreeVector &vec);
+  static G4ThreeVector ComputeExtent(const G4VPhysicalVolume *volume);
+  static G4bool IsBoxSolid(const G4VPhysicalVolume *volume);
   static void UpdatePosition(G4Step *step, const G4ThreeVector &newPosition);
   static void UpdatePositionMomentum(G4Step *step, const G4ThreeVector &newPosition,
                               const G4ThreeVector &newDirection);
+  /**
+   * @brief Moves the particle to a new position inside the trigger volume of the
+   * post step point
+   * @details No relocation is done: the touchable history of the trigger is
+   * kept, only the local point of the navigator is moved and the safety is
+   * left to the next step. The new position must not lie in a daughter of the
+   * trigger, it may lie on the surface of one. Falls back to UpdatePosition(..) if fast relocation is disabled or the
+   * G4PathFinder is used (parallel worlds or coupled transportation), since
+   * it has to be relocated as well.
+   */
+  static void UpdatePositionWithinTrigger(G4Step *step,
+                                          const G4ThreeVector &newPosition);
+
+ private:
+  static void UpdateTrack(G4Step *step, const G4ThreeVector &newPosition,
+                          const G4ThreeVector &newDirection);
+  /// true if the track is transported with the G4PathFinder
+  static G4bool IsPathFinderActive(const G4Track *track);
 
 
 
@@ -66,6 +121,15 @@ class VPortal {
   G4ThreeVector fGlobalCoord;
   G4bool fGlobalCoordSet;
   G4VPhysicalVolume *fTrigger{nullptr};
+  const G4ThreeVector fExtent;  /// cached bounding box size of fVolume
+  const G4ThreeVector fHalfExtent;
+  const G4bool fIsBox;  /// true if solid of fVolume is a G4Box
+  const G4double fHalfTolerance;  /// half of the surface tolerance
+  const G4int fStatisticsId;  /// index in PortalStatistics
+  static G4bool fFastRelocation;
+  static G4ThreadLocal G4long fFullRelocations;  /// navigator relocations from the world volume
+  static G4ThreadLocal G4long fFastRelocations;  /// crossings within the trigger done without relocation
+  static G4ThreadLocal G4long fSameTriggerFullRelocations;  /// full relocations of crossings within the same trigger
 
  protected:
   Logger fLogger;
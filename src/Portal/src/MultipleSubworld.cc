@@ -16,6 +16,7 @@
 #include "G4VSolid.hh"
 #include "Portal/include/MultipleSubworld.hh"
 #include "Portal/include/SubworldGrid.hh"
+#include "Portal/include/SubworldTrackInformation.hh"
 #include "Portal/include/VPortal.hh"
 
 Surface::MultipleSubworld::MultipleSubworld(const G4String &name,
@@ -45,28 +46,50 @@ Surface::MultipleSubworld::~MultipleSubworld() {
 
 /**
  * @brief Does the portation of the particle of the post step point
+ * @details The grid position is taken from the track, the grid cursor is only
+ * used during the portation. Tracks without grid information use the cursor.
  * @param step
  */
 void Surface::MultipleSubworld::DoPortation(G4Step *step) {
+  const G4Track *track = step->GetTrack();
+  if (!fIsPortal) {
+    const SubworldTrackInformation *info =
+        SubworldTrackInformation::Find(track);
+    if (info != nullptr) {
+      fSubworldGrid->SetCurrentX(info->GetPosition().x);
+      fSubworldGrid->SetCurrentY(info->GetPosition().y);
+    }
+  }
   const Direction direction{GetNearestSurface(step)}; //select direction the particle is exiting the volume
   const PortationType portationType{GetPortationType(direction)}; //select portation type
   switch (portationType) {
     case PortationType::ENTER: {
-      fLogger.WriteDebugInfo("Doing portation of type: Enter");
+      SCORE4_LOG_DEBUG(fLogger, "Doing portation of type: Enter");
       EnterPortal(step);
       break;
     }
     case PortationType::EXIT: {
-      fLogger.WriteDebugInfo("Doing portation of type: Exit");
+      SCORE4_LOG_DEBUG(fLogger, "Doing portation of type: Exit");
       ExitPortal(step);
       break;
     }
     case PortationType::PERIODIC: {
-      fLogger.WriteDebugInfo("Doing portation of type: Periodic");
+      SCORE4_LOG_DEBUG(fLogger, "Doing portation of type: Periodic");
       DoPeriodicPortation(step, direction);
       break;
     }
   }
+  CountPortation(portationType);
+  if (portationType != PortationType::EXIT) {
+    CountVisit(fSubworldGrid->GetSubworld());
+    const GridPosition position{fSubworldGrid->CurrentPosX(),
+                                fSubworldGrid->CurrentPosY()};
+    if (!SubworldTrackInformation::Store(track, position)) {
+      SCORE4_LOG_DETAIL(
+          fLogger,
+          "Track carries foreign user information, grid position not stored");
+    }
+  }
 }
 
 /**
@@ -75,18 +98,16 @@ void Surface::MultipleSubworld::DoPortation(G4Step *step) {
  */
 void Surface::MultipleSubworld::EnterPortal(G4Step *step) {
   G4ThreeVector position = step->GetPostStepPoint()->GetPosition();
-  fLogger.WriteDebugInfo("Current position", position);
+  SCORE4_LOG_DEBUG(fLogger, "Current position", position);
   TransformToLocalCoordinate(position);
-  fLogger.WriteDebugInfo("Local Coordinate", position);
+  SCORE4_LOG_DEBUG(fLogger, "Local Coordinate", position);
   TransformPortalToSubworld(position);
-  fLogger.WriteDebugInfo("Subworld Coordinate", position);
+  SCORE4_LOG_DEBUG(fLogger, "Subworld Coordinate", position);
   fSubworldGrid->GetSubworld()->TransformToGlobalCoordinate(position);
 
-  if(fLogger.IsDebugInfoLvl()) {
-    MultipleSubworld *sub = fSubworldGrid->GetSubworld();
-    fLogger.WriteDebugInfo("Subworld name: " + sub->GetName());
-    fLogger.WriteDebugInfo("Global Coordinate", position);
-  }
+  SCORE4_LOG_DEBUG(fLogger,
+                   "Subworld name: " + fSubworldGrid->GetSubworld()->GetName());
+  SCORE4_LOG_DEBUG(fLogger, "Global Coordinate", position);
   UpdatePosition(step, position);
 }
 
@@ -104,6 +125,8 @@ void Surface::MultipleSubworld::ExitPortal(G4Step *step) {
 
 /**
  * @brief Portation method for doing a step on the subworld grid
+ * @details Moving to a cell of the same subworld type only needs a relative
+ * relocation of the navigator.
  * @param step
  * @param exitDirection exit direction of subworld
  */
@@ -111,11 +134,16 @@ void Surface::MultipleSubworld::DoPeriodicPortation(
     G4Step *step, const Direction exitDirection) {
   G4ThreeVector position = step->GetPostStepPoint()->GetPosition();
   DoPeriodicTransform(position, exitDirection);
-  UpdatePosition(step, position);
-  fLogger.WriteDebugInfo([this] {return CurrentStatusString();});
+  if (fSubworldGrid->GetSubworld() == this) {
+    // neighbouring cell is a copy of this subworld, still in the same trigger
+    UpdatePositionWithinTrigger(step, position);
+  } else {
+    UpdatePosition(step, position);
+  }
+  SCORE4_LOG_DEBUG(fLogger, CurrentStatusString());
 }
 
-Surface::MultipleSubworld::PortationType
+Surface::PortationType
 Surface::MultipleSubworld::GetPortationType(const Direction surface) {
   if (fIsPortal) return PortationType::ENTER;
   const G4int currentNX = fSubworldGrid->CurrentPosX();
@@ -150,21 +178,28 @@ Surface::MultipleSubworld::GetPortationType(const Direction surface) {
 // Function to decide in which direction the particle left the volume
 /**
  * @brief Function to decide in which direction the particle left the volume
+ * @details For box shaped volumes the exit face is classified analytically from
+ * the cached half-lengths, otherwise the surface normal of the solid is used.
  * @param step
  * @return Direction
  */
 Surface::MultipleSubworld::Direction
 Surface::MultipleSubworld::GetNearestSurface(const G4Step *step) {
-  G4VSolid *portalSolid = GetVolume()->GetLogicalVolume()->GetSolid();
   G4ThreeVector point = step->GetPostStepPoint()->GetPosition();
   TransformToLocalCoordinate(point);
-  const G4ThreeVector result = portalSolid->SurfaceNormal(point);
   const G4ThreeVector direction =
       step->GetPostStepPoint()->GetMomentumDirection();
 
-  fLogger.WriteDebugInfo("Point for finding surface normal", point);
-  fLogger.WriteDebugInfo("Surface normal                  ", result);
-  fLogger.WriteDebugInfo("Momentum direction              ", direction);
+  if (IsBox()) {
+    return GetNearestSurfaceBox(point, direction);
+  }
+
+  G4VSolid *portalSolid = GetVolume()->GetLogicalVolume()->GetSolid();
+  const G4ThreeVector result = portalSolid->SurfaceNormal(point);
+
+  SCORE4_LOG_DEBUG(fLogger, "Point for finding surface normal", point);
+  SCORE4_LOG_DEBUG(fLogger, "Surface normal                  ", result);
+  SCORE4_LOG_DEBUG(fLogger, "Momentum direction              ", direction);
 
   auto IsZero = [](const G4double a) {
     const G4double numeric_limit =
@@ -211,6 +246,40 @@ Surface::MultipleSubworld::GetNearestSurface(const G4Step *step) {
     Z = Direction::Z_SAME;
   }
 
+  return CombineDirections(X, Y, Z);
+}
+
+/**
+ * @brief Exit direction for box shaped volumes without calling the solid
+ * @param point post step point in local coordinates
+ * @param direction momentum direction
+ * @return Direction
+ */
+Surface::MultipleSubworld::Direction
+Surface::MultipleSubworld::GetNearestSurfaceBox(
+    const G4ThreeVector &point, const G4ThreeVector &direction) const {
+  const BoxFace face = GetBoxFace(point);
+
+  // an axis is exited if the point is on its face and moves outwards
+  const Direction X = (face.x > 0 && direction.x() > 0.)   ? Direction::X_UP
+                      : (face.x < 0 && direction.x() < 0.) ? Direction::X_DOWN
+                                                           : Direction::X_SAME;
+  const Direction Y = (face.y > 0 && direction.y() > 0.)   ? Direction::Y_UP
+                      : (face.y < 0 && direction.y() < 0.) ? Direction::Y_DOWN
+                                                           : Direction::Y_SAME;
+  const Direction Z = (face.z > 0 && direction.z() > 0.)   ? Direction::Z_UP
+                      : (face.z < 0 && direction.z() < 0.) ? Direction::Z_DOWN
+                                                           : Direction::Z_SAME;
+  return CombineDirections(X, Y, Z);
+}
+
+/**
+ * @brief Combines the exit direction of each axis, z-faces take precedence
+ */
+Surface::MultipleSubworld::Direction
+Surface::MultipleSubworld::CombineDirections(const Direction X,
+                                             const Direction Y,
+                                             const Direction Z) {
   if (Z == Direction::Z_UP) {
     return Direction::Z_UP;
   } else if (Z == Direction::Z_DOWN) {
@@ -238,10 +307,7 @@ Surface::MultipleSubworld::GetNearestSurface(const G4Step *step) {
 
 void Surface::MultipleSubworld::DoPeriodicTransform(
     G4ThreeVector &vec, const Direction surface) {
-  G4VPhysicalVolume *volume = GetVolume();
-  G4ThreeVector pMin, pMax;
-  volume->GetLogicalVolume()->GetSolid()->BoundingLimits(pMin, pMax);
-  const G4ThreeVector volumeSize = pMax - pMin;
+  const G4ThreeVector &volumeSize = GetExtent();
   TransformToLocalCoordinate(vec);  // transform to local coord
   const G4ThreeVector oldPosition = vec;
   // I assume that all subworlds have the same dimension
@@ -291,72 +357,56 @@ void Surface::MultipleSubworld::DoPeriodicTransform(
   }
   fSubworldGrid->GetSubworld()->TransformToGlobalCoordinate(
       vec);  // transform to coord of new subworld
-  const std::string subworldName = fSubworldGrid->GetSubworld()->GetName();
-  fLogger.WriteDebugInfo([this] {return CurrentStatusString();});
+  SCORE4_LOG_DEBUG(fLogger, CurrentStatusString());
 }
 
 void Surface::MultipleSubworld::TransformSubworldToPortal(G4ThreeVector &vec) {
-  G4ThreeVector pMinVol, pMinOtherVol, pMax;
-  GetVolume()->GetLogicalVolume()->GetSolid()->BoundingLimits(pMinVol, pMax);
-  const G4ThreeVector volumeDistance = pMax - pMinVol;
-  fPortal->GetVolume()->GetLogicalVolume()->GetSolid()->BoundingLimits(
-      pMinOtherVol, pMax);
-  const G4ThreeVector otherVolumeDistance = pMax - pMinOtherVol;
-  const G4ThreeVector shiftedVec = vec + volumeDistance / 2.;
+  const G4ThreeVector &volumeDistance = GetExtent();
+  const G4ThreeVector shiftedVec = vec + GetHalfExtent();
   vec.setX(shiftedVec.x() + fSubworldGrid->CurrentPosX() * volumeDistance.x() -
-           otherVolumeDistance.x() / 2.);
+           fOtherHalfExtent.x());
   vec.setY(shiftedVec.y() + fSubworldGrid->CurrentPosY() * volumeDistance.y() -
-           otherVolumeDistance.y() / 2.);
+           fOtherHalfExtent.y());
 
   vec.setZ(TransformZBetweenPortals(vec.z()));
 }
 
 void Surface::MultipleSubworld::TransformPortalToSubworld(G4ThreeVector &vec) {
-  G4ThreeVector pMinVol, pMinOtherVol, pMax;
-  GetVolume()->GetLogicalVolume()->GetSolid()->BoundingLimits(pMinVol, pMax);
-  const G4ThreeVector volumeDistance = pMax - pMinVol;
-  fPortal->GetVolume()->GetLogicalVolume()->GetSolid()->BoundingLimits(
-      pMinOtherVol, pMax);
-  const G4ThreeVector otherVolumeDistance = pMax - pMinOtherVol;
-  const G4ThreeVector shiftedVec = vec + volumeDistance / 2.;
-  const G4double divNX = shiftedVec.x() / otherVolumeDistance.x();
-  const G4double divNY = shiftedVec.y() / otherVolumeDistance.y();
+  const G4ThreeVector shiftedVec = vec + GetHalfExtent();
+  const G4double divNX = shiftedVec.x() * fInvOtherExtent.x();
+  const G4double divNY = shiftedVec.y() * fInvOtherExtent.y();
   G4int NX = std::floor(divNX);
   G4int NY = std::floor(divNY);
 
-  fLogger.WriteDebugInfo("Calculate grid position x: " + std::to_string(divNX) +
-                         " y: " + std::to_string(divNY) + " rounded x: " +
-                         std::to_string(NX) + " y: " + std::to_string(NY));
+  SCORE4_LOG_DEBUG(fLogger, "Calculate grid position x: " +
+                                std::to_string(divNX) +
+                                " y: " + std::to_string(divNY) +
+                                " rounded x: " + std::to_string(NX) +
+                                " y: " + std::to_string(NY));
   if (NX == fSubworldGrid->MaxX()) --NX;
   if (NY == fSubworldGrid->MaxY()) --NY;
-  vec.setX(shiftedVec.x() - NX * otherVolumeDistance.x() -
-           otherVolumeDistance.x() / 2.);
-  vec.setY(shiftedVec.y() - NY * otherVolumeDistance.y() -
-           otherVolumeDistance.y() / 2.);
+  vec.setX(shiftedVec.x() - NX * fOtherExtent.x() - fOtherHalfExtent.x());
+  vec.setY(shiftedVec.y() - NY * fOtherExtent.y() - fOtherHalfExtent.y());
   fSubworldGrid->SetCurrentX(NX);
   fSubworldGrid->SetCurrentY(NY);
   vec.setZ(TransformZBetweenPortals(vec.z()));
-  fLogger.WriteDebugInfo([this] {return CurrentStatusString();});
+  SCORE4_LOG_DEBUG(fLogger, CurrentStatusString());
 }
 
 G4double Surface::MultipleSubworld::TransformZBetweenPortals(
     const G4double val) {
-  G4ThreeVector pMin, pMax;
-  GetVolume()->GetLogicalVolume()->GetSolid()->BoundingLimits(pMin, pMax);
-  G4double volumeDistanceZ = pMax.z() - pMin.z();
-  fPortal->GetVolume()->GetLogicalVolume()->GetSolid()->BoundingLimits(pMin,
-                                                                       pMax);
-  G4double otherVolumeDistanceZ = pMax.z() - pMin.z();
-  return val / volumeDistanceZ * otherVolumeDistanceZ;
+  return val * fScaleZ;
 }
 
 void Surface::MultipleSubworld::SetGrid(const G4int sizeX, const G4int sizeY,
-                                        const VerboseLevel verbose) {
+                                        const VerboseLevel verbose,
+                                        const GridStorage storage) {
   if (fSubworldGrid != nullptr) {
     fLogger.WriteError("Subworld grid already set!");
     exit(EXIT_FAILURE);
   }
-  fSubworldGrid = new SubworldGrid<MultipleSubworld>(sizeX, sizeY, verbose);
+  fSubworldGrid =
+      new SubworldGrid<MultipleSubworld>(sizeX, sizeY, verbose, storage);
 }
 
 void Surface::MultipleSubworld::SetGrid(
@@ -371,6 +421,12 @@ void Surface::MultipleSubworld::SetGrid(
 void Surface::MultipleSubworld::SetOtherPortal(
     Surface::MultipleSubworld *otherPortal) {
   fPortal = otherPortal;
+  // cache extents of the linked volume for the transformations
+  fOtherExtent = fPortal->GetExtent();
+  fOtherHalfExtent = fPortal->GetHalfExtent();
+  fInvOtherExtent.set(1. / fOtherExtent.x(), 1. / fOtherExtent.y(),
+                      1. / fOtherExtent.z());
+  fScaleZ = fOtherExtent.z() / GetExtent().z();
 }
 
 void Surface::MultipleSubworld::AddSubworldToGrid(
@@ -20,7 +20,7 @@ Surface::PeriodicPortal::PeriodicPortal(const G4String &name,
                                         const G4ThreeVector &vec,
                                         const VerboseLevel verbose)
     : VPortal("PeriodicPortal_" + name, volume, PortalType::PeriodicPortal, verbose),
-      fIsPortal(false), fMaxNX(-1), fMaxNY(-1), fCurrentNX(-1), fCurrentNY(-1) {
+      fIsPortal(false), fMaxNX(-1), fMaxNY(-1) {
   SetGlobalCoord(vec);
 }
 
@@ -28,20 +28,23 @@ void Surface::PeriodicPortal::DoPortation(G4Step *step) {
   // select portation method by checking Grid and side of exit portal
   const SingleSurface surface = GetNearestSurface(step);
   const PortationType portationType = GetPortationType(surface);
+  CountPortation(portationType);
   switch (portationType) {
     case PortationType::ENTER: {
-      fLogger.WriteDebugInfo("Doing portation of type: Enter");
+      SCORE4_LOG_DEBUG(fLogger, "Doing portation of type: Enter");
       EnterPortal(step);
+      CountVisit(fOtherPortal);
       return;
     }
     case PortationType::EXIT: {
-      fLogger.WriteDebugInfo("Doing portation of type: Exit");
+      SCORE4_LOG_DEBUG(fLogger, "Doing portation of type: Exit");
       ExitPortal(step);
       return;
     }
     case PortationType::PERIODIC: {
-      fLogger.WriteDebugInfo("Doing portation of type: Periodic");
+      SCORE4_LOG_DEBUG(fLogger, "Doing portation of type: Periodic");
       DoPeriodicPortation(step, surface);
+      CountVisit(this);
       return;
     }
   }
@@ -67,36 +70,39 @@ void Surface::PeriodicPortal::DoPeriodicPortation(G4Step *step,
                                                   SingleSurface exitSurface) {
   G4ThreeVector position = step->GetPostStepPoint()->GetPosition();
   DoPeriodicTransform(position, exitSurface);
-  UpdatePosition(step, position);
-  fLogger.WriteDebugInfo("Subworld: X:" + std::to_string(GetCurrentNX()) +
-                         " Y: " + std::to_string(GetCurrentNY()));
+  // the particle stays in the same subworld
+  UpdatePositionWithinTrigger(step, position);
+  SCORE4_LOG_DEBUG(fLogger, "Subworld: X:" + std::to_string(GetCurrentNX()) +
+                                " Y: " + std::to_string(GetCurrentNY()));
 }
 
-Surface::PeriodicPortal::PortationType
+Surface::PortationType
 Surface::PeriodicPortal::GetPortationType(const SingleSurface surface) const {
   if (fIsPortal) return PortationType::ENTER;
+  const G4int currentNX = GetCurrentNX();
+  const G4int currentNY = GetCurrentNY();
   // Periodic exit at a surface
-  if (surface == SingleSurface::X_UP && fCurrentNX < fMaxNX - 1)
+  if (surface == SingleSurface::X_UP && currentNX < fMaxNX - 1)
     return PortationType::PERIODIC;
-  if (surface == SingleSurface::X_DOWN && fCurrentNX > 0)
+  if (surface == SingleSurface::X_DOWN && currentNX > 0)
     return PortationType::PERIODIC;
-  if (surface == SingleSurface::Y_UP && fCurrentNY < fMaxNY - 1)
+  if (surface == SingleSurface::Y_UP && currentNY < fMaxNY - 1)
     return PortationType::PERIODIC;
-  if (surface == SingleSurface::Y_DOWN && fCurrentNY > 0)
+  if (surface == SingleSurface::Y_DOWN && currentNY > 0)
     return PortationType::PERIODIC;
 
   // Periodic exit at an edge
-  if (surface == SingleSurface::X_UP_Y_UP && fCurrentNY < fMaxNX - 1 &&
-      fCurrentNY < fMaxNY - 1)
+  if (surface == SingleSurface::X_UP_Y_UP && currentNY < fMaxNX - 1 &&
+      currentNY < fMaxNY - 1)
     return PortationType::PERIODIC;
-  if (surface == SingleSurface::X_UP_Y_DOWN && fCurrentNX < fMaxNX - 1 &&
-      fCurrentNY > 0)
+  if (surface == SingleSurface::X_UP_Y_DOWN && currentNX < fMaxNX - 1 &&
+      currentNY > 0)
     return PortationType::PERIODIC;
-  if (surface == SingleSurface::X_DOWN_Y_UP && fCurrentNX > 0 &&
-      fCurrentNY < fMaxNY - 1)
+  if (surface == SingleSurface::X_DOWN_Y_UP && currentNX > 0 &&
+      currentNY < fMaxNY - 1)
     return PortationType::PERIODIC;
-  if (surface == SingleSurface::X_DOWN_Y_DOWN && fCurrentNX > 0 &&
-      fCurrentNY > 0)
+  if (surface == SingleSurface::X_DOWN_Y_DOWN && currentNX > 0 &&
+      currentNY > 0)
     return PortationType::PERIODIC;
   // exit at a Z Surface, also including corners.
   return PortationType::EXIT;
@@ -105,17 +111,21 @@ Surface::PeriodicPortal::GetPortationType(const SingleSurface surface) const {
 // Function to decide in which direction the particle left the volume
 Surface::PeriodicPortal::SingleSurface
 Surface::PeriodicPortal::GetNearestSurface(const G4Step *step) {
-  const G4VSolid *portalSolid = GetVolume()->GetLogicalVolume()->GetSolid();
   G4ThreeVector point = step->GetPostStepPoint()->GetPosition();
   TransformToLocalCoordinate(point);
+  if (IsBox()) {
+    return GetNearestSurfaceBox(point);
+  }
+  const G4VSolid *portalSolid = GetVolume()->GetLogicalVolume()->GetSolid();
   const G4ThreeVector result = portalSolid->SurfaceNormal(point);
 
-  fLogger.WriteDebugInfo("Point: x: " + std::to_string(point.x()) +
-                         " y: " + std::to_string(point.y()) +
-                         " z: " + std::to_string(point.z()));
-  fLogger.WriteDebugInfo("SurfaceNormal: x: " + std::to_string(result.x()) +
-                         " y: " + std::to_string(result.y()) +
-                         " z: " + std::to_string(result.z()));
+  SCORE4_LOG_DEBUG(fLogger, "Point: x: " + std::to_string(point.x()) +
+                                " y: " + std::to_string(point.y()) +
+                                " z: " + std::to_string(point.z()));
+  SCORE4_LOG_DEBUG(fLogger,
+                   "SurfaceNormal: x: " + std::to_string(result.x()) +
+                       " y: " + std::to_string(result.y()) +
+                       " z: " + std::to_string(result.z()));
 
   auto IsZero = [](const G4double a) {
     const G4double numeric_limit =
@@ -155,111 +165,116 @@ Surface::PeriodicPortal::GetNearestSurface(const G4Step *step) {
   }
 }
 
+/**
+ * @brief Closest surface for box shaped volumes without calling the solid
+ * @details Same precedence as GetNearestSurface(..): pure X/Y faces and XY edges
+ * first, every case touching a z-face is resolved by the z-face. Never fails.
+ * @param point post step point in local coordinates
+ */
+Surface::PeriodicPortal::SingleSurface
+Surface::PeriodicPortal::GetNearestSurfaceBox(
+    const G4ThreeVector &point) const {
+  const BoxFace face = GetBoxFace(point);
+  if (face.z != 0) {
+    return face.z > 0 ? SingleSurface::Z_UP : SingleSurface::Z_DOWN;
+  }
+  if (face.x == 0) {
+    return face.y > 0 ? SingleSurface::Y_UP : SingleSurface::Y_DOWN;
+  }
+  if (face.y == 0) {
+    return face.x > 0 ? SingleSurface::X_UP : SingleSurface::X_DOWN;
+  }
+  if (face.x > 0) {
+    return face.y > 0 ? SingleSurface::X_UP_Y_UP : SingleSurface::X_UP_Y_DOWN;
+  }
+  return face.y > 0 ? SingleSurface::X_DOWN_Y_UP : SingleSurface::X_DOWN_Y_DOWN;
+}
+
 void Surface::PeriodicPortal::DoPeriodicTransform(G4ThreeVector &vec,
                                                   const SingleSurface surface) {
-  G4VPhysicalVolume *volume = GetVolume();
-  G4ThreeVector pMin, pMax;
-  volume->GetLogicalVolume()->GetSolid()->BoundingLimits(pMin, pMax);
-  G4ThreeVector volumeSize = pMax - pMin;
-  G4ThreeVector oldPosition = vec;
+  const G4ThreeVector &volumeSize = GetExtent();
+  const G4ThreeVector oldPosition = vec;
+  GridPosition &current = fCurrent.Get();
   switch (surface) {
     case SingleSurface::X_UP:
       vec.setX(oldPosition.x() - volumeSize.x());
-      ++fCurrentNX;
+      ++current.x;
       break;
     case SingleSurface::X_DOWN:
       vec.setX(oldPosition.x() + volumeSize.x());
-      --fCurrentNX;
+      --current.x;
       break;
     case SingleSurface::Y_UP:
       vec.setY(oldPosition.y() - volumeSize.y());
-      ++fCurrentNY;
+      ++current.y;
       break;
     case SingleSurface::Y_DOWN:
       vec.setY(oldPosition.y() + volumeSize.y());
-      --fCurrentNY;
+      --current.y;
       break;
     case SingleSurface::X_UP_Y_UP:
       vec.setX(oldPosition.x() - volumeSize.x());
-      ++fCurrentNX;
+      ++current.x;
       vec.setY(oldPosition.y() - volumeSize.y());
-      ++fCurrentNY;
+      ++current.y;
       break;
     case SingleSurface::X_UP_Y_DOWN:
       vec.setX(oldPosition.x() - volumeSize.x());
-      ++fCurrentNX;
+      ++current.x;
       vec.setY(oldPosition.y() + volumeSize.y());
-      --fCurrentNY;
+      --current.y;
       break;
     case SingleSurface::X_DOWN_Y_UP:
       vec.setX(oldPosition.x() + volumeSize.x());
-      --fCurrentNX;
+      --current.x;
       vec.setY(oldPosition.y() - volumeSize.y());
-      ++fCurrentNY;
+      ++current.y;
       break;
     case SingleSurface::X_DOWN_Y_DOWN:
       vec.setX(oldPosition.x() + volumeSize.x());
-      --fCurrentNX;
+      --current.x;
       vec.setY(oldPosition.y() + volumeSize.y());
-      --fCurrentNY;
+      --current.y;
       break;
     default:
       exit(EXIT_FAILURE);  // should never happen
   }
-  fLogger.WriteDebugInfo(
-      "Periodic transformation: NX: " + std::to_string(fCurrentNX) +
-      " NY: " + std::to_string(fCurrentNY));
+  SCORE4_LOG_DEBUG(fLogger,
+                   "Periodic transformation: NX: " + std::to_string(current.x) +
+                       " NY: " + std::to_string(current.y));
 }
 
 void Surface::PeriodicPortal::TransformSubworldToPortal(G4ThreeVector &vec) {
-  G4ThreeVector pMinVol, pMinOtherVol, pMax;
-  GetVolume()->GetLogicalVolume()->GetSolid()->BoundingLimits(pMinVol, pMax);
-  const G4ThreeVector volumeDistance = pMax - pMinVol;
-  fOtherPortal->GetVolume()->GetLogicalVolume()->GetSolid()->BoundingLimits(
-      pMinOtherVol, pMax);
-  const G4ThreeVector otherVolumeDistance = pMax - pMinOtherVol;
-  const G4ThreeVector shiftedVec = vec + volumeDistance / 2.;
-  vec.setX(shiftedVec.x() + fCurrentNX * volumeDistance.x() -
-           otherVolumeDistance.x() / 2.);
-  vec.setY(shiftedVec.y() + fCurrentNY * volumeDistance.y() -
-           otherVolumeDistance.y() / 2.);
+  const G4ThreeVector &volumeDistance = GetExtent();
+  const G4ThreeVector shiftedVec = vec + GetHalfExtent();
+  const GridPosition &current = fCurrent.Get();
+  vec.setX(shiftedVec.x() + current.x * volumeDistance.x() -
+           fOtherHalfExtent.x());
+  vec.setY(shiftedVec.y() + current.y * volumeDistance.y() -
+           fOtherHalfExtent.y());
 
   vec.setZ(TransformZBetweenPortals(vec.z()));
 }
 
 void Surface::PeriodicPortal::TransformPortalToSubworld(G4ThreeVector &vec) {
-  G4ThreeVector pMinVol, pMinOtherVol, pMax;
-  GetVolume()->GetLogicalVolume()->GetSolid()->BoundingLimits(pMinVol, pMax);
-  const G4ThreeVector volumeDistance = pMax - pMinVol;
-  fOtherPortal->GetVolume()->GetLogicalVolume()->GetSolid()->BoundingLimits(
-      pMinOtherVol, pMax);
-  const G4ThreeVector otherVolumeDistance = pMax - pMinOtherVol;
-  const G4ThreeVector shiftedVec = vec + volumeDistance / 2.;
-  auto NX = static_cast<G4int>(shiftedVec.x() / otherVolumeDistance.x());
-  auto NY = static_cast<G4int>(shiftedVec.y() / otherVolumeDistance.y());
+  const G4ThreeVector shiftedVec = vec + GetHalfExtent();
+  auto NX = static_cast<G4int>(shiftedVec.x() * fInvOtherExtent.x());
+  auto NY = static_cast<G4int>(shiftedVec.y() * fInvOtherExtent.y());
   if (NX == fOtherPortal->fMaxNX) --NX;
   if (NY == fOtherPortal->fMaxNY) --NY;
 
-  vec.setX(shiftedVec.x() - NX * otherVolumeDistance.x() -
-           otherVolumeDistance.x() / 2.);
-  vec.setY(shiftedVec.y() - NY * otherVolumeDistance.y() -
-           otherVolumeDistance.y() / 2.);
-  fOtherPortal->fCurrentNX = NX;
-  fOtherPortal->fCurrentNY = NY;
+  vec.setX(shiftedVec.x() - NX * fOtherExtent.x() - fOtherHalfExtent.x());
+  vec.setY(shiftedVec.y() - NY * fOtherExtent.y() - fOtherHalfExtent.y());
+  GridPosition &otherCurrent = fOtherPortal->fCurrent.Get();
+  otherCurrent.x = NX;
+  otherCurrent.y = NY;
   vec.setZ(TransformZBetweenPortals(vec.z()));
-  fLogger.WriteDebugInfo("Subworld: X " + std::to_string(NX) + " Y " +
-                         std::to_string(NY));
+  SCORE4_LOG_DEBUG(fLogger, "Subworld: X " + std::to_string(NX) + " Y " +
+                                std::to_string(NY));
 }
 
 G4double Surface::PeriodicPortal::TransformZBetweenPortals(G4double val) {
-  G4ThreeVector pMin, pMax;
-  GetVolume()->GetLogicalVolume()->GetSolid()->BoundingLimits(pMin, pMax);
-  G4double volumeDistanceZ = pMax.z() - pMin.z();
-  fOtherPortal->GetVolume()->GetLogicalVolume()->GetSolid()->BoundingLimits(
-      pMin, pMax);
-  G4double otherVolumeDistanceZ = pMax.z() - pMin.z();
-  val = val / volumeDistanceZ * otherVolumeDistanceZ;
-  return val;
+  return val * fScaleZ;
 }
 
 void Surface::PeriodicPortal::SetGrid(int nX, int nY) {
@@ -270,4 +285,10 @@ void Surface::PeriodicPortal::SetGrid(int nX, int nY) {
 void Surface::PeriodicPortal::SetOtherPortal(
     Surface::PeriodicPortal *otherPortal) {
   fOtherPortal = otherPortal;
+  // cache extents of the linked volume for the transformations
+  fOtherExtent = fOtherPortal->GetExtent();
+  fOtherHalfExtent = fOtherPortal->GetHalfExtent();
+  fInvOtherExtent.set(1. / fOtherExtent.x(), 1. / fOtherExtent.y(),
+                      1. / fOtherExtent.z());
+  fScaleZ = fOtherExtent.z() / GetExtent().z();
 }
@@ -12,21 +12,28 @@
 #include "G4LogicalVolume.hh"
 #include "G4Step.hh"
 #include "G4StepPoint.hh"
+#include "G4Track.hh"
 #include "G4VPhysicalVolume.hh"
 #include "Portal/include/MultipleSubworld.hh"
 #include "Portal/include/PeriodicPortal.hh"
+#include "Portal/include/PortalStatistics.hh"
 #include "Portal/include/SimplePortal.hh"
+#include "Portal/include/SubworldTrackInformation.hh"
 #include "Portal/include/VPortal.hh"
 #include "Service/include/Locator.hh"
 #include "Service/include/Logger.hh"
+#include "Service/include/Profiler.hh"
 
 Surface::PortalControl::PortalControl(const VerboseLevel verboseLvl)
     : fPortalStore(Surface::Locator::GetPortalStore()),
       fLogger("PortalControl", verboseLvl) {
+  // portals are shared between threads, their verbose level is set on the
+  // master by the helper that builds them (e.g. MultiportalHelper)
   fLogger.WriteInfo("PortalControl initialized");
-  for (auto &portal : fPortalStore) {
-    portal->SetVerbose(verboseLvl);
-  }
+}
+
+Surface::PortalControl::~PortalControl() {
+  fLogger.WriteInfo([this] { return RelocationStatisticString(); });
 }
 
 // Useful function because using SteppingAction.hh step is const
@@ -35,49 +42,75 @@ void Surface::PortalControl::DoStep(const G4Step *step) {
 }
 
 void Surface::PortalControl::DoStep(G4Step *step) {
+  SCORE4_PROFILE_SCOPE("PortalControl::DoStep");
   const G4StepPoint *postStepPoint = step->GetPostStepPoint();
   const G4StepPoint *preStepPoint = step->GetPreStepPoint();
 
   const G4VPhysicalVolume *prePhysVol = preStepPoint->GetPhysicalVolume();
   const G4VPhysicalVolume *postPhysVol = postStepPoint->GetPhysicalVolume();
 
-  G4bool checkPortation = false;
+  // secondaries of this step start in the subworld of their parent
+  SubworldTrackInformation::PassToSecondaries(step);
 
-  if (postPhysVol != nullptr) {
-    const G4String preVolName = prePhysVol->GetName();
-    const G4String postVolName = postPhysVol->GetName();
-    if (preVolName != postVolName) {
-      checkPortation = true;
-    }
-    // if preVolName is not postVolName -> there was a volume change-> check if
-    // a portal is involved
+  const G4Track *track = step->GetTrack();
+  if (kPortalStatistics) {
+    // before the portation, so it is counted for this track
+    PortalStatistics::Local().SetTrack(track->GetTrackID(),
+                                       track->GetCurrentStepNumber());
   }
-  // if (checkPortation && !fJustPorted) {
-  if (checkPortation) {
-    fLogger.WriteDebugInfo(
-        "Boundary reached!\n"
-        "Volume of preStepPoint is: " +
-            step->GetPreStepPoint()->GetPhysicalVolume()->GetName() + " at ",
-        preStepPoint->GetPosition());
-
-    if (EnterPortalCheck(step)) {
-      UsePortal(step);
+
+  // if prePhysVol is not postPhysVol -> there was a volume change -> check if
+  // a portal is involved. Only the post volume can be a trigger.
+  if (postPhysVol != nullptr && prePhysVol != postPhysVol) {
+    VPortal *portal = fPortalStore.GetPortalOfTrigger(postPhysVol);
+    if (portal != nullptr) {
+      SCORE4_LOG_DEBUG(fLogger,
+                       "Boundary reached!\n"
+                       "Volume of preStepPoint is: " +
+                           prePhysVol->GetName() + " at ",
+                       preStepPoint->GetPosition());
+      DoPortation(step, portal);
     }
   }
 
-  std::stringstream stream;
-  const G4StepPoint *postStep = step->GetPostStepPoint();
-  if (postStep->GetPhysicalVolume() != nullptr) {
-    stream << " Volume is: " << postStep->GetPhysicalVolume()->GetName()
-           << " at ";
+  SCORE4_LOG_DEBUG(fLogger,
+                   postPhysVol != nullptr
+                       ? " Volume is: " + postPhysVol->GetName() + " at "
+                       : std::string(),
+                   postStepPoint->GetPosition());
+
+  if (kPortalStatistics) {
+    const G4TrackStatus status = track->GetTrackStatus();
+    if (status == fStopAndKill || status == fKillTrackAndSecondaries) {
+      PortalStatistics::Local().EndTrack();
+    }
   }
-  fLogger.WriteDebugInfo(stream.str(), postStep->GetPosition());
 }
 
 void Surface::PortalControl::SetVerbose(const VerboseLevel verboseLvl) {
   fLogger.SetVerboseLvl(verboseLvl);
 }
 
+void Surface::PortalControl::SetFastRelocation(const G4bool enable) {
+  VPortal::SetFastRelocation(enable);
+}
+
+std::string Surface::PortalControl::RelocationStatisticString() const {
+  const G4long full = VPortal::GetNumberOfFullRelocations();
+  const G4long fast = VPortal::GetNumberOfFastRelocations();
+  // only crossings within the same trigger can skip the relocation
+  const G4long sameTrigger =
+      fast + VPortal::GetNumberOfSameTriggerFullRelocations();
+  std::stringstream ss;
+  ss << "Navigator relocations: full " << full << ", skipped " << fast;
+  if (sameTrigger > 0) {
+    ss << " (" << 100. * fast / static_cast<G4double>(sameTrigger)
+       << " % of " << sameTrigger
+       << " crossings within the same trigger done without relocation)";
+  }
+  return ss.str();
+}
+
 void Surface::PortalControl::DoPortation(G4Step *step,
                                          const G4VPhysicalVolume *volume) {
   auto *portal = fPortalStore.GetPortal(volume);
@@ -85,12 +118,18 @@ void Surface::PortalControl::DoPortation(G4Step *step,
     fLogger.WriteError("No portal found!");
     std::exit(EXIT_FAILURE);
   }
+  DoPortation(step, portal);
+}
+
+void Surface::PortalControl::DoPortation(G4Step *step, VPortal *portal) {
+  SCORE4_PROFILE_SCOPE("PortalControl::DoPortation");
   const auto type = portal->GetPortalType();
   switch (type) {
     case PortalType::SimplePortal: {
       auto *simplePortal = dynamic_cast<SimplePortal *>(portal);
       if(simplePortal) {
-        fLogger.WriteDebugInfo("Using SimplePortal " + simplePortal->GetName());
+        SCORE4_LOG_DEBUG(fLogger,
+                         "Using SimplePortal " + simplePortal->GetName());
         simplePortal->DoPortation(step);
         break;
       }else{
@@ -101,8 +140,8 @@ void Surface::PortalControl::DoPortation(G4Step *step,
     case PortalType::PeriodicPortal: {
       auto *periodicPortal = dynamic_cast<PeriodicPortal *>(portal);
       if(periodicPortal) {
-        fLogger.WriteDebugInfo("Using PeriodicPortal " +
-                               periodicPortal->GetName());
+        SCORE4_LOG_DEBUG(fLogger,
+                         "Using PeriodicPortal " + periodicPortal->GetName());
         periodicPortal->DoPortation(step);
         break;
       }else{
@@ -114,8 +153,8 @@ void Surface::PortalControl::DoPortation(G4Step *step,
       auto *multipleSubworld =
           dynamic_cast<MultipleSubworld *>(portal);
       if(multipleSubworld) {
-        fLogger.WriteDebugInfo("Using MultipleSubworld " +
-                               multipleSubworld->GetName());
+        SCORE4_LOG_DEBUG(fLogger, "Using MultipleSubworld " +
+                                      multipleSubworld->GetName());
         multipleSubworld->DoPortation(step);
         break;
       } else {
@@ -139,9 +178,12 @@ G4bool Surface::PortalControl::EnterPortalCheck(const G4Step *step) {
 void Surface::PortalControl::UsePortal(G4Step *step) {
   const G4VPhysicalVolume *trigger =
       step->GetPostStepPoint()->GetPhysicalVolume();
-  const G4int triggerId = fPortalStore.FindTrigger(trigger);
-  const G4VPhysicalVolume *volume = fPortalStore.at(triggerId)->GetVolume();
-  DoPortation(step, volume);
+  VPortal *portal = fPortalStore.GetPortalOfTrigger(trigger);
+  if (portal == nullptr) {
+    fLogger.WriteError("No portal found for trigger!");
+    std::exit(EXIT_FAILURE);
+  }
+  DoPortation(step, portal);
 }
 
 G4bool Surface::PortalControl::IsVolumeInsidePortal(
@@ -0,0 +1,229 @@
+/**
+ * @brief Implementation of class PortalStatistics
+ * @author agent
+ * @date 2026-10-17
+ * @file PortalStatistics.cc
+ */
+
+#include "Portal/include/PortalStatistics.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#include "Portal/include/PortalStatisticsMessenger.hh"
+
+G4ThreadLocal Surface::PortalStatistics *Surface::PortalStatistics::fLocal =
+    nullptr;
+
+namespace {
+std::mutex &RegistryMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+/// counters of all threads, kept after a thread ends
+std::vector<std::unique_ptr<Surface::PortalStatistics>> &Threads() {
+  static std::vector<std::unique_ptr<Surface::PortalStatistics>> threads;
+  return threads;
+}
+
+std::vector<G4String> &PortalNames() {
+  static std::vector<G4String> names;
+  return names;
+}
+
+G4long LowerHops(const std::size_t bin) {
+  return bin == 0 ? 0 : G4long{1} << (bin - 1);
+}
+
+std::string JsonString(const G4String &text) {
+  std::string escaped;
+  for (const char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return "\"" + escaped + "\"";
+}
+}  // namespace
+
+G4int Surface::PortalStatistics::Register(const G4String &name) {
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  // created with the first portal, built by the master thread. Not deleted,
+  // the UI manager may be gone at the end of the program.
+  static PortalStatisticsMessenger *messenger = new PortalStatisticsMessenger;
+  (void)messenger;
+  PortalNames().push_back(name);
+  return static_cast<G4int>(PortalNames().size() - 1);
+}
+
+Surface::PortalStatistics *Surface::PortalStatistics::Create() {
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  Threads().emplace_back(new PortalStatistics);
+  return Threads().back().get();
+}
+
+void Surface::PortalStatistics::EndTrack() {
+  FillHops(fTrackHops);
+  fTrackHops = 0;
+  fTrackId = -1;
+}
+
+void Surface::PortalStatistics::SwitchTrack(const G4int trackId,
+                                           const G4int stepNumber) {
+  if (trackId == 1 && stepNumber == 1) {
+    CloseOpenTracks();
+  }
+  if (fTrackId >= 0) {
+    fOpenTracks[fTrackId] = fTrackHops;
+  }
+  fTrackId = trackId;
+  fTrackHops = 0;
+  const auto open = fOpenTracks.find(trackId);
+  if (open != fOpenTracks.end()) {
+    fTrackHops = open->second;
+    fOpenTracks.erase(open);
+  }
+}
+
+void Surface::PortalStatistics::CloseOpenTracks() {
+  if (fTrackId >= 0) {
+    EndTrack();
+  }
+  for (const auto &track : fOpenTracks) {
+    FillHops(track.second);
+  }
+  fOpenTracks.clear();
+}
+
+void Surface::PortalStatistics::FillHops(G4long hops) {
+  std::size_t bin{0};
+  for (; hops > 0 && bin < kHopBins - 1; hops >>= 1) {
+    ++bin;
+  }
+  ++fHops[bin];
+}
+
+Surface::PortalStatistics Surface::PortalStatistics::Total() {
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  PortalStatistics total;
+  total.fPortals.resize(PortalNames().size(), PortalCounts{});
+  for (const auto &thread : Threads()) {
+    for (std::size_t portal = 0; portal < thread->fPortals.size(); ++portal) {
+      for (std::size_t i = 0; i < total.fPortals[portal].size(); ++i) {
+        total.Counts(static_cast<G4int>(portal))[i] +=
+            thread->fPortals[portal][i];
+      }
+    }
+    for (std::size_t bin = 0; bin < kHopBins; ++bin) {
+      total.fHops[bin] += thread->fHops[bin];
+    }
+    total.fRelocations += thread->fRelocations;
+    total.fRelocationTime += thread->fRelocationTime;
+  }
+  return total;
+}
+
+void Surface::PortalStatistics::Reset() {
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  for (const auto &thread : Threads()) {
+    thread->fPortals.clear();
+    thread->fHops.fill(0);
+    thread->fTrackHops = 0;
+    thread->fTrackId = -1;
+    thread->fOpenTracks.clear();
+    thread->fRelocations = 0;
+    thread->fRelocationTime = std::chrono::steady_clock::duration{0};
+  }
+}
+
+std::string Surface::PortalStatistics::Summary() {
+  const PortalStatistics total = Total();
+  std::stringstream ss;
+  ss << "\n";
+  ss << "**************************************************\n";
+  ss << "*           Information PortalStatistics         *\n";
+  ss << "**************************************************\n";
+  ss << std::setw(36) << std::left << "Portal" << std::right << std::setw(12)
+     << "enter" << std::setw(12) << "exit" << std::setw(12) << "periodic"
+     << std::setw(12) << "visits" << "\n";
+  for (std::size_t portal = 0; portal < total.fPortals.size(); ++portal) {
+    const PortalCounts &counts = total.fPortals[portal];
+    ss << std::setw(36) << std::left << PortalNames().at(portal) << std::right;
+    for (const G4long count : counts) {
+      ss << std::setw(12) << count;
+    }
+    ss << "\n";
+  }
+  G4long tracks{0};
+  for (const G4long count : total.fHops) {
+    tracks += count;
+  }
+  ss << "\nPortations per track, " << tracks << " tracks:\n";
+  for (std::size_t bin = 0; bin < kHopBins; ++bin) {
+    if (total.fHops[bin] == 0) {
+      continue;
+    }
+    ss << std::setw(12) << LowerHops(bin) << " - ";
+    if (bin == 0) {
+      ss << std::setw(12) << 0;
+    } else if (bin == kHopBins - 1) {
+      ss << std::setw(12) << "";
+    } else {
+      ss << std::setw(12) << LowerHops(bin + 1) - 1;
+    }
+    ss << std::setw(14) << total.fHops[bin] << "\n";
+  }
+  const G4double seconds =
+      std::chrono::duration<G4double>(total.fRelocationTime).count();
+  ss << "\nFull relocations (UpdatePositionMomentum): " << total.fRelocations
+     << ", " << seconds << " s";
+  if (total.fRelocations > 0) {
+    ss << ", " << 1e9 * seconds / static_cast<G4double>(total.fRelocations)
+       << " ns per relocation";
+  }
+  ss << "\n";
+  ss << "**************************************************\n";
+  return ss.str();
+}
+
+std::string Surface::PortalStatistics::Json() {
+  const PortalStatistics total = Total();
+  std::stringstream ss;
+  ss << std::setprecision(12);
+  ss << "{\n  \"portals\": [";
+  for (std::size_t portal = 0; portal < total.fPortals.size(); ++portal) {
+    const PortalCounts &counts = total.fPortals[portal];
+    ss << (portal == 0 ? "\n" : ",\n") << "    {\"name\": "
+       << JsonString(PortalNames().at(portal)) << ", \"enter\": " << counts[0]
+       << ", \"exit\": " << counts[1] << ", \"periodic\": " << counts[2]
+       << ", \"visits\": " << counts[kVisit] << "}";
+  }
+  ss << "\n  ],\n  \"hopsPerTrack\": [";
+  for (std::size_t bin = 0; bin < kHopBins; ++bin) {
+    ss << (bin == 0 ? "\n" : ",\n") << "    {\"min\": " << LowerHops(bin)
+       << ", \"max\": ";
+    if (bin == kHopBins - 1) {
+      ss << "null";
+    } else {
+      ss << (bin == 0 ? 0 : LowerHops(bin + 1) - 1);
+    }
+    ss << ", \"tracks\": " << total.fHops[bin] << "}";
+  }
+  ss << "\n  ],\n  \"relocations\": " << total.fRelocations
+     << ",\n  \"relocationSeconds\": "
+     << std::chrono::duration<G4double>(total.fRelocationTime).count()
+     << "\n}\n";
+  return ss.str();
+}
+
+G4bool Surface::PortalStatistics::WriteJson(const G4String &filename) {
+  std::ofstream file(filename, std::ios::trunc);
+  file << Json();
+  return static_cast<G4bool>(file);
+}
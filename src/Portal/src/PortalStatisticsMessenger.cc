@@ -0,0 +1,96 @@
+/**
+ * @brief Implementation of PortalStatisticsMessenger class
+ * @author agent
+ * @date 2026-10-17
+ * @file PortalStatisticsMessenger.cc
+ */
+
+#include "Portal/include/PortalStatisticsMessenger.hh"
+
+#include "G4ApplicationState.hh"
+#include "G4StateManager.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "Portal/include/PortalStatistics.hh"
+#include "Service/include/Logger.hh"
+
+Surface::PortalStatisticsMessenger::PortalStatisticsMessenger() {
+  fDirectory = new G4UIdirectory("/Surface/");
+  fDirectory->SetGuidance("Controls the Surface library.");
+  fSubDirectory = new G4UIdirectory("/Surface/Portal/");
+  fSubDirectory->SetGuidance("Statistics of the portal traffic.");
+
+  fCmdPrintStatistics =
+      new G4UIcmdWithoutParameter("/Surface/Portal/printStatistics", this);
+  fCmdPrintStatistics->AvailableForStates(G4State_PreInit, G4State_Init,
+                                          G4State_Idle);
+  fCmdPrintStatistics->SetGuidance(
+      "Print portations per portal and type, visits per subworld, "
+      "portations per track and the time of full relocations");
+  fCmdPrintStatistics->SetToBeBroadcasted(false);
+
+  fCmdResetStatistics =
+      new G4UIcmdWithoutParameter("/Surface/Portal/resetStatistics", this);
+  fCmdResetStatistics->AvailableForStates(G4State_PreInit, G4State_Init,
+                                          G4State_Idle);
+  fCmdResetStatistics->SetGuidance("Set all portal counters to zero");
+  fCmdResetStatistics->SetToBeBroadcasted(false);
+
+  fCmdSetStatisticsFile =
+      new G4UIcmdWithAString("/Surface/Portal/setStatisticsFile", this);
+  fCmdSetStatisticsFile->AvailableForStates(G4State_PreInit, G4State_Init,
+                                            G4State_Idle);
+  fCmdSetStatisticsFile->SetGuidance(
+      "Write the portal statistics as JSON to this file at the end of every "
+      "run, an empty name disables writing");
+  fCmdSetStatisticsFile->SetParameterName("filename", true);
+  fCmdSetStatisticsFile->SetDefaultValue("");
+  fCmdSetStatisticsFile->SetToBeBroadcasted(false);
+
+  fState = G4StateManager::GetStateManager()->GetCurrentState();
+  G4StateManager::GetStateManager()->RegisterDependent(this);
+}
+
+Surface::PortalStatisticsMessenger::~PortalStatisticsMessenger() {
+  G4StateManager::GetStateManager()->DeregisterDependent(this);
+  delete fCmdSetStatisticsFile;
+  delete fCmdResetStatistics;
+  delete fCmdPrintStatistics;
+  delete fSubDirectory;
+  delete fDirectory;
+}
+
+void Surface::PortalStatisticsMessenger::SetNewValue(G4UIcommand *command,
+                                                     G4String newValues) {
+  Logger logger("PortalStatistics");
+  if (command == fCmdSetStatisticsFile) {
+    fFilename = newValues;
+    return;
+  }
+  if (!kPortalStatistics) {
+    logger.WriteWarning("Portal statistics are not compiled in, "
+                        "configure with -DSCORE4_PORTAL_STATISTICS=ON");
+    return;
+  }
+  if (command == fCmdPrintStatistics) {
+    logger.WriteAlways(PortalStatistics::Summary());
+  } else if (command == fCmdResetStatistics) {
+    PortalStatistics::Reset();
+  }
+}
+
+G4bool Surface::PortalStatisticsMessenger::Notify(
+    const G4ApplicationState requestedState) {
+  const G4ApplicationState previousState = fState;
+  fState = requestedState;
+  if (kPortalStatistics && !fFilename.empty() &&
+      previousState == G4State_GeomClosed && requestedState == G4State_Idle) {
+    if (!PortalStatistics::WriteJson(fFilename)) {
+      Logger("PortalStatistics")
+          .WriteError("Cannot write portal statistics to " + fFilename);
+    }
+  }
+  return true;
+}
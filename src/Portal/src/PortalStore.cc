@@ -6,10 +6,37 @@
  */
 #include "Portal/include/PortalStore.hh"
 
+#include "G4AutoLock.hh"
 #include "G4LogicalVolume.hh"
 #include "G4VPhysicalVolume.hh"
 #include "Portal/include/VPortal.hh"
 
+namespace {
+G4Mutex triggerIndexMutex = G4MUTEX_INITIALIZER;
+}
+
+void Surface::PortalStore::push_back(VPortal *portal) {
+  Base::push_back(portal);
+  InvalidateTriggerIndex();
+}
+
+Surface::PortalStore::const_iterator Surface::PortalStore::erase(
+    const const_iterator position) {
+  const auto next = Base::erase(position);
+  InvalidateTriggerIndex();
+  return next;
+}
+
+void Surface::PortalStore::SetPortal(const size_type idx, VPortal *portal) {
+  Base::at(idx) = portal;
+  InvalidateTriggerIndex();
+}
+
+void Surface::PortalStore::clear() {
+  Base::clear();
+  InvalidateTriggerIndex();
+}
+
 G4int Surface::PortalStore::FindPortal(const G4VPhysicalVolume *volume) const {
   for (size_t i = 0; i < this->size(); ++i) {
     if (this->at(i)->GetVolume() == volume) {
@@ -53,15 +80,49 @@ G4bool Surface::PortalStore::IsLogPortal(
 }
 
 G4int Surface::PortalStore::FindTrigger(const G4VPhysicalVolume *volume) const {
-  for (size_t i = 0; i < this->size(); ++i) {
-    if (this->at(i)->GetTrigger() == volume) {
-      return static_cast<G4int>(i);
+  if (!fTriggerIndexValid.load(std::memory_order_acquire)) {
+    // lazy rebuild, worker threads may arrive here at the same time
+    G4AutoLock lock(&triggerIndexMutex);
+    if (!fTriggerIndexValid.load(std::memory_order_relaxed)) {
+      FillTriggerIndex();
     }
   }
-  return -1;
+  const auto it = fTriggerIndex.find(volume);
+  if (it == fTriggerIndex.end()) {
+    return -1;
+  }
+  return it->second;
 }
 
 G4bool Surface::PortalStore::IsTrigger(const G4VPhysicalVolume *volume) const {
   const G4int portalIdx = FindTrigger(volume);
   return portalIdx >= 0;
 }
+
+Surface::VPortal *Surface::PortalStore::GetPortalOfTrigger(
+    const G4VPhysicalVolume *volume) const {
+  const G4int portalIdx = FindTrigger(volume);
+  if (portalIdx >= 0) {
+    return (*this)[portalIdx];
+  }
+  return nullptr;
+}
+
+void Surface::PortalStore::BuildTriggerIndex() const {
+  G4AutoLock lock(&triggerIndexMutex);
+  FillTriggerIndex();
+}
+
+void Surface::PortalStore::FillTriggerIndex() const {
+  fTriggerIndex.clear();
+  fTriggerIndex.reserve(this->size());
+  for (size_t i = 0; i < this->size(); ++i) {
+    const G4VPhysicalVolume *trigger = this->at(i)->GetTrigger();
+    if (trigger == nullptr) {
+      continue;
+    }
+    // keep first portal registered for a trigger, same as the linear search
+    fTriggerIndex.emplace(trigger, static_cast<G4int>(i));
+  }
+  fTriggerIndexValid.store(true, std::memory_order_release);
+}
@@ -20,26 +20,22 @@
  */
 G4ThreeVector Surface::SimplePortal::TransformBetweenPortals(
     const G4ThreeVector &vec) {
-  const G4VPhysicalVolume *volume = GetVolume();
-  const G4VPhysicalVolume *otherVolume = fOtherPortal->GetVolume();
-
-  G4ThreeVector pMin, pMax;
-  volume->GetLogicalVolume()->GetSolid()->BoundingLimits(pMin, pMax);
-  const G4ThreeVector volumeDistance = pMax - pMin;
-
-  otherVolume->GetLogicalVolume()->GetSolid()->BoundingLimits(pMin, pMax);
-  const G4ThreeVector otherVolumeDistance = pMax - pMin;
-
   G4ThreeVector transformedVec = vec;
-  transformedVec.setX(vec.x() / volumeDistance.x() * otherVolumeDistance.x());
-  transformedVec.setY(vec.y() / volumeDistance.y() * otherVolumeDistance.y());
-  transformedVec.setZ(vec.z() / volumeDistance.z() * otherVolumeDistance.z());
+  transformedVec.setX(vec.x() * fScale.x());
+  transformedVec.setY(vec.y() * fScale.y());
+  transformedVec.setZ(vec.z() * fScale.z());
 
   return transformedVec;
 }
 
 void Surface::SimplePortal::SetOtherPortal(Surface::SimplePortal *otherPortal) {
   fOtherPortal = otherPortal;
+  // cache ratio of extents for the transformation
+  const G4ThreeVector &volumeDistance = GetExtent();
+  const G4ThreeVector &otherVolumeDistance = fOtherPortal->GetExtent();
+  fScale.set(otherVolumeDistance.x() / volumeDistance.x(),
+             otherVolumeDistance.y() / volumeDistance.y(),
+             otherVolumeDistance.z() / volumeDistance.z());
 }
 
 /**
@@ -49,13 +45,14 @@ void Surface::SimplePortal::SetOtherPortal(Surface::SimplePortal *otherPortal) {
 void Surface::SimplePortal::DoPortation(G4Step *step) {
   G4ThreeVector prePosition = step->GetPreStepPoint()->GetPosition();
 
-  fLogger.WriteDebugInfo("PrePosition: ", prePosition);
+  SCORE4_LOG_DEBUG(fLogger, "PrePosition: ", prePosition);
   TransformToLocalCoordinate(prePosition);
 
   // Transformation of position
   TransformBetweenPortals(prePosition);
   fOtherPortal->TransformToGlobalCoordinate(prePosition);
-  fLogger.WriteDebugInfo("PostPosition: ", prePosition);
+  SCORE4_LOG_DEBUG(fLogger, "PostPosition: ", prePosition);
 
   UpdatePosition(step, prePosition);
+  CountPortation(PortationType::ENTER);
 }
@@ -0,0 +1,76 @@
+/**
+ * @brief Implementation of class SubworldTrackInformation
+ * @author agent
+ * @date 2026-10-17
+ * @file SubworldTrackInformation.cc
+ */
+
+#include "Portal/include/SubworldTrackInformation.hh"
+
+#include <vector>
+
+#include "G4DynamicParticle.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4ios.hh"
+
+void Surface::SubworldPrimaryInformation::Print() const {
+  G4cout << "Subworld grid position X: " << fPosition.x
+         << " Y: " << fPosition.y << G4endl;
+}
+
+void Surface::SubworldTrackInformation::Print() const {
+  G4cout << "Subworld grid position X: " << fPosition.x
+         << " Y: " << fPosition.y << G4endl;
+}
+
+Surface::SubworldTrackInformation *Surface::SubworldTrackInformation::Find(
+    const G4Track *track) {
+  G4VUserTrackInformation *info = track->GetUserInformation();
+  if (info != nullptr) {
+    return dynamic_cast<SubworldTrackInformation *>(info);
+  }
+  const G4PrimaryParticle *primary =
+      track->GetDynamicParticle()->GetPrimaryParticle();
+  if (primary == nullptr) {
+    return nullptr;
+  }
+  const auto *primaryInfo = dynamic_cast<const SubworldPrimaryInformation *>(
+      primary->GetUserInformation());
+  if (primaryInfo == nullptr) {
+    return nullptr;
+  }
+  auto *trackInfo = new SubworldTrackInformation(primaryInfo->GetPosition());
+  track->SetUserInformation(trackInfo);  // track takes ownership
+  return trackInfo;
+}
+
+G4bool Surface::SubworldTrackInformation::Store(const G4Track *track,
+                                                const GridPosition &position) {
+  G4VUserTrackInformation *info = track->GetUserInformation();
+  if (info == nullptr) {
+    track->SetUserInformation(new SubworldTrackInformation(position));
+    return true;
+  }
+  auto *trackInfo = dynamic_cast<SubworldTrackInformation *>(info);
+  if (trackInfo == nullptr) {
+    return false;
+  }
+  trackInfo->SetPosition(position);
+  return true;
+}
+
+void Surface::SubworldTrackInformation::PassToSecondaries(const G4Step *step) {
+  if (step->GetNumberOfSecondariesInCurrentStep() == 0) {
+    return;
+  }
+  const SubworldTrackInformation *parentInfo = Find(step->GetTrack());
+  if (parentInfo == nullptr) {
+    return;
+  }
+  for (const G4Track *secondary : *step->GetSecondaryInCurrentStep()) {
+    if (secondary->GetUserInformation() == nullptr) {
+      secondary->SetUserInformation(
+          new SubworldTrackInformation(parentInfo->GetPosition()));
+    }
+  }
+}
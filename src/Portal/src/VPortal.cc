@@ -7,22 +7,41 @@
 
 #include "Portal/include/VPortal.hh"
 
+#include <chrono>
+#include <cmath>
 #include <cstdlib>
 #include <utility>
 
+#include "G4Box.hh"
 #include "G4EventManager.hh"
+#include "G4GeometryTolerance.hh"
+#include "G4LogicalVolume.hh"
+#include "G4ParticleDefinition.hh"
 #include "G4PathFinder.hh"
+#include "G4ProcessManager.hh"
 #include "G4ThreeVector.hh"
 #include "G4TransportationManager.hh"
 #include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
 #include "Service/include/Logger.hh"
 
+G4bool Surface::VPortal::fFastRelocation = true;
+G4ThreadLocal G4long Surface::VPortal::fFullRelocations = 0;
+G4ThreadLocal G4long Surface::VPortal::fFastRelocations = 0;
+G4ThreadLocal G4long Surface::VPortal::fSameTriggerFullRelocations = 0;
+
 Surface::VPortal::VPortal(G4String name, G4VPhysicalVolume *volume,
                           PortalType type, VerboseLevel verboseLvl)
     : fName{std::move(name)},
       fVolume{volume},
       fPortalType{type},
       fGlobalCoordSet{false},
+      fExtent{ComputeExtent(volume)},
+      fHalfExtent{fExtent / 2.},
+      fIsBox{IsBoxSolid(volume)},
+      fHalfTolerance{
+          0.5 * G4GeometryTolerance::GetInstance()->GetSurfaceTolerance()},
+      fStatisticsId{PortalStatistics::Register(fName)},
       fLogger{fName, verboseLvl}{
   fLogger.WriteDebugInfo("No global coord set for " + fName);
 }
@@ -35,6 +54,12 @@ Surface::VPortal::VPortal(G4String name, G4VPhysicalVolume *volume,
       fPortalType{type},
       fGlobalCoord{std::move(globalCoord)},
       fGlobalCoordSet{true},
+      fExtent{ComputeExtent(volume)},
+      fHalfExtent{fExtent / 2.},
+      fIsBox{IsBoxSolid(volume)},
+      fHalfTolerance{
+          0.5 * G4GeometryTolerance::GetInstance()->GetSurfaceTolerance()},
+      fStatisticsId{PortalStatistics::Register(fName)},
       fLogger{fName, verboseLvl}{
   fLogger.WriteDebugInfo("Global coord of " + fName +
                          " is set to x: " + std::to_string(fGlobalCoord.x()) +
@@ -42,6 +67,61 @@ Surface::VPortal::VPortal(G4String name, G4VPhysicalVolume *volume,
                          " z: " + std::to_string(fGlobalCoord.z()));
 }
 
+/**
+ * @brief Size of the bounding box of a portal volume
+ * @details Evaluated once at construction, so the portation kernels do not
+ * call BoundingLimits() on every crossing
+ */
+G4ThreeVector Surface::VPortal::ComputeExtent(
+    const G4VPhysicalVolume *volume) {
+  if (volume == nullptr) {
+    return G4ThreeVector{};
+  }
+  G4ThreeVector pMin, pMax;
+  volume->GetLogicalVolume()->GetSolid()->BoundingLimits(pMin, pMax);
+  return pMax - pMin;
+}
+
+/**
+ * @brief Analytic face classification of a point in local coordinates
+ * @details Only valid if the portal solid is a G4Box (see IsBox()). Gives the
+ * same sign pattern as G4Box::SurfaceNormal(): all faces within tolerance are
+ * reported, if the point is on no face the nearest face is taken.
+ * @param localPoint point in the local coordinate system of the portal
+ * @return faces the point lies on
+ */
+Surface::VPortal::BoxFace Surface::VPortal::GetBoxFace(
+    const G4ThreeVector &localPoint) const {
+  const G4double distX = std::fabs(localPoint.x()) - fHalfExtent.x();
+  const G4double distY = std::fabs(localPoint.y()) - fHalfExtent.y();
+  const G4double distZ = std::fabs(localPoint.z()) - fHalfExtent.z();
+  const G4int signX = localPoint.x() < 0. ? -1 : 1;
+  const G4int signY = localPoint.y() < 0. ? -1 : 1;
+  const G4int signZ = localPoint.z() < 0. ? -1 : 1;
+
+  BoxFace face{distX >= -fHalfTolerance ? signX : 0,
+               distY >= -fHalfTolerance ? signY : 0,
+               distZ >= -fHalfTolerance ? signZ : 0};
+  if (face.x == 0 && face.y == 0 && face.z == 0) {
+    if (distX >= distY && distX >= distZ) {
+      face.x = signX;
+    } else if (distY >= distZ) {
+      face.y = signY;
+    } else {
+      face.z = signZ;
+    }
+  }
+  return face;
+}
+
+G4bool Surface::VPortal::IsBoxSolid(const G4VPhysicalVolume *volume) {
+  if (volume == nullptr) {
+    return false;
+  }
+  return dynamic_cast<const G4Box *>(
+             volume->GetLogicalVolume()->GetSolid()) != nullptr;
+}
+
 G4ThreeVector Surface::VPortal::GetLocalCoordSystem() const {
   if (fGlobalCoordSet) {
     return fGlobalCoord;
@@ -79,6 +159,9 @@ void Surface::VPortal::UpdatePosition(G4Step *step,
 void Surface::VPortal::UpdatePositionMomentum(
     G4Step *step, const G4ThreeVector &newPosition,
     const G4ThreeVector &newDirection) {
+  const auto start = kPortalStatistics
+                         ? std::chrono::steady_clock::now()
+                         : std::chrono::steady_clock::time_point{};
 
   G4Navigator *navigator = G4TransportationManager::GetTransportationManager()
                                ->GetNavigatorForTracking();
@@ -90,7 +173,42 @@ void Surface::VPortal::UpdatePositionMomentum(
 
   G4PathFinder::GetInstance()->ReLocate(newPosition);
   G4PathFinder::GetInstance()->ComputeSafety(newPosition);
+  ++fFullRelocations;
+
+  UpdateTrack(step, newPosition, newDirection);
+  if (kPortalStatistics) {
+    PortalStatistics::Local().CountRelocation(
+        std::chrono::steady_clock::now() - start);
+  }
+}
+
+void Surface::VPortal::UpdatePositionWithinTrigger(
+    G4Step *step, const G4ThreeVector &newPosition) {
+  // the path finder keeps its own state of all navigators, it needs a full
+  // relocation
+  if (!fFastRelocation || IsPathFinderActive(step->GetTrack())) {
+    ++fSameTriggerFullRelocations;
+    UpdatePosition(step, newPosition);
+    return;
+  }
+  const G4ThreeVector direction =
+      step->GetPostStepPoint()->GetMomentumDirection();
+  // the new position lies in the trigger of the post step point as well, the
+  // touchable history stays valid and only the local point is moved. The
+  // safety is not computed here, the transportation of the next step finds
+  // its stored safety invalid at the new position and computes it.
+  G4Navigator *navigator = G4TransportationManager::GetTransportationManager()
+                               ->GetNavigatorForTracking();
+  navigator->LocateGlobalPointWithinVolume(newPosition);
+  ++fFastRelocations;
+
+  UpdateTrack(step, newPosition, direction);
+}
 
+void Surface::VPortal::UpdateTrack(G4Step *step,
+                                   const G4ThreeVector &newPosition,
+                                   const G4ThreeVector &newDirection) {
+  G4StepPoint *stepPoint = step->GetPostStepPoint();
   G4Track *track = step->GetTrack();
   track->SetPosition(newPosition);
   track->SetMomentumDirection(newDirection);
@@ -107,6 +225,29 @@ void Surface::VPortal::UpdatePositionMomentum(
   }
 }
 
+G4bool Surface::VPortal::IsPathFinderActive(const G4Track *track) {
+  if (G4TransportationManager::GetTransportationManager()
+          ->GetNoActiveNavigators() > 1) {
+    return true;
+  }
+  // coupled transportation steps with the path finder also for a single
+  // navigator, looked up once per particle type
+  static G4ThreadLocal const G4ParticleDefinition *lastParticle = nullptr;
+  static G4ThreadLocal G4bool lastCoupled = false;
+  const G4ParticleDefinition *particle = track->GetDefinition();
+  if (particle != lastParticle) {
+    G4ProcessManager *manager = particle->GetProcessManager();
+    lastCoupled = manager != nullptr &&
+                  manager->GetProcess("CoupledTransportation") != nullptr;
+    lastParticle = particle;
+  }
+  return lastCoupled;
+}
+
+void Surface::VPortal::SetFastRelocation(const G4bool enable) {
+  fFastRelocation = enable;
+}
+
 void Surface::VPortal::SetVerbose(const VerboseLevel verboseLvl) {
   fLogger.SetVerboseLvl(verboseLvl);
 }
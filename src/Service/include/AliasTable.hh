@@ -0,0 +1,70 @@
+/**
+ * @brief Alias table for constant time sampling of discrete distributions
+ * @author agent
+ * @date 2026-10-17
+ * @file AliasTable.hh
+ */
+
+#ifndef SRC_SERVICE_INCLUDE_ALIASTABLE_HH
+#define SRC_SERVICE_INCLUDE_ALIASTABLE_HH
+
+#include <cstddef>
+#include <sstream>
+#include <vector>
+
+#include "G4Types.hh"
+#include "Randomize.hh"
+
+namespace Surface {
+/**
+ * @brief AliasTable samples an index i with probability w_i / sum(w).
+ * @details Built with the method of Vose in O(N). Every draw costs one
+ * uniform random number and one table lookup, independent of the number of
+ * bins. Bins with zero weight are never returned, as with a scan over the
+ * cumulative distribution.
+ */
+class AliasTable {
+ public:
+  AliasTable() = default;
+  explicit AliasTable(const std::vector<G4double> &weights) { Build(weights); }
+
+  /**
+   * @brief Builds the table from (not normalised) weights.
+   * @details Weights must be >= 0 with a positive sum, otherwise the program
+   * stops.
+   */
+  void Build(const std::vector<G4double> &weights);
+
+  /**
+   * @brief Returns a random index distributed according to the weights.
+   */
+  inline std::size_t Sample() const { return Sample(G4UniformRand()); }
+  /**
+   * @brief Returns index for a given uniform random number in [0,1).
+   */
+  inline std::size_t Sample(G4double random) const {
+    const G4double scaled = random * static_cast<G4double>(fThreshold.size());
+    std::size_t idx = static_cast<std::size_t>(scaled);
+    if (idx >= fThreshold.size()) {
+      idx = fThreshold.size() - 1;
+    }
+    return (scaled - static_cast<G4double>(idx)) < fThreshold[idx] ? idx
+                                                                   : fAlias[idx];
+  }
+
+  /// Normalised probability of bin idx
+  inline G4double GetProbability(std::size_t idx) const {
+    return fProbability.at(idx);
+  }
+  inline std::size_t Size() const { return fProbability.size(); }
+  inline G4bool IsEmpty() const { return fProbability.empty(); }
+
+  std::stringstream StreamInfo() const;
+
+ private:
+  std::vector<G4double> fProbability;  ///< normalised weights
+  std::vector<G4double> fThreshold;    ///< acceptance of own bin
+  std::vector<std::size_t> fAlias;     ///< bin used otherwise
+};
+}  // namespace Surface
+#endif  // SRC_SERVICE_INCLUDE_ALIASTABLE_HH
@@ -37,6 +37,7 @@
 #define G4VOXELIZER_GREEN_HH
 
 #include <G4ThreeVector.hh>
+#include <cstddef>
 #include <map>
 #include <string>
 #include <vector>
@@ -48,9 +49,12 @@
 #include "G4Transform3D.hh"
 #include "G4VFacet.hh"
 #include "G4VSolid.hh"
+#include "Service/include/Logger.hh"
 
 namespace Surface {
 
+class RoughnessCache;
+
 struct G4VoxelBox {
   G4ThreeVector hlen;  // half length of the box
   G4ThreeVector pos;   // position of the box
@@ -63,6 +67,9 @@ struct G4VoxelInfo {
 };
 
 class G4Voxelizer_Green {
+  // stores and restores the voxel structure of a G4MultiUnion
+  friend class RoughnessCache;
+
  public:
   template <typename T>
   static inline G4int BinarySearch(const std::vector<T> &vec, T value);
@@ -71,6 +78,10 @@ class G4Voxelizer_Green {
                 std::vector<G4Transform3D> &transforms);
   void Voxelize(std::vector<G4VFacet *> &facets);
   void Voxelize(G4MultiUnion *munion);
+  void CountBoundaries(G4MultiUnion *munion, G4int counts[3]);
+  // Number of distinct node boundaries along each axis, before the
+  // reduction to SetMaxBoundary(). Only builds the voxel limits and
+  // boundaries, Voxelize() has to be called afterwards.
   void DisplayVoxelLimits() const;
   void DisplayBoundaries();
   void DisplayListNodes() const;
@@ -135,7 +146,8 @@ class G4Voxelizer_Green {
 
   inline G4int GetMaxVoxels(G4ThreeVector &ratioOfReduction);
 
-  G4int AllocatedMemory();
+  std::size_t AllocatedMemory() const;
+  // Memory of the voxel structure in bytes
 
   inline long long GetCountOfVoxels() const;
 
@@ -159,8 +171,19 @@ class G4Voxelizer_Green {
 
   static G4int GetDefaultVoxelsCount();
 
+  static void SetBuildThreads(G4int threads);
+  // Number of threads used to build the voxels, <= 0: all hardware threads.
+  // The result does not depend on the number of threads.
+
+  static G4int GetBuildThreads();
+
+  static void SetVerbose(VerboseLevel level);
+  // Verbosity of the build, time and memory of each phase at DetailInfo.
+
   void SetMaxBoundary(const G4int maxX, const G4int maxY, const G4int maxZ);
 
+  inline G4int GetMaxBoundary(G4int axis) const;
+
  private:
   class G4VoxelComparator {
    public:
@@ -218,6 +241,10 @@ class G4Voxelizer_Green {
  private:
   static G4ThreadLocal G4int fDefaultVoxelsCount;
 
+  static G4ThreadLocal G4int fBuildThreads;
+
+  static G4ThreadLocal VerboseLevel fVerbose;
+
   std::vector<G4VoxelBox> fVoxelBoxes;
   std::vector<std::vector<G4int>> fVoxelBoxesCandidates;
   mutable std::map<G4int, std::vector<G4int>> fCandidates;
@@ -117,10 +117,42 @@ class Logger {
   inline G4bool IsInfoLvl() const {return VerboseLevel::Info <= fVerboseLvl;}
   inline G4bool IsDetailInfoLvl() const {return VerboseLevel::DetailInfo <= fVerboseLvl;}
   inline G4bool IsDebugInfoLvl() const {return VerboseLevel::DebugInfo <= fVerboseLvl;}
+  inline G4bool IsLvl(const VerboseLevel aVerboseLvl) const {return aVerboseLvl <= fVerboseLvl;}
 
  private:
   G4String fLoggerName; /// logger name of instance
   VerboseLevel fVerboseLvl; /// set verbose level of instance
 };
+
+/**
+ * @brief Lowest verbose level compiled into the binary
+ * @details Set with -DSCORE4_LOG_LEVEL=<Error|Warning|Info|DetailInfo|DebugInfo>.
+ * Log statements written with the SCORE4_LOG macros above this level are
+ * removed by the compiler.
+ */
+#ifndef SCORE4_LOG_LEVEL
+#define SCORE4_LOG_LEVEL DebugInfo
+#endif
+constexpr VerboseLevel kCompiledVerboseLvl = VerboseLevel::SCORE4_LOG_LEVEL;
 }  // namespace Surface
+
+/**
+ * @brief Writes to a logger, arguments are only evaluated if the level is active
+ * @details The level is checked at compile time against SCORE4_LOG_LEVEL and at
+ * runtime against the level of the logger. Arguments are the same as for
+ * Logger::Write<level>(..).
+ * Example: SCORE4_LOG(fLogger, DebugInfo, "Position", position);
+ */
+#define SCORE4_LOG(logger, level, ...)                                    \
+  do {                                                                    \
+    if (::Surface::VerboseLevel::level <= ::Surface::kCompiledVerboseLvl && \
+        (logger).IsLvl(::Surface::VerboseLevel::level)) {                 \
+      (logger).Write##level(__VA_ARGS__);                                 \
+    }                                                                     \
+  } while (false)
+
+#define SCORE4_LOG_DEBUG(logger, ...) SCORE4_LOG(logger, DebugInfo, __VA_ARGS__)
+#define SCORE4_LOG_DETAIL(logger, ...) SCORE4_LOG(logger, DetailInfo, __VA_ARGS__)
+#define SCORE4_LOG_INFO(logger, ...) SCORE4_LOG(logger, Info, __VA_ARGS__)
+
 #endif  // SRC_SERVICE_INCLUDE_LOGGER_HH
@@ -0,0 +1,120 @@
+/**
+ * @brief Confinement of shifted start points to a material
+ * @author agent
+ * @date 2026-10-17
+ * @file MaterialConfinement.hh
+ */
+
+#ifndef SRC_SERVICE_INCLUDE_MATERIALCONFINEMENT_HH
+#define SRC_SERVICE_INCLUDE_MATERIALCONFINEMENT_HH
+
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "G4String.hh"
+#include "G4ThreeVector.hh"
+#include "G4Types.hh"
+#include "Service/include/Logger.hh"
+#include "Service/include/ShiftTable.hh"
+
+class G4Material;
+class G4Navigator;
+
+namespace Surface {
+/**
+ * @brief MaterialConfinement decides whether shifted points lie in a set
+ * material.
+ * @details Two modes are provided. Rejection locates every candidate point in
+ * the geometry, the caller draws again until a point is in the material.
+ * Boundary walks once per shift along the shift direction through the
+ * geometry: it locates the point, steps to the next boundary and repeats up
+ * to the deepest possible shift. The depth intervals inside the material are
+ * handed to ShiftTable::SampleWithin(), which draws within them directly.
+ * The walk uses an own G4Navigator on the tracking world, the state of the
+ * tracking navigator is not touched. Materials are compared by pointer, the
+ * name is resolved on first use.
+ * A walk stops after kMaxCrossings boundaries, SampleShift() then falls back
+ * to rejection.
+ * The number of locates is counted and compared to the expected locates of
+ * rejection sampling, 1 / share of the table in the material, at most
+ * kMaxRejections.
+ */
+class MaterialConfinement {
+ public:
+  enum class Mode { Rejection, Boundary };
+  /// Boundaries crossed by a walk at most
+  static constexpr G4int kMaxCrossings{1000};
+  /// Draws of rejection sampling at most, the last draw is taken
+  static constexpr G4int kMaxRejections{10000};
+
+  MaterialConfinement();
+  ~MaterialConfinement();
+
+  /// Empty name: no confinement
+  void SetMaterial(const G4String &materialName);
+  inline const G4String &GetMaterialName() const { return fMaterialName; }
+  inline G4bool IsActive() const { return !fMaterialName.empty(); }
+  inline void SetMode(const Mode mode) { fMode = mode; }
+  inline Mode GetMode() const { return fMode; }
+
+  /// Locates point, true if it is in the material
+  G4bool Contains(const G4ThreeVector &point);
+  /**
+   * @brief Depth intervals within [low, high] in the material
+   * @param direction unit vector, points to increasing depth
+   * @param intervals filled with the intervals found
+   * @param locates number of locates done
+   * @return false if the walk stopped after kMaxCrossings boundaries before
+   * reaching high, the intervals are incomplete
+   */
+  G4bool Intervals(const G4ThreeVector &position,
+                   const G4ThreeVector &direction, G4double low, G4double high,
+                   std::vector<ShiftTable::Interval> &intervals,
+                   G4int &locates);
+
+  /**
+   * @brief Draws the shift of a start point from the table
+   * @details Without a material every depth is accepted. Otherwise the depth
+   * is drawn within the material, by the walk in Boundary mode and by
+   * rejection in Rejection mode or if the walk is incomplete. The shift is
+   * counted.
+   * @param direction unit vector, the point is shifted against it
+   * @param logger warnings and errors of the draw are written to it
+   * @return depth in Geant4 units
+   */
+  G4double SampleShift(const ShiftTable &table, const G4ThreeVector &position,
+                       const G4ThreeVector &direction, const Logger &logger);
+
+  /**
+   * @brief Counts a finished shift
+   * @param locates locates done for the shift
+   * @param rejectionLocates expected locates of rejection sampling
+   */
+  void CountShift(G4int locates, G4double rejectionLocates);
+  std::stringstream StreamStatistics() const;
+
+ private:
+  /// @return false if the walk was not completed, depth is not set
+  G4bool SampleWithin(const ShiftTable &table, const G4ThreeVector &position,
+                      const G4ThreeVector &direction, const Logger &logger,
+                      G4double &depth);
+  G4double SampleByRejection(const ShiftTable &table,
+                             const G4ThreeVector &position,
+                             const G4ThreeVector &direction,
+                             const Logger &logger);
+  const G4Material *Material();
+  G4Navigator *Navigator();
+
+ private:
+  G4String fMaterialName;
+  const G4Material *fMaterial{nullptr};
+  std::unique_ptr<G4Navigator> fNavigator;
+  Mode fMode{Mode::Boundary};
+  G4int fShifts{0};
+  G4double fLocates{0};
+  G4double fRejectionLocates{0};
+};
+}  // namespace Surface
+
+#endif  // SRC_SERVICE_INCLUDE_MATERIALCONFINEMENT_HH
@@ -47,6 +47,9 @@ class MultiportalHelper {
 
   void SetNDifferentSubworlds(G4int val);
 
+  void SetGridStorage(GridStorage storage);
+  void SetGridStorage(const G4String &storageName);
+
   void SetPortalName(const G4String &name);
   void SetSubworldName(const G4String &name);
 
@@ -81,6 +84,8 @@ class MultiportalHelper {
   void LinkPortalWithSubworlds();
   void FillSubworldMap() const;
   void AddRoughness();
+  /// applies the verbose level of the helper to its portals
+  void SetPortalVerbose();
 
  private:
   // General Infos
@@ -112,6 +117,7 @@ class MultiportalHelper {
   // Number of Subworlds
   G4int fNx;
   G4int fNy;
+  GridStorage fGridStorage;
 
   Surface::MultipleSubworld *fPortal;
 
@@ -51,6 +51,8 @@ class MultiportalHelperMessenger final : public G4UImessenger {
 
   G4UIcmdWithAnInteger *fCmdSetNxSubworld;
   G4UIcmdWithAnInteger *fCmdSetNySubworld;
+
+  G4UIcmdWithAString *fCmdSetGridStorage;
 };
 }  // namespace Surface
 
@@ -0,0 +1,50 @@
+/**
+ * @brief Splits a loop over contiguous chunks onto several threads
+ * @author agent
+ * @date 2026-10-17
+ * @file ParallelFor.hh
+ */
+
+#ifndef SRC_SERVICE_INCLUDE_PARALLELFOR_HH
+#define SRC_SERVICE_INCLUDE_PARALLELFOR_HH
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "G4Types.hh"
+
+namespace Surface {
+/**
+ * @brief Splits [0, count) into contiguous chunks, one per thread, and calls
+ * work(chunk, begin, end) for each.
+ * @details Chunk borders are multiples of align, so chunks writing bits of
+ * consecutive items never share a byte. Chunk 0 runs on the calling thread.
+ */
+template <class F>
+void ParallelFor(const G4int count, const G4int threads, const G4int align,
+                 F &&work) {
+  const G4int blocks = (count + align - 1) / align;
+  const G4int chunks = std::min(threads, blocks);
+  if (chunks <= 1) {
+    work(0, 0, count);
+    return;
+  }
+  auto border = [=](G4int chunk) {
+    return std::min(count, blocks * chunk / chunks * align);
+  };
+  std::vector<std::thread> pool;
+  pool.reserve(chunks - 1);
+  for (G4int chunk = 1; chunk < chunks; ++chunk) {
+    pool.emplace_back([&work, &border, chunk] {
+      work(chunk, border(chunk), border(chunk + 1));
+    });
+  }
+  work(0, 0, border(1));
+  for (auto &thread : pool) {
+    thread.join();
+  }
+}
+}  // namespace Surface
+
+#endif  // SRC_SERVICE_INCLUDE_PARALLELFOR_HH
@@ -0,0 +1,171 @@
+/**
+ * @brief Scoped timers of the hot paths
+ * @author agent
+ * @date 2026-10-17
+ * @file Profiler.hh
+ */
+
+#ifndef SRC_SERVICE_INCLUDE_PROFILER_HH
+#define SRC_SERVICE_INCLUDE_PROFILER_HH
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "G4String.hh"
+#include "G4Threading.hh"
+#include "G4Types.hh"
+
+/**
+ * @brief Profiler compiled into the binary
+ * @details Set with -DSCORE4_PROFILER=<ON|OFF>. If off, SCORE4_PROFILE_SCOPE
+ * expands to nothing.
+ */
+#ifndef SCORE4_PROFILER
+#define SCORE4_PROFILER 0
+#endif
+
+namespace Surface {
+
+constexpr G4bool kProfiler = SCORE4_PROFILER != 0;
+
+/**
+ * @brief Profiler accumulates the time spent in named scopes
+ * @details A scope is timed by a Profiler::Scope living on the stack, usually
+ * created with SCORE4_PROFILE_SCOPE("Class::Method"). Every thread accumulates
+ * calls and time per scope into its own counters and records the timed calls
+ * as trace events, up to a limit per thread. With a sampling of n, every call
+ * is counted but only every n-th call of a scope is timed, the total time is
+ * extrapolated. Times are inclusive, nested scopes are also part of the time
+ * of their parent. Counters of all threads are summed for the report, which
+ * must only happen while no events are processed (e.g. between runs).
+ * Profiling is enabled by default if compiled in, the commands in
+ * /Surface/Profiler/ exist once the first scope is registered.
+ */
+class Profiler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Times the enclosing scope
+  class Scope {
+   public:
+    explicit Scope(const G4int id) {
+      if (kProfiler && IsEnabled()) {
+        Profiler &profiler = Local();
+        if (profiler.Begin(id)) {
+          fProfiler = &profiler;
+          fId = id;
+          fStart = Clock::now();
+        }
+      }
+    }
+    ~Scope() {
+      if (fProfiler != nullptr) {
+        fProfiler->End(fId, fStart, Clock::now());
+      }
+    }
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+   private:
+    Profiler *fProfiler{nullptr};  ///< only set if this call is timed
+    G4int fId{0};
+    Clock::time_point fStart;
+  };
+
+  /**
+   * @brief Registers a scope
+   * @return index of the scope in the profiler
+   */
+  static G4int Register(const G4String &name);
+
+  /// Counters of the calling thread
+  static Profiler &Local() {
+    if (fLocal == nullptr) {
+      fLocal = Create();
+    }
+    return *fLocal;
+  }
+
+  static inline G4bool IsEnabled() {
+    return fEnabled.load(std::memory_order_relaxed);
+  }
+  static void SetEnabled(G4bool enable);
+  /// Time every n-th call of a scope, n = 1 times all calls
+  static void SetSampling(G4long every);
+  /// Trace events kept per thread, later calls are only counted
+  static void SetTraceLimit(std::size_t events);
+
+  /// Table of all scopes sorted by total time
+  static std::string Report();
+  /// Timed calls of all threads in the Chrome trace event format
+  static std::string Trace();
+  /// @return false if the file could not be written
+  static G4bool WriteTrace(const G4String &filename);
+  /// Clears all counters and restarts the wall clock
+  static void Reset();
+
+ private:
+  struct Counter {
+    G4long calls{0};
+    G4long timedCalls{0};
+    Clock::duration time{0};
+  };
+
+  struct TraceEvent {
+    G4int id;
+    Clock::time_point start;
+    Clock::duration duration;
+  };
+
+  Profiler() = default;
+  static Profiler *Create();
+
+  inline Counter &Get(const G4int id) {
+    const auto idx = static_cast<std::size_t>(id);
+    if (idx >= fCounters.size()) {
+      fCounters.resize(idx + 1);
+    }
+    return fCounters[idx];
+  }
+  /// Counts a call, @return true if the call is timed
+  inline G4bool Begin(const G4int id) {
+    return Get(id).calls++ % fSampling.load(std::memory_order_relaxed) == 0;
+  }
+  void End(G4int id, Clock::time_point start, Clock::time_point stop);
+
+ private:
+  std::vector<Counter> fCounters;
+  std::vector<TraceEvent> fTrace;
+  G4long fDropped{0};  ///< timed calls not recorded in the trace
+  G4int fThreadId{0};  ///< Geant4 thread id, -1 for the master
+  static std::atomic<G4bool> fEnabled;
+  static std::atomic<G4long> fSampling;
+  static std::atomic<std::size_t> fTraceLimit;
+  static G4ThreadLocal Profiler *fLocal;
+};
+}  // namespace Surface
+
+#define SCORE4_PROFILE_CONCAT_(a, b) a##b
+#define SCORE4_PROFILE_CONCAT(a, b) SCORE4_PROFILE_CONCAT_(a, b)
+
+/**
+ * @brief Times the rest of the enclosing block as scope "name"
+ * @details The scope is registered once, at the first call. Removed by the
+ * compiler if SCORE4_PROFILER is off.
+ * Example: SCORE4_PROFILE_SCOPE("PortalControl::DoStep");
+ */
+#if SCORE4_PROFILER
+#define SCORE4_PROFILE_SCOPE(name)                                       \
+  static const G4int SCORE4_PROFILE_CONCAT(score4ProfileId, __LINE__) =  \
+      ::Surface::Profiler::Register(name);                               \
+  const ::Surface::Profiler::Scope SCORE4_PROFILE_CONCAT(                \
+      score4ProfileScope, __LINE__)(                                     \
+      SCORE4_PROFILE_CONCAT(score4ProfileId, __LINE__))
+#else
+#define SCORE4_PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
+
+#endif  // SRC_SERVICE_INCLUDE_PROFILER_HH
@@ -0,0 +1,54 @@
+/**
+ * @brief Messenger for Profiler
+ * @author agent
+ * @date 2026-10-17
+ * @file ProfilerMessenger.hh
+ */
+
+#ifndef SRC_SERVICE_INCLUDE_PROFILERMESSENGER_HH
+#define SRC_SERVICE_INCLUDE_PROFILERMESSENGER_HH
+
+#include "G4ApplicationState.hh"
+#include "G4String.hh"
+#include "G4UImessenger.hh"
+#include "G4VStateDependent.hh"
+
+class G4UIcommand;
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithoutParameter;
+
+namespace Surface {
+
+/**
+ * @brief Commands of the profiler in /Surface/Profiler/
+ * @details Prints the report and writes the trace, if a file is set, at the
+ * end of every run. The end of a run is taken from the state change
+ * GeomClosed -> Idle of the master thread.
+ */
+class ProfilerMessenger final : public G4UImessenger,
+                                public G4VStateDependent {
+ public:
+  ProfilerMessenger();
+  ~ProfilerMessenger() override;
+
+  void SetNewValue(G4UIcommand *command, G4String newValues) override;
+  G4bool Notify(G4ApplicationState requestedState) override;
+
+ private:
+  G4UIdirectory *fDirectory;
+  G4UIdirectory *fSubDirectory;
+  G4UIcmdWithABool *fCmdEnable;
+  G4UIcmdWithAnInteger *fCmdSetSampling;
+  G4UIcmdWithAnInteger *fCmdSetTraceLimit;
+  G4UIcmdWithAString *fCmdSetTraceFile;
+  G4UIcmdWithoutParameter *fCmdPrint;
+  G4UIcmdWithoutParameter *fCmdReset;
+  G4String fFilename;
+  G4ApplicationState fState;  ///< last state seen by Notify()
+};
+}  // namespace Surface
+
+#endif  // SRC_SERVICE_INCLUDE_PROFILERMESSENGER_HH
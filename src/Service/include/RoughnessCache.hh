@@ -0,0 +1,108 @@
+/**
+ * @brief On-disk cache of a generated roughness
+ * @author agent
+ * @date 2026-10-17
+ * @file RoughnessCache.hh
+ */
+
+#ifndef SRC_SERVICE_INCLUDE_ROUGHNESSCACHE_HH
+#define SRC_SERVICE_INCLUDE_ROUGHNESSCACHE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "G4String.hh"
+#include "G4Types.hh"
+#include "SurfaceGenerator/include/Storage.hh"
+
+namespace Surface {
+
+class FacetStore;
+class G4Voxelizer_Green;
+
+/**
+ * @brief RoughnessCache stores everything RoughnessHelper builds for a
+ * G4MultiUnion roughness in one binary file: the solid description, the outer
+ * facets of the FacetStore and the voxel structure of the G4MultiUnion.
+ * @details The file is addressed by a hash of a key, a canonical string of
+ * all inputs of the build (parameters and state of the random engine). The
+ * full key is stored in the file as well, a file with another key is treated
+ * as a miss. Files are read through a read only memory mapping and copied
+ * directly into the voxelizer and the FacetStore.
+ * Layout, native byte order (files are not portable between platforms of
+ * different endianness):
+ * char[8] "SC4RGHC", uint32 version, uint32 0x01020304,
+ * uint64 key size, char key[], uint64 engine state size, char state[],
+ * uint64 n descriptions, {uint32 type, uint32 n parameter, uint32 n outer,
+ * float64 rotation[9], float64 translation[3], float64 parameter[],
+ * int32 outer[]}, uint64 n facets, float64 vertex[n facets][3][3],
+ * uint64 n boxes, float64 box[n boxes][6] (half length, position),
+ * int32 bits per slice, int32 total candidates, int32 max boundary[3],
+ * 3 x {uint64 n, float64 boundary[n]}, 3 x {uint32 n bits, uint8 bits[]},
+ * uint32 n bits, uint8 empty[], uint64 n lists,
+ * {int32 voxel, uint64 n, int32 candidate[n]}.
+ */
+class RoughnessCache {
+ public:
+  /**
+   * @param directory directory of the cache files, created on first write
+   * @param key canonical description of all inputs of the build
+   */
+  RoughnessCache(const G4String &directory, const std::string &key);
+  ~RoughnessCache();
+  RoughnessCache(const RoughnessCache &) = delete;
+  RoughnessCache &operator=(const RoughnessCache &) = delete;
+
+  inline const G4String &GetFilename() const { return fFilename; }
+
+  /**
+   * @brief Maps the cache file of the key and checks its layout
+   * @return false if there is no valid file for the key (cache miss)
+   */
+  G4bool Open();
+
+  // Only valid after Open() returned true
+  std::vector<SolidDescription> GetDescription() const;
+  /// Appends the stored facets to the store
+  void FillFacetStore(FacetStore *store) const;
+  /// Restores the voxel structure built by G4Voxelizer_Green::Voxelize()
+  void FillVoxelizer(G4Voxelizer_Green &voxelizer) const;
+  /// State of the random engine after the original build
+  inline const std::string &GetEngineState() const { return fEngineState; }
+
+  /**
+   * @brief Writes the cache file of the key
+   * @details Written to a temporary file and renamed, concurrent jobs never
+   * read a partial file.
+   * @return false if the file could not be written
+   */
+  G4bool Write(const std::vector<SolidDescription> &description,
+               const FacetStore &store, const G4Voxelizer_Green &voxelizer,
+               const std::string &engineState) const;
+
+ private:
+  class Reader;
+  class Writer;
+
+  static G4bool SkipDescription(Reader &reader);
+  static G4bool SkipVoxels(Reader &reader);
+  static void WriteVoxels(Writer &writer, const G4Voxelizer_Green &voxelizer);
+  void Close();
+
+ private:
+  G4String fFilename;
+  std::string fKey;
+  std::string fEngineState;
+  const unsigned char *fData{nullptr};
+  std::size_t fSize{0};
+  std::uint64_t fNDescriptions{0};
+  std::uint64_t fNFacets{0};
+  const unsigned char *fDescriptions{nullptr};
+  const unsigned char *fFacets{nullptr};
+  const unsigned char *fVoxels{nullptr};
+};
+}  // namespace Surface
+
+#endif  // SRC_SERVICE_INCLUDE_ROUGHNESSCACHE_HH
@@ -18,8 +18,18 @@
 namespace Surface {
 
 class RoughnessHelperMessenger;
+class RoughnessCache;
+class G4Voxelizer_Green;
 
 typedef Describer::SpikeShape Spikeform;
+
+/**
+ * @brief Representation of the generated roughness solid
+ * @details MultiUnion: G4MultiUnion of one G4Trd per spike layer and a G4Box
+ * (default). SpikeLattice: single analytic SpikeLatticeSolid describing the
+ * same geometry, memory independent of the number of spikes.
+ */
+enum class RoughnessSolid { MultiUnion, SpikeLattice };
 /**
  * @brief RoughnessHelper class helps the user to build a roughness object
  * @details The class controls the instantiation of all needed classes, passes
@@ -34,7 +44,12 @@ class RoughnessHelper {
   void Generate();
   // Getter
   Describer &Describer();
+  /// nullptr if the SpikeLattice representation was selected
   G4MultiUnion *SolidRoughness() const;
+  /**
+   * @brief Returns generated solid, independent of the selected representation
+   */
+  inline G4VSolid *GetSolid() const { return fSolid; }
   G4LogicalVolume *LogicRoughness() const;
   FacetStore *FacetStore();
   G4String GetRoughnessLogicalVolumeName() const;
@@ -54,7 +69,10 @@ class RoughnessHelper {
   inline G4int GetBoundaryX() const { return fNxBoundary; }
   inline G4int GetBoundaryY() const { return fNyBoundary; }
   inline G4int GetBoundaryZ() const { return fNzBoundary; }
+  inline G4bool GetBoundaryAuto() const { return fAutoBoundary; }
   inline auto GetStepLimit() const { return fStepLimit; }
+  inline RoughnessSolid GetSolidType() const { return fSolidType; }
+  inline const G4String &GetCacheDir() const { return fCacheDir; }
 
   // Setter
   void SetVerbose(VerboseLevel verboseLvl);
@@ -80,20 +98,57 @@ class RoughnessHelper {
   void SetBoundaryX(G4int val);
   void SetBoundaryY(G4int val);
   void SetBoundaryZ(G4int val);
+  /**
+   * @brief Choose the boundaries by timing voxelizations (VoxelTuner)
+   * instead of SetBoundaryX/Y/Z, the result is printed
+   * @details The choice depends on wall-clock timing, identical jobs may
+   * voxelize differently. With a cache directory the setting chosen by the
+   * job that wrote the cache file is used by all jobs with the same key. Pin
+   * the printed boundaries for reproducible voxelizations.
+   */
+  void SetBoundaryAuto(G4bool val);
+  /// memory available for the voxel structure in automatic mode, MB
+  void SetVoxelMemoryLimit(G4int megabytes);
+  /// threads used to voxelize the G4MultiUnion, <= 0: all hardware threads
+  void SetVoxelThreads(G4int val);
 
   void SetStepLimit(G4double val);
 
+  void SetSolidType(RoughnessSolid);
+  void SetSolidType(const G4String &);
+  /**
+   * @brief Directory of the build cache, empty: no cache (default)
+   * @details A MultiUnion roughness built with the same parameters and the
+   * same state of the random engine is restored from the cache instead of
+   * being generated and voxelized again.
+   */
+  void SetCacheDir(const G4String &directory);
+
  private:
   void CheckValues();
+  void PrepareDescriber();
   void BuildSurface();
   void BuildBasis();
+  void BuildLattice();
+  void Voxelize();
+  /// macro commands that pin the current boundaries
+  std::string PinBoundaryCommands() const;
   void Finalize();
+  G4Voxelizer_Green &Voxelizer() const;
+
+  /// canonical string of all inputs of BuildSurface(), BuildBasis() and
+  /// Voxelize(), including the state of the random engine
+  std::string CacheKey() const;
+  /// @return false on cache miss
+  G4bool LoadCache(RoughnessCache &cache);
+  void WriteCache(const RoughnessCache &cache);
 
  private:
   // Control
   Logger fLogger;
   SurfaceGenerator fGenerator;
   G4MultiUnion *fRoughness{nullptr};
+  G4VSolid *fSolid{nullptr};  ///< fRoughness or SpikeLatticeSolid
   G4LogicalVolume *fLogicRoughness{nullptr};
   RoughnessHelperMessenger *fMessenger;
 
@@ -110,6 +165,7 @@ class RoughnessHelper {
   G4int fNySpike{0};
   G4int fNLayer{1};
   Describer::SpikeShape fSpikeform{Spikeform::StandardPyramid};
+  RoughnessSolid fSolidType{RoughnessSolid::MultiUnion};
 
   // Bulk
   G4double fDxBasis{0};
@@ -122,6 +178,12 @@ class RoughnessHelper {
   G4int fNxBoundary{100000};
   G4int fNyBoundary{100000};
   G4int fNzBoundary{100000};
+  G4int fVoxelThreads{0};
+  G4bool fAutoBoundary{false};
+  G4int fVoxelMemoryLimit{2048};  ///< MB
+
+  // Cache
+  G4String fCacheDir;
 };
 
 }  // namespace Surface
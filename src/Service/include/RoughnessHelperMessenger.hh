@@ -15,6 +15,7 @@
 class G4UIcommand;
 class G4UIdirectory;
 class G4UIcmdWithAString;
+class G4UIcmdWithABool;
 class G4UIcmdWithAnInteger;
 class G4UIcmdWithoutParameter;
 class G4UIcmdWithADoubleAndUnit;
@@ -60,8 +61,13 @@ class RoughnessHelperMessenger : public G4UImessenger {
   G4UIcmdWithAnInteger *fCmdSetBoundaryNx;
   G4UIcmdWithAnInteger *fCmdSetBoundaryNy;
   G4UIcmdWithAnInteger *fCmdSetBoundaryNz;
+  G4UIcmdWithABool *fCmdSetBoundaryAuto;
+  G4UIcmdWithAnInteger *fCmdSetVoxelMemoryLimit;
+  G4UIcmdWithAnInteger *fCmdSetVoxelThreads;
 
   G4UIcmdWithADoubleAndUnit *fCmdSetStepLimit;
+  G4UIcmdWithAString *fCmdSetSolid;
+  G4UIcmdWithAString *fCmdSetCacheDir;
 };
 }  // namespace Surface
 
@@ -0,0 +1,105 @@
+/**
+ * @brief Tabulated depth distribution for shifts of start points
+ * @author agent
+ * @date 2026-10-17
+ * @file ShiftTable.hh
+ */
+
+#ifndef SRC_SERVICE_INCLUDE_SHIFTTABLE_HH
+#define SRC_SERVICE_INCLUDE_SHIFTTABLE_HH
+
+#include <cfloat>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "G4Types.hh"
+#include "Service/include/AliasTable.hh"
+
+namespace Surface {
+/**
+ * @brief ShiftTable samples depths from a table of (depth [nm], counts)
+ * pairs, restricted to a range [min, max].
+ * @details Between two table points the density is linear in the counts, the
+ * bin between them has the weight of its mean counts. The range cuts the bins
+ * at its borders, the cut bins keep the linear density between the
+ * interpolated counts at the cuts. The cut bins are built once, whenever the
+ * table or the range changes. A draw selects a bin with an alias table and
+ * inverts the linear density of the bin, two random numbers and no rejection.
+ * If the range contains no probability, the full table is used.
+ * SampleWithin() restricts the draw further to a set of depth intervals, by
+ * inverting the cumulative distribution of the table.
+ */
+class ShiftTable {
+ public:
+  /// Depths [first, second] in Geant4 units
+  using Interval = std::pair<G4double, G4double>;
+
+  ShiftTable() = default;
+
+  /**
+   * @brief Reads lines "depth, counts" with depth in nm, replaces the table
+   * @return false if the file could not be opened
+   */
+  G4bool Load(const std::string &filename);
+  /// Limits of drawn depths, in Geant4 units
+  void SetRange(G4double min, G4double max);
+  inline void SetMin(const G4double min) { SetRange(min, fMax); }
+  inline void SetMax(const G4double max) { SetRange(fMin, max); }
+
+  /// Table has at least one bin with counts
+  inline G4bool IsReady() const { return !fSampler.IsEmpty(); }
+  /// Range cuts away all probability, the full table is sampled
+  inline G4bool IsRangeEmpty() const { return fRangeEmpty; }
+  /// Share of the table within the range
+  inline G4double GetRangeProbability() const { return fRangeProbability; }
+
+  /// Depth in Geant4 units, within the range
+  G4double Sample() const;
+  /**
+   * @brief Draws a depth within the range and one of the intervals, with one
+   * random number
+   * @param share probability of the intervals relative to the range
+   * @return false if the intervals hold no probability, depth is not set
+   */
+  G4bool SampleWithin(const std::vector<Interval> &intervals, G4double &depth,
+                      G4double &share) const;
+  /// Depths drawn by Sample(), the range cut to the table, Geant4 units
+  Interval GetSampledRange() const;
+
+  std::stringstream StreamInfo() const;
+
+ private:
+  /// Part of a table bin within the range, counts are linear in the depth
+  struct Bin {
+    G4double low;         ///< depth at lower end, nm
+    G4double width;       ///< nm
+    G4double weight;      ///< share of the bin times its mean counts
+    G4double countsLow;   ///< counts at lower end
+    G4double countsHigh;  ///< counts at upper end
+  };
+
+  void Build();
+  /// Cumulative probability of the full table at depth (nm)
+  G4double Cumulative(G4double depth) const;
+  /// Depth (nm) of a cumulative probability of the full table
+  G4double InverseCumulative(G4double probability) const;
+  /// Cuts the bins to [min, max] (nm)
+  /// @return sum of the bin weights
+  G4double BuildBins(G4double min, G4double max);
+
+ private:
+  std::vector<G4double> fDepth;   ///< nm
+  std::vector<G4double> fCounts;
+  std::vector<G4double> fPrefix;  ///< summed weights of the bins before i
+  std::vector<Bin> fBins;
+  AliasTable fSampler;
+  G4double fMin{0.};
+  G4double fMax{DBL_MAX};
+  G4double fRangeProbability{0.};  ///< share of the table within the range
+  G4bool fRangeEmpty{false};
+};
+}  // namespace Surface
+
+#endif  // SRC_SERVICE_INCLUDE_SHIFTTABLE_HH
@@ -9,17 +9,20 @@
 #define SRC_SERVICE_INCLUDE_VSAMPLER_HH
 
 #include <cstdlib>
+#include <iomanip>
 #include <sstream>
 #include <string>
 #include <vector>
 
 #include "Randomize.hh"
+#include "Service/include/AliasTable.hh"
 #include "Service/include/Logger.hh"
 
 namespace Surface {
 /**
  * @brief VSampler is a Template class for sampling elements T.
  * @details Elements T are stored in a vector and are sampled based on a second probability vector.
+ * Sampling uses an alias table and is O(1) per draw.
  * @tparam T is the element to sample
  */
 template <class T>
@@ -29,15 +32,11 @@ class VSampler {
     if (fIsClosed) {
       return;
     }
-    G4double counter{0};
-    for (G4double &val : fProbability) {
-      counter += val;
-    }
-    G4double prob{0};
-    for (G4double &val : fProbability) {
-      prob += val / counter;
-      val = prob;
+    if (fProbability.size() != fValues.size()) {
+      fLogger.WriteError("Number of values and probabilities differ");
+      exit(EXIT_FAILURE);
     }
+    fAliasTable.Build(fProbability);
     fIsClosed = true;
     PrintSampler();
   }
@@ -73,14 +72,7 @@ class VSampler {
     if (!fIsClosed) {
       PrepareProbability();
     }
-    G4double random = G4UniformRand();
-    for (size_t i = 0; i < fProbability.size(); ++i) {
-      if (random <= fProbability.at(i)) {
-        return fValues.at(i);
-      }
-    }
-    fLogger.WriteError("GetRandom() returned nothing!");
-    exit(EXIT_FAILURE);
+    return fValues[fAliasTable.Sample()];
   }
 
   void PrintSampler() const {
@@ -102,11 +94,9 @@ class VSampler {
     ss << "Sampler: " << fName << "\n";
     ss << "\n";
     ss << "Value Probability\n";
-    G4double previousProbability{0};
-    for (size_t i = 0; i < fProbability.size(); ++i) {
+    for (size_t i = 0; i < fAliasTable.Size(); ++i) {
       ss << fValues.at(i) << " " << std::setw(25) << std::setprecision(16)
-         << (fProbability.at(i) - previousProbability) * 100 << " %\n";
-      previousProbability = fProbability.at(i);
+         << fAliasTable.GetProbability(i) * 100 << " %\n";
     }
     ss << "\n";
     ss << "**************************************************\n";
@@ -114,8 +104,9 @@ class VSampler {
   }
 
  private:
-  std::vector<G4double> fProbability;
+  std::vector<G4double> fProbability;  ///< weights as appended
   std::vector<T> fValues;
+  AliasTable fAliasTable;
   G4bool fIsClosed;
   Logger fLogger;
   const G4String fName;
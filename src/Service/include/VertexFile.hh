@@ -0,0 +1,135 @@
+/**
+ * @brief Binary file of pre-generated primary vertices
+ * @author agent
+ * @date 2026-10-17
+ * @file VertexFile.hh
+ */
+
+#ifndef SRC_SERVICE_INCLUDE_VERTEXFILE_HH
+#define SRC_SERVICE_INCLUDE_VERTEXFILE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <vector>
+
+#include "G4String.hh"
+#include "G4Types.hh"
+
+namespace Surface {
+
+/**
+ * @brief One sampled vertex as stored in the file
+ * @details cellX, cellY are the subworld grid position of the vertex. Vertices
+ * of Surface::Source store the index of the placement in cellX and -1 in
+ * cellY.
+ */
+struct VertexRecord {
+  G4double position[3];
+  G4double normal[3];
+  std::int32_t cellX;
+  std::int32_t cellY;
+};
+
+static_assert(sizeof(VertexRecord) == 56, "VertexRecord must not be padded");
+
+/**
+ * @brief Writes vertices in blocks to a vertex file
+ * @details Layout, native byte order: char[8] "SC4VTXS", uint32 version,
+ * uint32 0x01020304, uint64 n records, VertexRecord[n].
+ * A full block is written by a background thread while the caller samples the
+ * next one. The file is written to a temporary file and renamed by Close(),
+ * readers never see a partial file.
+ */
+class VertexFileWriter {
+ public:
+  explicit VertexFileWriter(const G4String &filename,
+                            std::size_t blockSize = 1 << 14);
+  /// Removes the temporary file if Close() was not called
+  ~VertexFileWriter();
+  VertexFileWriter(const VertexFileWriter &) = delete;
+  VertexFileWriter &operator=(const VertexFileWriter &) = delete;
+
+  /// @return false if the temporary file could not be created
+  G4bool Open();
+  void Append(const VertexRecord &record);
+  /// @return false if a write failed, the file is not created then
+  G4bool Close();
+
+  inline std::uint64_t GetSize() const { return fSize; }
+
+ private:
+  void Flush();
+  void Wait();
+
+ private:
+  G4String fFilename;
+  G4String fTemporary;
+  std::size_t fBlockSize;
+  std::ofstream fOut;
+  std::vector<VertexRecord> fBlock;    ///< filled by Append()
+  std::vector<VertexRecord> fWriting;  ///< written in the background
+  std::future<void> fPending;
+  std::uint64_t fSize{0};
+  G4bool fOpen{false};
+};
+
+/**
+ * @brief Reads the records of a vertex file sequentially
+ * @details The next block is read by a background thread while the current
+ * one is consumed, Next() is a lookup in memory. The reader can be restricted
+ * to a range of records, so jobs sharing one file read disjoint shards. At the
+ * end of the range the reader starts over at its first record.
+ */
+class VertexFileReader {
+ public:
+  explicit VertexFileReader(std::size_t blockSize = 1 << 14);
+  ~VertexFileReader();
+  VertexFileReader(const VertexFileReader &) = delete;
+  VertexFileReader &operator=(const VertexFileReader &) = delete;
+
+  /**
+   * @brief Opens the file and checks its header, range is the full file
+   * @return false if the file is missing or not a vertex file
+   */
+  G4bool Open(const G4String &filename);
+  inline std::uint64_t GetSize() const { return fSize; }
+
+  /// Restricts reading to [first, first + count), clipped to the file
+  void SetRange(std::uint64_t first, std::uint64_t count);
+  /**
+   * @brief Restricts reading to shard index of count equal shards
+   * @details The first size % count shards hold one record more.
+   */
+  void SetShard(std::uint64_t index, std::uint64_t count);
+  inline std::uint64_t GetRangeBegin() const { return fRangeBegin; }
+  inline std::uint64_t GetRangeSize() const { return fRangeEnd - fRangeBegin; }
+
+  /// Next record, the range must not be empty
+  const VertexRecord &Next();
+  /// Number of times the range was started over
+  inline std::uint64_t GetRestarts() const { return fRestarts; }
+
+ private:
+  void ReadAhead();
+  void Wait();
+
+ private:
+  std::size_t fBlockSize;
+  std::ifstream fIn;
+  std::uint64_t fSize{0};
+  std::uint64_t fRangeBegin{0};
+  std::uint64_t fRangeEnd{0};
+  std::uint64_t fNextRead{0};  ///< first record of the next read
+  std::uint64_t fAheadFirst{0};  ///< first record of fAhead
+  std::uint64_t fRestarts{0};
+  G4bool fStarted{false};
+  std::vector<VertexRecord> fCurrent;  ///< consumed by Next()
+  std::vector<VertexRecord> fAhead;    ///< read in the background
+  std::size_t fIndex{0};
+  std::future<G4bool> fPending;
+};
+}  // namespace Surface
+
+#endif  // SRC_SERVICE_INCLUDE_VERTEXFILE_HH
@@ -0,0 +1,88 @@
+/**
+ * @brief Selects the voxel boundaries of a G4MultiUnion by measurement
+ * @author agent
+ * @date 2026-10-17
+ * @file VoxelTuner.hh
+ */
+
+#ifndef SRC_SERVICE_INCLUDE_VOXELTUNER_HH
+#define SRC_SERVICE_INCLUDE_VOXELTUNER_HH
+
+#include <cstddef>
+#include <sstream>
+#include <vector>
+
+#include "G4MultiUnion.hh"
+#include "G4ThreeVector.hh"
+#include "G4Types.hh"
+
+namespace Surface {
+
+class G4Voxelizer_Green;
+
+/**
+ * @brief VoxelTuner chooses the maximum number of voxel boundaries per axis
+ * (G4Voxelizer_Green::SetMaxBoundary) for a G4MultiUnion.
+ * @details Candidates start at the number of distinct node boundaries of an
+ * axis (no reduction) and are reduced by factors of 4. First x and y are
+ * reduced together, then z for the best xy setting. Every candidate whose
+ * predicted memory fits into the limit is voxelized and timed with a fixed
+ * batch of rays (Inside, DistanceToIn/Out with and without direction) drawn
+ * from a seeded generator, the random engine of Geant4 is not used.
+ * The fastest setting wins, among settings within 5 % of the fastest the one
+ * with least memory. The union is left voxelized with the chosen setting.
+ * The choice depends on wall-clock timing: identical jobs, e.g. on the nodes
+ * of a farm, can end up with different voxelizations. Pin the printed
+ * setting with SetMaxBoundary() where results must be reproducible.
+ */
+class VoxelTuner {
+ public:
+  struct Setting {
+    G4int maxBoundary[3];
+    std::size_t memory;  ///< bytes, measured after voxelization
+    G4double cost;       ///< ns per ray
+  };
+
+  /**
+   * @param memoryLimit bytes available for the voxel structure
+   * @param nRays number of rays per timing
+   */
+  VoxelTuner(G4MultiUnion *munion, std::size_t memoryLimit,
+             G4int nRays = 4096);
+
+  /**
+   * @brief Voxelizes and times all candidates
+   * @return chosen setting, the union is voxelized with it
+   */
+  Setting Tune();
+
+  /// Table of all measured settings
+  std::stringstream StreamInfo() const;
+
+ private:
+  struct Ray {
+    G4ThreeVector point;
+    G4ThreeVector direction;
+  };
+
+  void GenerateRays();
+  /// number of boundaries G4Voxelizer_Green keeps for n boundaries and max
+  static G4int KeptBoundaries(G4int n, G4int max);
+  /// memory of bitmasks and empty mask, lower limit of the memory needed
+  std::size_t PredictMemory(const G4int maxBoundary[3]) const;
+  /// voxelizes and times a setting if it fits into memoryLimit
+  void Evaluate(G4int maxX, G4int maxY, G4int maxZ, std::size_t memoryLimit);
+  G4double MeasureCost() const;
+  G4Voxelizer_Green &Voxelizer() const;
+
+ private:
+  G4MultiUnion *fUnion;
+  std::size_t fMemoryLimit;
+  G4int fNRays;
+  G4int fNatural[3]{0, 0, 0};  ///< distinct node boundaries per axis
+  std::vector<Ray> fRays;
+  std::vector<Setting> fMeasured;
+};
+}  // namespace Surface
+
+#endif  // SRC_SERVICE_INCLUDE_VOXELTUNER_HH
@@ -0,0 +1,86 @@
+/**
+ * @brief Implementation of AliasTable class
+ * @author agent
+ * @date 2026-10-17
+ * @file AliasTable.cc
+ */
+
+#include "Service/include/AliasTable.hh"
+
+#include <iomanip>
+
+#include "G4Exception.hh"
+
+void Surface::AliasTable::Build(const std::vector<G4double> &weights) {
+  const std::size_t size = weights.size();
+  G4double total{0};
+  for (const G4double weight : weights) {
+    if (weight < 0) {
+      G4Exception("AliasTable::Build()", "", FatalException,
+                  "Negative weight handed to alias table!");
+    }
+    total += weight;
+  }
+  if (size == 0 || total <= 0) {
+    G4Exception("AliasTable::Build()", "", FatalException,
+                "Sum of weights handed to alias table <= 0!");
+  }
+
+  fProbability.resize(size);
+  fThreshold.resize(size);
+  fAlias.resize(size);
+
+  // bins below and above the mean share
+  std::size_t mostLikely{0};
+  std::vector<std::size_t> small;
+  std::vector<std::size_t> large;
+  small.reserve(size);
+  large.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    fProbability[i] = weights[i] / total;
+    fThreshold[i] = fProbability[i] * static_cast<G4double>(size);
+    fAlias[i] = i;
+    if (weights[i] > weights[mostLikely]) {
+      mostLikely = i;
+    }
+    if (fThreshold[i] < 1.) {
+      small.push_back(i);
+    } else {
+      large.push_back(i);
+    }
+  }
+
+  while (!small.empty() && !large.empty()) {
+    const std::size_t less = small.back();
+    small.pop_back();
+    const std::size_t more = large.back();
+    fAlias[less] = more;
+    fThreshold[more] -= 1. - fThreshold[less];
+    if (fThreshold[more] < 1.) {
+      large.pop_back();
+      small.push_back(more);
+    }
+  }
+  // remaining bins are full up to rounding errors
+  for (const std::size_t i : large) {
+    fThreshold[i] = 1.;
+  }
+  for (const std::size_t i : small) {
+    if (fProbability[i] > 0) {
+      fThreshold[i] = 1.;
+    } else {
+      fAlias[i] = mostLikely;  // never return an empty bin
+    }
+  }
+}
+
+std::stringstream Surface::AliasTable::StreamInfo() const {
+  std::stringstream ss;
+  ss << "Bin Probability Threshold Alias\n";
+  for (std::size_t i = 0; i < fProbability.size(); ++i) {
+    ss << i << " " << std::setw(25) << std::setprecision(16)
+       << fProbability[i] * 100 << " % " << fThreshold[i] << " " << fAlias[i]
+       << "\n";
+  }
+  return ss;
+}
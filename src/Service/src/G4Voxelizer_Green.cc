@@ -32,10 +32,14 @@
 
 #include <G4ThreeVector.hh>
 #include <algorithm>
+#include <chrono>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <set>
 #include <sstream>
+#include <thread>
+#include <utility>
 
 #include "G4CSGSolid.hh"
 #include "G4GeometryTolerance.hh"
@@ -46,11 +50,41 @@
 #include "G4Types.hh"
 #include "G4VSolid.hh"
 #include "Randomize.hh"
+#include "Service/include/Logger.hh"
+#include "Service/include/ParallelFor.hh"
 #include "geomdefs.hh"
 
 using namespace std;
 
 G4ThreadLocal G4int Surface::G4Voxelizer_Green::fDefaultVoxelsCount = -1;
+G4ThreadLocal G4int Surface::G4Voxelizer_Green::fBuildThreads = 0;
+G4ThreadLocal Surface::VerboseLevel Surface::G4Voxelizer_Green::fVerbose =
+    Surface::VerboseLevel::Default;
+
+namespace {
+// Logs duration and memory of the build phases of the voxelizer
+class PhaseReport {
+ public:
+  explicit PhaseReport(const Surface::Logger &logger)
+      : fLogger(logger), fStart(std::chrono::steady_clock::now()) {}
+  void Print(const char *phase, const G4double bytes) {
+    const auto stop = std::chrono::steady_clock::now();
+    const std::chrono::duration<G4double, std::milli> duration = stop - fStart;
+    SCORE4_LOG_DETAIL(fLogger, [&] {
+      std::stringstream ss;
+      ss << "Voxelize " << std::setw(12) << std::left << phase << std::right
+         << std::setw(12) << duration.count() << " ms " << std::setw(12)
+         << bytes / 1e6 << " MB";
+      return ss.str();
+    });
+    fStart = stop;
+  }
+
+ private:
+  const Surface::Logger &fLogger;
+  std::chrono::steady_clock::time_point fStart;
+};
+}  // namespace
 
 //______________________________________________________________________________
 Surface::G4Voxelizer_Green::G4Voxelizer_Green()
@@ -69,11 +103,7 @@ Surface::G4Voxelizer_Green::~G4Voxelizer_Green() {}
 
 //______________________________________________________________________________
 void Surface::G4Voxelizer_Green::BuildEmpty() {
-  // by reserving the size of candidates, we would avoid reallocation of
-  // the vector which could cause fragmentation
-  //
-  std::vector<G4int> xyz(3), max(3), candidates(fTotalCandidates);
-  const std::vector<G4int> empty(0);
+  std::vector<G4int> max(3);
 
   for (auto i = 0; i <= 2; ++i) max[i] = fBoundaries[i].size();
   unsigned int size = max[0] * max[1] * max[2];
@@ -81,24 +111,41 @@ void Surface::G4Voxelizer_Green::BuildEmpty() {
   fEmpty.Clear();
   fEmpty.ResetBitNumber(size - 1);
   fEmpty.ResetAllBits(true);
-
-  for (xyz[2] = 0; xyz[2] < max[2]; ++xyz[2]) {
-    for (xyz[1] = 0; xyz[1] < max[1]; ++xyz[1]) {
-      for (xyz[0] = 0; xyz[0] < max[0]; ++xyz[0]) {
-        if (GetCandidatesVoxelArray(xyz, candidates)) {
-          G4int index = GetVoxelsIndex(xyz);
-          fEmpty.SetBitNumber(index, false);
-
-          // rather than assigning directly with:
-          // "fCandidates[index] = candidates;", in an effort to ensure that
-          // capacity would be just exact, we rather use following 3 lines
-          //
-          std::vector<G4int> &c = (fCandidates[index] = empty);
-          c.reserve(candidates.size());
-          c.assign(candidates.begin(), candidates.end());
+  fCandidates.clear();  // the structure may be voxelized more than once
+
+  // z slices are searched in parallel, each chunk collects its non-empty
+  // voxels in increasing index order, chunks are merged in order
+  const G4int threads = GetBuildThreads();
+  std::vector<std::vector<std::pair<G4int, std::vector<G4int>>>> found(
+      threads);
+  ParallelFor(max[2], threads, 1, [&](G4int chunk, G4int begin, G4int end) {
+    // by reserving the size of candidates, we would avoid reallocation of
+    // the vector which could cause fragmentation
+    //
+    std::vector<G4int> xyz(3), candidates(fTotalCandidates);
+    auto &voxels = found[chunk];
+    for (xyz[2] = begin; xyz[2] < end; ++xyz[2]) {
+      for (xyz[1] = 0; xyz[1] < max[1]; ++xyz[1]) {
+        for (xyz[0] = 0; xyz[0] < max[0]; ++xyz[0]) {
+          if (GetCandidatesVoxelArray(xyz, candidates)) {
+            // copy with exact capacity
+            voxels.emplace_back(GetVoxelsIndex(xyz), std::vector<G4int>());
+            std::vector<G4int> &c = voxels.back().second;
+            c.reserve(candidates.size());
+            c.assign(candidates.begin(), candidates.end());
+          }
         }
       }
     }
+  });
+
+  for (auto &voxels : found) {
+    for (auto &voxel : voxels) {
+      fEmpty.SetBitNumber(voxel.first, false);
+      fCandidates.emplace_hint(fCandidates.end(), voxel.first,
+                               std::move(voxel.second));
+    }
+    std::vector<std::pair<G4int, std::vector<G4int>>>().swap(voxels);
   }
 #ifdef G4SPECSDEBUG
   G4cout << "Non-empty voxels count: " << fCandidates.size() << G4endl;
@@ -108,10 +155,6 @@ void Surface::G4Voxelizer_Green::BuildEmpty() {
 //______________________________________________________________________________
 void Surface::G4Voxelizer_Green::BuildVoxelLimits(
     std::vector<G4VSolid *> &solids, std::vector<G4Transform3D> &transforms) {
-  G4Rotate3D rot;
-  G4Translate3D transl;
-  G4Scale3D scale;
-
   // "BuildVoxelLimits"'s aim is to store the coordinates of the origin as
   // well as the half lengths related to the bounding box of each node.
   // These quantities are stored in the array "fBoxes" (6 different values per
@@ -127,28 +170,35 @@ void Surface::G4Voxelizer_Green::BuildVoxelLimits(
 
     G4ThreeVector toleranceVector(fTolerance, fTolerance, fTolerance);
 
-    for (G4int i = 0; i < numNodes; ++i) {
-      G4VSolid &solid = *solids[i];
-      G4Transform3D transform = transforms[i];
-      G4ThreeVector min, max;
-
-      solid.BoundingLimits(min, max);
-      if (solid.GetEntityType() == "G4Orb") {
-        G4Orb &orb = *(G4Orb *)&solid;
-        G4ThreeVector orbToleranceVector;
-        G4double tolerance = orb.GetRadialTolerance() / 2.0;
-        orbToleranceVector.set(tolerance, tolerance, tolerance);
-        min -= orbToleranceVector;
-        max += orbToleranceVector;
-      } else {
-        min -= toleranceVector;
-        max += toleranceVector;
+    // nodes are independent, every thread fills its own range of fBoxes
+    ParallelFor(numNodes, GetBuildThreads(), 1,
+                [&](G4int, G4int begin, G4int end) {
+      G4Rotate3D rot;
+      G4Translate3D transl;
+      G4Scale3D scale;
+      for (G4int i = begin; i < end; ++i) {
+        G4VSolid &solid = *solids[i];
+        G4Transform3D transform = transforms[i];
+        G4ThreeVector min, max;
+
+        solid.BoundingLimits(min, max);
+        if (solid.GetEntityType() == "G4Orb") {
+          G4Orb &orb = *(G4Orb *)&solid;
+          G4ThreeVector orbToleranceVector;
+          G4double tolerance = orb.GetRadialTolerance() / 2.0;
+          orbToleranceVector.set(tolerance, tolerance, tolerance);
+          min -= orbToleranceVector;
+          max += orbToleranceVector;
+        } else {
+          min -= toleranceVector;
+          max += toleranceVector;
+        }
+        TransformLimits(min, max, transform);
+        fBoxes[i].hlen = (max - min) / 2;
+        transform.getDecomposition(scale, rot, transl);
+        fBoxes[i].pos = transl.getTranslation();
       }
-      TransformLimits(min, max, transform);
-      fBoxes[i].hlen = (max - min) / 2;
-      transform.getDecomposition(scale, rot, transl);
-      fBoxes[i].pos = transl.getTranslation();
-    }
+    });
     fTotalCandidates = fBoxes.size();
   }
 }
@@ -245,59 +295,62 @@ void Surface::G4Voxelizer_Green::BuildBoundaries() {
     const G4double tolerance = fTolerance / 100.0;
     // Minimal distance to discriminate two boundaries.
 
-    std::vector<G4double> sortedBoundary(2 * numNodes);
+    // the three axes are independent, one thread per axis
+    ParallelFor(3, GetBuildThreads(), 1, [&](G4int, G4int begin, G4int end) {
+      std::vector<G4double> sortedBoundary(2 * numNodes);
 
-    G4int considered;
+      G4int considered;
 
-    for (auto j = 0; j <= 2; ++j) {
-      CreateSortedBoundary(sortedBoundary, j);
-      std::vector<G4double> &boundary = fBoundaries[j];
-      boundary.clear();
+      for (auto j = begin; j < end; ++j) {
+        CreateSortedBoundary(sortedBoundary, j);
+        std::vector<G4double> &boundary = fBoundaries[j];
+        boundary.clear();
 
-      considered = 0;
+        considered = 0;
 
-      for (G4int i = 0; i < 2 * numNodes; ++i) {
-        G4double newBoundary = sortedBoundary[i];
+        for (G4int i = 0; i < 2 * numNodes; ++i) {
+          G4double newBoundary = sortedBoundary[i];
 #ifdef G4SPECSDEBUG
-        if (j == 0) G4cout << "Examining " << newBoundary << "..." << G4endl;
+          if (j == 0) G4cout << "Examining " << newBoundary << "..." << G4endl;
 #endif
-        G4int size = boundary.size();
-        if (!size || std::abs(boundary[size - 1] - newBoundary) > tolerance) {
-          considered++;
-          {
+          G4int size = boundary.size();
+          if (!size || std::abs(boundary[size - 1] - newBoundary) > tolerance) {
+            considered++;
+            {
 #ifdef G4SPECSDEBUG
-            if (j == 0)
-              G4cout << "Adding boundary " << newBoundary << "..." << G4endl;
+              if (j == 0)
+                G4cout << "Adding boundary " << newBoundary << "..." << G4endl;
 #endif
-            boundary.push_back(newBoundary);
-            continue;
+              boundary.push_back(newBoundary);
+              continue;
+            }
           }
+          // If two successive boundaries are too close from each other,
+          // only the first one is considered
         }
-        // If two successive boundaries are too close from each other,
-        // only the first one is considered
-      }
 
-      G4int n = boundary.size();
-      G4int max = fMaxBoundary[j];
-      if (n > max / 2) {
-        G4int skip = n / (max / 2);  // n has to be 2x bigger then 50.000.
-                                     // therefore only from 100.000 reduced
-        std::vector<G4double> reduced;
-        for (G4int i = 0; i < n; ++i) {
-          // 50 ok for 2k, 1000, 2000
-          G4int size = boundary.size();
-          if (i % skip == 0 || i == 0 || i == size - 1) {
-            // this condition of merging boundaries was wrong,
-            // it did not count with right part, which can be
-            // completely ommited and not included in final consideration.
-            // Now should be OK
-            //
-            reduced.push_back(boundary[i]);
+        G4int n = boundary.size();
+        G4int max = fMaxBoundary[j];
+        if (n > max / 2) {
+          G4int skip = n / (max / 2);  // n has to be 2x bigger then 50.000.
+                                       // therefore only from 100.000 reduced
+          std::vector<G4double> reduced;
+          for (G4int i = 0; i < n; ++i) {
+            // 50 ok for 2k, 1000, 2000
+            G4int size = boundary.size();
+            if (i % skip == 0 || i == 0 || i == size - 1) {
+              // this condition of merging boundaries was wrong,
+              // it did not count with right part, which can be
+              // completely ommited and not included in final consideration.
+              // Now should be OK
+              //
+              reduced.push_back(boundary[i]);
+            }
           }
+          boundary = reduced;
         }
-        boundary = reduced;
       }
-    }
+    });
   }
 }
 
@@ -357,31 +410,47 @@ void Surface::G4Voxelizer_Green::BuildBitmasks(
       candidatesCount[i] = 0;
     }
 
-    // Loop on the nodes, number of slices per axis
+    // Loop on the nodes, number of slices per axis. Node ranges start at
+    // multiples of 8, so every thread sets bits in its own bytes; counts are
+    // collected per thread and added in thread order.
     //
-    for (G4int j = 0; j < numNodes; ++j) {
-      // Determination of the minimum and maximum position along x
-      // of the bounding boxe of each node
-      //
-      G4double p = fBoxes[j].pos[k], d = fBoxes[j].hlen[k];
-
-      G4double min = p - d;  // - localTolerance;
-      G4double max = p + d;  // + localTolerance;
+    const G4int threads = GetBuildThreads();
+    std::vector<std::vector<G4int>> counts(threads);
+    std::vector<G4int> totals(threads, 0);
+    ParallelFor(numNodes, threads, 8,
+                [&](G4int chunk, G4int begin, G4int end) {
+      std::vector<G4int> &count = counts[chunk];
+      count.assign(voxelsCount, 0);
+      for (G4int j = begin; j < end; ++j) {
+        // Determination of the minimum and maximum position along x
+        // of the bounding boxe of each node
+        //
+        G4double p = fBoxes[j].pos[k], d = fBoxes[j].hlen[k];
 
-      G4int i = BinarySearch(boundary, min);
-      if (i < 0) {
-        i = 0;
-      }
+        G4double min = p - d;  // - localTolerance;
+        G4double max = p + d;  // + localTolerance;
 
-      do  // Loop checking, 13.08.2015, G.Cosmo
-      {
-        if (!countsOnly) {
-          bitmask.SetBitNumber(i * bitsPerSlice + j);
+        G4int i = BinarySearch(boundary, min);
+        if (i < 0) {
+          i = 0;
         }
-        candidatesCount[i]++;
-        ++total;
-        ++i;
-      } while (max > boundary[i] && i < voxelsCount);
+
+        do  // Loop checking, 13.08.2015, G.Cosmo
+        {
+          if (!countsOnly) {
+            bitmask.SetBitNumber(i * bitsPerSlice + j);
+          }
+          count[i]++;
+          ++totals[chunk];
+          ++i;
+        } while (max > boundary[i] && i < voxelsCount);
+      }
+    });
+    for (G4int chunk = 0; chunk < threads; ++chunk) {
+      for (std::size_t i = 0; i < counts[chunk].size(); ++i) {
+        candidatesCount[i] += counts[chunk][i];
+      }
+      total += totals[chunk];
     }
   }
 #ifdef G4SPECSDEBUG
@@ -661,18 +730,37 @@ void Surface::G4Voxelizer_Green::BuildReduceVoxels2(
 //______________________________________________________________________________
 void Surface::G4Voxelizer_Green::Voxelize(
     std::vector<G4VSolid *> &solids, std::vector<G4Transform3D> &transforms) {
-  G4cout << "Start VoxelLimits" << G4endl;
+  const Logger logger("G4Voxelizer_Green", fVerbose);
+  SCORE4_LOG_DETAIL(logger, [&] {
+    return "Voxelize " + std::to_string(solids.size()) + " nodes on " +
+           std::to_string(GetBuildThreads()) + " threads";
+  });
+  PhaseReport report(logger);
   BuildVoxelLimits(solids, transforms);
-  G4cout << "Start Boundaries" << G4endl;
+  report.Print("VoxelLimits", fBoxes.capacity() * sizeof(G4VoxelBox));
   BuildBoundaries();
-  G4cout << "Start Bitmasks" << G4endl;
+  report.Print("Boundaries",
+               sizeof(G4double) *
+                   (fBoundaries[0].capacity() + fBoundaries[1].capacity() +
+                    fBoundaries[2].capacity()));
   BuildBitmasks(fBoundaries, fBitmasks);
-  G4cout << "Start BoundingBox" << G4endl;
+  report.Print("Bitmasks",
+               fBitmasks[0].GetNbytes() + fBitmasks[1].GetNbytes() +
+                   fBitmasks[2].GetNbytes() +
+                   sizeof(G4int) * (fCandidatesCounts[0].capacity() +
+                                    fCandidatesCounts[1].capacity() +
+                                    fCandidatesCounts[2].capacity()));
   BuildBoundingBox();
-  G4cout << "Start Empty" << G4endl;
+  report.Print("BoundingBox", 0);
   BuildEmpty();  // this does not work well for multi-union,
                  // actually only makes performance slower,
                  // these are only pre-calculated but not used by multi-union
+  G4double candidatesBytes = fEmpty.GetNbytes();
+  for (const auto &candidates : fCandidates) {
+    candidatesBytes += sizeof(std::vector<G4int>) +
+                       candidates.second.capacity() * sizeof(G4int);
+  }
+  report.Print("Empty", candidatesBytes);
 
   for (auto i = 0; i < 3; ++i) {
     fCandidatesCounts[i].resize(0);
@@ -690,10 +778,34 @@ void Surface::G4Voxelizer_Green::Voxelize(G4MultiUnion *munion) {
     solids.push_back(munion->GetSolid(i));
     transform.push_back(munion->GetTransformation(i));
   }
-  G4cout << "Start Voxelize" << G4endl;
   Voxelize(solids, transform);
 }
 
+//______________________________________________________________________________
+void Surface::G4Voxelizer_Green::CountBoundaries(G4MultiUnion *munion,
+                                                 G4int counts[3]) {
+  G4int NSolids = munion->GetNumberOfSolids();
+  std::vector<G4VSolid *> solids;
+  solids.reserve(NSolids);
+  std::vector<G4Transform3D> transform;
+  transform.reserve(NSolids);
+  for (int i = 0; i < NSolids; ++i) {
+    solids.push_back(munion->GetSolid(i));
+    transform.push_back(munion->GetTransformation(i));
+  }
+  G4int maxBoundary[3];
+  for (auto i = 0; i <= 2; ++i) {
+    maxBoundary[i] = fMaxBoundary[i];
+    fMaxBoundary[i] = std::numeric_limits<G4int>::max();
+  }
+  BuildVoxelLimits(solids, transform);
+  BuildBoundaries();
+  for (auto i = 0; i <= 2; ++i) {
+    counts[i] = fBoundaries[i].size();
+    fMaxBoundary[i] = maxBoundary[i];
+  }
+}
+
 //______________________________________________________________________________
 void Surface::G4Voxelizer_Green::CreateMiniVoxels(
     std::vector<G4double> boundaries[], G4SurfBits bitmasks[]) {
@@ -1258,8 +1370,26 @@ G4int Surface::G4Voxelizer_Green::GetDefaultVoxelsCount() {
 }
 
 //______________________________________________________________________________
-G4int Surface::G4Voxelizer_Green::AllocatedMemory() {
-  G4int size = fEmpty.GetNbytes();
+void Surface::G4Voxelizer_Green::SetBuildThreads(G4int threads) {
+  fBuildThreads = threads;
+}
+
+//______________________________________________________________________________
+G4int Surface::G4Voxelizer_Green::GetBuildThreads() {
+  if (fBuildThreads > 0) {
+    return fBuildThreads;
+  }
+  return static_cast<G4int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+//______________________________________________________________________________
+void Surface::G4Voxelizer_Green::SetVerbose(const VerboseLevel level) {
+  fVerbose = level;
+}
+
+//______________________________________________________________________________
+std::size_t Surface::G4Voxelizer_Green::AllocatedMemory() const {
+  std::size_t size = fEmpty.GetNbytes();
   size += fBoxes.capacity() * sizeof(G4VoxelBox);
   size += sizeof(G4double) *
           (fBoundaries[0].capacity() + fBoundaries[1].capacity() +
@@ -1270,9 +1400,8 @@ G4int Surface::G4Voxelizer_Green::AllocatedMemory() {
   size += fBitmasks[0].GetNbytes() + fBitmasks[1].GetNbytes() +
           fBitmasks[2].GetNbytes();
 
-  G4int csize = fCandidates.size();
-  for (G4int i = 0; i < csize; ++i) {
-    size += sizeof(vector<G4int>) + fCandidates[i].capacity() * sizeof(G4int);
+  for (const auto &candidates : fCandidates) {
+    size += sizeof(candidates) + candidates.second.capacity() * sizeof(G4int);
   }
 
   return size;
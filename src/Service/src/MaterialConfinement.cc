@@ -0,0 +1,191 @@
+/**
+ * @brief Implementation of MaterialConfinement class
+ * @author agent
+ * @date 2026-10-17
+ * @file MaterialConfinement.cc
+ */
+
+#include "Service/include/MaterialConfinement.hh"
+
+#include <algorithm>
+#include <string>
+
+#include "G4Exception.hh"
+#include "G4GeometryTolerance.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4Navigator.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TransportationManager.hh"
+#include "G4VPhysicalVolume.hh"
+
+Surface::MaterialConfinement::MaterialConfinement() = default;
+
+Surface::MaterialConfinement::~MaterialConfinement() = default;
+
+void Surface::MaterialConfinement::SetMaterial(const G4String &materialName) {
+  fMaterialName = materialName;
+  fMaterial = nullptr;
+}
+
+const G4Material *Surface::MaterialConfinement::Material() {
+  if (fMaterial == nullptr) {
+    fMaterial = G4Material::GetMaterial(fMaterialName, false);
+    if (fMaterial == nullptr) {
+      G4Exception("MaterialConfinement::Material()", "", FatalException,
+                  ("Material for confinement not found: " + fMaterialName)
+                      .c_str());
+    }
+  }
+  return fMaterial;
+}
+
+G4Navigator *Surface::MaterialConfinement::Navigator() {
+  G4VPhysicalVolume *world = G4TransportationManager::GetTransportationManager()
+                                 ->GetNavigatorForTracking()
+                                 ->GetWorldVolume();
+  if (!fNavigator) {
+    fNavigator.reset(new G4Navigator());
+  }
+  if (fNavigator->GetWorldVolume() != world) {
+    fNavigator->SetWorldVolume(world);
+  }
+  return fNavigator.get();
+}
+
+G4bool Surface::MaterialConfinement::Contains(const G4ThreeVector &point) {
+  const G4VPhysicalVolume *physVol =
+      Navigator()->LocateGlobalPointAndSetup(point, nullptr, false, true);
+  return physVol != nullptr &&
+         physVol->GetLogicalVolume()->GetMaterial() == Material();
+}
+
+G4bool Surface::MaterialConfinement::Intervals(
+    const G4ThreeVector &position, const G4ThreeVector &direction,
+    const G4double low, const G4double high,
+    std::vector<ShiftTable::Interval> &intervals, G4int &locates) {
+  intervals.clear();
+  locates = 0;
+  const G4double push =
+      G4GeometryTolerance::GetInstance()->GetSurfaceTolerance();
+  G4Navigator *navigator = Navigator();
+  const G4Material *material = Material();
+  G4double depth = low;
+  for (G4int crossing = 0; depth < high; ++crossing) {
+    if (crossing == kMaxCrossings) {
+      return false;
+    }
+    // points on a boundary are located behind it
+    const G4ThreeVector point = position + (depth + push) * direction;
+    const G4VPhysicalVolume *physVol =
+        navigator->LocateGlobalPointAndSetup(point, &direction, false, false);
+    ++locates;
+    if (physVol == nullptr) {
+      break;  // left the world
+    }
+    G4double safety{0};
+    const G4double step =
+        navigator->ComputeStep(point, direction, high - depth, safety);
+    const G4double end = std::min(high, depth + push + std::max(0., step));
+    if (physVol->GetLogicalVolume()->GetMaterial() == material) {
+      if (!intervals.empty() && intervals.back().second >= depth) {
+        intervals.back().second = end;  // same material behind a boundary
+      } else {
+        intervals.emplace_back(depth, end);
+      }
+    }
+    depth = end;
+  }
+  return true;
+}
+
+G4double Surface::MaterialConfinement::SampleShift(
+    const ShiftTable &table, const G4ThreeVector &position,
+    const G4ThreeVector &direction, const Logger &logger) {
+  if (!IsActive()) {
+    const G4double depth = table.Sample();
+    SCORE4_LOG_DEBUG(logger, "Shift done: " + std::to_string(depth));
+    return depth;
+  }
+  G4double depth{0};
+  if (fMode == Mode::Boundary &&
+      SampleWithin(table, position, direction, logger, depth)) {
+    return depth;
+  }
+  return SampleByRejection(table, position, direction, logger);
+}
+
+G4bool Surface::MaterialConfinement::SampleWithin(
+    const ShiftTable &table, const G4ThreeVector &position,
+    const G4ThreeVector &direction, const Logger &logger, G4double &depth) {
+  const ShiftTable::Interval range = table.GetSampledRange();
+  G4int locates{0};
+  std::vector<ShiftTable::Interval> intervals;
+  if (!Intervals(position, -direction, range.first, range.second, intervals,
+                 locates)) {
+    logger.WriteWarning(
+        "More than " + std::to_string(kMaxCrossings) +
+        " boundaries along the shift direction, shift done by rejection");
+    return false;
+  }
+  G4double share{0};
+  G4double rejectionLocates{kMaxRejections};
+  if (table.SampleWithin(intervals, depth, share)) {
+    rejectionLocates = 1. / share;
+  } else {
+    logger.WriteError("No shift within material " + fMaterialName +
+                      ", shift done without confinement");
+    depth = table.Sample();
+  }
+  CountShift(locates, rejectionLocates);
+  const G4double saved =
+      std::min<G4double>(kMaxRejections, rejectionLocates) - locates;
+  SCORE4_LOG_DEBUG(logger, "Shift done: " + std::to_string(depth) +
+      ", locates: " + std::to_string(locates) +
+      ", locates saved: " + std::to_string(saved));
+  return true;
+}
+
+G4double Surface::MaterialConfinement::SampleByRejection(
+    const ShiftTable &table, const G4ThreeVector &position,
+    const G4ThreeVector &direction, const Logger &logger) {
+  // depths are always within [min, max], only the material is checked
+  for (G4int counter = 1;; ++counter) {
+    const G4double depth = table.Sample();
+    if (counter > kMaxRejections) {
+      logger.WriteError(
+          "Counter of ShiftTable > 10,000! Now performing shift "
+          "with value outside material " + fMaterialName);
+      CountShift(counter - 1, counter - 1);
+      return depth;
+    }
+    if (Contains(position - direction * depth)) {
+      CountShift(counter, counter);
+      SCORE4_LOG_DEBUG(logger, "Shift done: " + std::to_string(depth));
+      return depth;
+    }
+  }
+}
+
+void Surface::MaterialConfinement::CountShift(const G4int locates,
+                                              const G4double rejectionLocates) {
+  ++fShifts;
+  fLocates += locates;
+  fRejectionLocates +=
+      std::min<G4double>(kMaxRejections, rejectionLocates);
+}
+
+std::stringstream Surface::MaterialConfinement::StreamStatistics() const {
+  std::stringstream ss;
+  ss << "Confinement to material: " << fMaterialName << ", mode: "
+     << (fMode == Mode::Boundary ? "boundary" : "rejection") << "\n";
+  ss << "Shifts: " << fShifts << "\n";
+  if (fShifts > 0) {
+    ss << "Locates per shift: " << fLocates / fShifts << "\n";
+    ss << "Expected locates per shift with rejection: "
+       << fRejectionLocates / fShifts << "\n";
+    ss << "Locates saved per shift: "
+       << (fRejectionLocates - fLocates) / fShifts << "\n";
+  }
+  return ss;
+}
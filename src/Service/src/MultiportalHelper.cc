@@ -18,6 +18,7 @@
 #include "Portal/include/SubworldGrid.hh"
 #include "Service/include/Locator.hh"
 #include "Service/include/MultiportalHelperMessenger.hh"
+#include "Service/include/Profiler.hh"
 
 Surface::MultiportalHelper::MultiportalHelper(const G4String &helperName,
                                               const VerboseLevel verboseLvl)
@@ -36,6 +37,7 @@ Surface::MultiportalHelper::MultiportalHelper(const G4String &helperName,
       fDz(0),
       fNx(0),
       fNy(0),
+      fGridStorage(GridStorage::Dense),
       fPortal(nullptr) {}
 
 void Surface::MultiportalHelper::CheckValues() const {
@@ -158,7 +160,7 @@ void Surface::MultiportalHelper::GeneratePortal() {
   fPortal->SetTrigger(physPortal);
   fPortal->SetAsPortal();
   fPortal->SetSubworldEdge(2 * fDxSub, 2 * fDySub, 2 * fDzSub);
-  fPortal->SetGrid(fNx, fNy);
+  fPortal->SetGrid(fNx, fNy, VerboseLevel::Default, fGridStorage);
 
   Surface::PortalStore &portalStore = Surface::Locator::GetPortalStore();
 
@@ -188,6 +190,7 @@ void Surface::MultiportalHelper::FillSubworldMap() const {
 }
 
 void Surface::MultiportalHelper::Generate() {
+  SCORE4_PROFILE_SCOPE("MultiportalHelper::Generate");
   // Do a check of all sizes and information, if needed calculate missing
   // parts
   CheckValues();
@@ -201,6 +204,8 @@ void Surface::MultiportalHelper::Generate() {
   FillSubworldMap();
 
   AddRoughness();
+  // freeze trigger lookup for stepping
+  Surface::Locator::GetPortalStore().BuildTriggerIndex();
   fLogger.WriteInfo("Generated Portal with Subworlds");
 
   fLogger.WriteDetailInfo([this] {return InfoString();});
@@ -254,6 +259,23 @@ void Surface::MultiportalHelper::SetNDifferentSubworlds(const G4int val) {
   fNOfDifferentSubworlds = val;
 }
 
+void Surface::MultiportalHelper::SetGridStorage(const GridStorage storage) {
+  fGridStorage = storage;
+}
+
+void Surface::MultiportalHelper::SetGridStorage(const G4String &storageName) {
+  if (storageName == "Dense") {
+    fGridStorage = GridStorage::Dense;
+  } else if (storageName == "Indexed") {
+    fGridStorage = GridStorage::Indexed;
+  } else if (storageName == "Hashed") {
+    fGridStorage = GridStorage::Hashed;
+  } else {
+    fLogger.WriteError("Unknown grid storage: " + storageName);
+    exit(EXIT_FAILURE);
+  }
+}
+
 Surface::MultipleSubworld *Surface::MultiportalHelper::GetSubworld(
     const G4int id) const {
   return fMultipleSubworld.at(id);
@@ -355,6 +377,8 @@ void Surface::MultiportalHelper::AddRoughness() {
         trafo.getTranslation();
     const G4Transform3D trafoRoughness = fPlacementSub.at(id) * trafo;
     fFacetStore.at(id)->SetTransformation(trafoRoughness);
+    // close on master, worker threads only read from the store
+    fFacetStore.at(id)->CloseFacetStore();
 
     G4cout << "TestTest Roughness "
            << fMultipleSubworld.at(id)->GetVolume()->GetTranslation() << G4endl;
@@ -372,8 +396,20 @@ void Surface::MultiportalHelper::AddRoughness(G4LogicalVolume *vol,
 
 void Surface::MultiportalHelper::SetVerbose(const G4int verboseLvl) {
   fLogger.SetVerboseLvl(verboseLvl);
+  SetPortalVerbose();
 }
 
 void Surface::MultiportalHelper::SetVerbose(const Surface::VerboseLevel verboseLvl) {
   fLogger.SetVerboseLvl(verboseLvl);
+  SetPortalVerbose();
+}
+
+void Surface::MultiportalHelper::SetPortalVerbose() {
+  // portals are shared by all threads, only changed from the master
+  if (fPortal != nullptr) {
+    fPortal->SetVerbose(fLogger.GetVerboseLvl());
+  }
+  for (auto *subworld : fMultipleSubworld) {
+    subworld->SetVerbose(fLogger.GetVerboseLvl());
+  }
 }
\ No newline at end of file
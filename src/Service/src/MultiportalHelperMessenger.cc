@@ -85,6 +85,16 @@ Surface::MultiportalHelperMessenger::MultiportalHelperMessenger(
   fCmdSetNySubworld->AvailableForStates(G4State_PreInit, G4State_Init,
                                         G4State_Idle);
   fCmdSetNySubworld->SetGuidance("Set number of subworlds in y direction");
+
+  const G4String cmdSetGridStorage = ctrlPath + "setGridStorage";
+  fCmdSetGridStorage = new G4UIcmdWithAString(cmdSetGridStorage, this);
+  fCmdSetGridStorage->AvailableForStates(G4State_PreInit, G4State_Init,
+                                         G4State_Idle);
+  fCmdSetGridStorage->SetGuidance(
+      "Set storage of subworld grid. Dense: pointer per cell, Indexed: one "
+      "byte per cell, Hashed: layout derived on demand");
+  fCmdSetGridStorage->SetCandidates("Dense Indexed Hashed");
+  fCmdSetGridStorage->SetDefaultValue("Dense");
 }
 
 Surface::MultiportalHelperMessenger::~MultiportalHelperMessenger() {
@@ -119,6 +129,9 @@ Surface::MultiportalHelperMessenger::~MultiportalHelperMessenger() {
   fCmdSetNxSubworld = nullptr;
   delete fCmdSetNySubworld;
   fCmdSetNySubworld = nullptr;
+
+  delete fCmdSetGridStorage;
+  fCmdSetGridStorage = nullptr;
 }
 
 void Surface::MultiportalHelperMessenger::SetNewValue(G4UIcommand* command,
@@ -143,5 +156,7 @@ void Surface::MultiportalHelperMessenger::SetNewValue(G4UIcommand* command,
     fSource->SetNxSub(G4UIcmdWithAnInteger::GetNewIntValue(newValues));
   } else if (command == fCmdSetNySubworld) {
     fSource->SetNySub(G4UIcmdWithAnInteger::GetNewIntValue(newValues));
+  } else if (command == fCmdSetGridStorage) {
+    fSource->SetGridStorage(newValues);
   }
 }
\ No newline at end of file
@@ -0,0 +1,206 @@
+/**
+ * @brief Implementation of class Profiler
+ * @author agent
+ * @date 2026-10-17
+ * @file Profiler.cc
+ */
+
+#include "Service/include/Profiler.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#include "Service/include/ProfilerMessenger.hh"
+
+std::atomic<G4bool> Surface::Profiler::fEnabled{true};
+std::atomic<G4long> Surface::Profiler::fSampling{1};
+std::atomic<std::size_t> Surface::Profiler::fTraceLimit{100000};
+G4ThreadLocal Surface::Profiler *Surface::Profiler::fLocal = nullptr;
+
+namespace {
+std::mutex &RegistryMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+/// counters of all threads, kept after a thread ends
+std::vector<std::unique_ptr<Surface::Profiler>> &Threads() {
+  static std::vector<std::unique_ptr<Surface::Profiler>> threads;
+  return threads;
+}
+
+std::vector<G4String> &ScopeNames() {
+  static std::vector<G4String> names;
+  return names;
+}
+
+/// start of the wall clock and of the trace
+Surface::Profiler::Clock::time_point &Origin() {
+  static Surface::Profiler::Clock::time_point origin =
+      Surface::Profiler::Clock::now();
+  return origin;
+}
+
+G4double Microseconds(const Surface::Profiler::Clock::duration time) {
+  return std::chrono::duration<G4double, std::micro>(time).count();
+}
+
+std::string JsonString(const G4String &text) {
+  std::string escaped;
+  for (const char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return "\"" + escaped + "\"";
+}
+}  // namespace
+
+G4int Surface::Profiler::Register(const G4String &name) {
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  // created with the first scope. Not deleted, the UI manager may be gone at
+  // the end of the program.
+  static ProfilerMessenger *messenger = new ProfilerMessenger;
+  (void)messenger;
+  Origin();
+  ScopeNames().push_back(name);
+  return static_cast<G4int>(ScopeNames().size() - 1);
+}
+
+Surface::Profiler *Surface::Profiler::Create() {
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  Threads().emplace_back(new Profiler);
+  Threads().back()->fThreadId = G4Threading::G4GetThreadId();
+  return Threads().back().get();
+}
+
+void Surface::Profiler::SetEnabled(const G4bool enable) {
+  fEnabled.store(enable, std::memory_order_relaxed);
+}
+
+void Surface::Profiler::SetSampling(const G4long every) {
+  fSampling.store(std::max(every, G4long{1}), std::memory_order_relaxed);
+}
+
+void Surface::Profiler::SetTraceLimit(const std::size_t events) {
+  fTraceLimit.store(events, std::memory_order_relaxed);
+}
+
+void Surface::Profiler::End(const G4int id, const Clock::time_point start,
+                            const Clock::time_point stop) {
+  Counter &counter = Get(id);
+  ++counter.timedCalls;
+  counter.time += stop - start;
+  if (fTrace.size() < fTraceLimit.load(std::memory_order_relaxed)) {
+    fTrace.push_back(TraceEvent{id, start, stop - start});
+  } else {
+    ++fDropped;
+  }
+}
+
+void Surface::Profiler::Reset() {
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  for (const auto &thread : Threads()) {
+    thread->fCounters.clear();
+    thread->fTrace.clear();
+    thread->fDropped = 0;
+  }
+  Origin() = Clock::now();
+}
+
+std::string Surface::Profiler::Report() {
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  const Clock::duration wall = Clock::now() - Origin();
+  std::vector<G4long> calls(ScopeNames().size(), 0);
+  std::vector<G4double> seconds(ScopeNames().size(), 0.);
+  G4long dropped{0};
+  for (const auto &thread : Threads()) {
+    for (std::size_t id = 0; id < thread->fCounters.size(); ++id) {
+      const Counter &counter = thread->fCounters[id];
+      calls[id] += counter.calls;
+      // extrapolated per thread, the sampling counts the calls per thread
+      if (counter.timedCalls > 0) {
+        seconds[id] += std::chrono::duration<G4double>(counter.time).count() *
+                       static_cast<G4double>(counter.calls) /
+                       static_cast<G4double>(counter.timedCalls);
+      }
+    }
+    dropped += thread->fDropped;
+  }
+  std::vector<std::size_t> order(calls.size());
+  for (std::size_t id = 0; id < order.size(); ++id) {
+    order[id] = id;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&seconds](const std::size_t a, const std::size_t b) {
+                     return seconds[a] > seconds[b];
+                   });
+
+  const G4double wallSeconds = std::chrono::duration<G4double>(wall).count();
+  std::stringstream ss;
+  ss << "\n";
+  ss << "**************************************************\n";
+  ss << "*               Information Profiler             *\n";
+  ss << "**************************************************\n";
+  ss << "Wall time " << wallSeconds << " s, " << Threads().size()
+     << " threads, timing every " << fSampling.load() << ". call\n";
+  ss << "Times are inclusive and summed over threads\n";
+  ss << std::setw(36) << std::left << "Scope" << std::right << std::setw(12)
+     << "calls" << std::setw(12) << "total [s]" << std::setw(12)
+     << "mean [us]" << std::setw(9) << "% wall" << "\n";
+  for (const std::size_t id : order) {
+    if (calls[id] == 0) {
+      continue;
+    }
+    ss << std::setw(36) << std::left << ScopeNames().at(id) << std::right
+       << std::setw(12) << calls[id] << std::setw(12) << seconds[id]
+       << std::setw(12)
+       << 1e6 * seconds[id] / static_cast<G4double>(calls[id]) << std::setw(9)
+       << std::fixed << std::setprecision(1)
+       << (wallSeconds > 0. ? 100. * seconds[id] / wallSeconds : 0.)
+       << std::defaultfloat << std::setprecision(6) << "\n";
+  }
+  if (dropped > 0) {
+    ss << dropped << " timed calls not in the trace, limit "
+       << fTraceLimit.load() << " events per thread\n";
+  }
+  ss << "**************************************************\n";
+  return ss.str();
+}
+
+std::string Surface::Profiler::Trace() {
+  std::lock_guard<std::mutex> lock(RegistryMutex());
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3);
+  ss << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  G4bool first{true};
+  for (std::size_t tid = 0; tid < Threads().size(); ++tid) {
+    const Profiler &thread = *Threads()[tid];
+    const std::string name = thread.fThreadId < 0
+                                 ? std::string("master")
+                                 : "G4WT" + std::to_string(thread.fThreadId);
+    ss << (first ? "\n" : ",\n")
+       << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+       << tid << ", \"args\": {\"name\": \"" << name << "\"}}";
+    first = false;
+    for (const TraceEvent &event : thread.fTrace) {
+      ss << ",\n{\"name\": " << JsonString(ScopeNames().at(event.id))
+         << ", \"cat\": \"score4\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << tid
+         << ", \"ts\": " << Microseconds(event.start - Origin())
+         << ", \"dur\": " << Microseconds(event.duration) << "}";
+    }
+  }
+  ss << "\n]}\n";
+  return ss.str();
+}
+
+G4bool Surface::Profiler::WriteTrace(const G4String &filename) {
+  std::ofstream file(filename, std::ios::trunc);
+  file << Trace();
+  return static_cast<G4bool>(file);
+}
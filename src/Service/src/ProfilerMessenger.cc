@@ -0,0 +1,127 @@
+/**
+ * @brief Implementation of ProfilerMessenger class
+ * @author agent
+ * @date 2026-10-17
+ * @file ProfilerMessenger.cc
+ */
+
+#include "Service/include/ProfilerMessenger.hh"
+
+#include "G4ApplicationState.hh"
+#include "G4StateManager.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "Service/include/Logger.hh"
+#include "Service/include/Profiler.hh"
+
+Surface::ProfilerMessenger::ProfilerMessenger() {
+  fDirectory = new G4UIdirectory("/Surface/");
+  fDirectory->SetGuidance("Controls the Surface library.");
+  fSubDirectory = new G4UIdirectory("/Surface/Profiler/");
+  fSubDirectory->SetGuidance("Scoped timers of the hot paths.");
+
+  fCmdEnable = new G4UIcmdWithABool("/Surface/Profiler/enable", this);
+  fCmdEnable->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+  fCmdEnable->SetGuidance("Enable or disable timing of all scopes");
+  fCmdEnable->SetParameterName("enable", true);
+  fCmdEnable->SetDefaultValue(true);
+  fCmdEnable->SetToBeBroadcasted(false);
+
+  fCmdSetSampling =
+      new G4UIcmdWithAnInteger("/Surface/Profiler/setSampling", this);
+  fCmdSetSampling->AvailableForStates(G4State_PreInit, G4State_Init,
+                                      G4State_Idle);
+  fCmdSetSampling->SetGuidance(
+      "Time every n-th call of a scope, all calls are counted and the total "
+      "time is extrapolated");
+  fCmdSetSampling->SetParameterName("n", false);
+  fCmdSetSampling->SetRange("n >= 1");
+  fCmdSetSampling->SetToBeBroadcasted(false);
+
+  fCmdSetTraceLimit =
+      new G4UIcmdWithAnInteger("/Surface/Profiler/setTraceLimit", this);
+  fCmdSetTraceLimit->AvailableForStates(G4State_PreInit, G4State_Init,
+                                        G4State_Idle);
+  fCmdSetTraceLimit->SetGuidance(
+      "Number of timed calls kept per thread for the trace, 0 disables the "
+      "trace");
+  fCmdSetTraceLimit->SetParameterName("events", false);
+  fCmdSetTraceLimit->SetRange("events >= 0");
+  fCmdSetTraceLimit->SetToBeBroadcasted(false);
+
+  fCmdSetTraceFile =
+      new G4UIcmdWithAString("/Surface/Profiler/setTraceFile", this);
+  fCmdSetTraceFile->AvailableForStates(G4State_PreInit, G4State_Init,
+                                       G4State_Idle);
+  fCmdSetTraceFile->SetGuidance(
+      "Write the timed calls in the Chrome trace format to this file at the "
+      "end of every run, an empty name disables writing");
+  fCmdSetTraceFile->SetParameterName("filename", true);
+  fCmdSetTraceFile->SetDefaultValue("");
+  fCmdSetTraceFile->SetToBeBroadcasted(false);
+
+  fCmdPrint = new G4UIcmdWithoutParameter("/Surface/Profiler/print", this);
+  fCmdPrint->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+  fCmdPrint->SetGuidance(
+      "Print calls, total and mean time and percentage of wall time of all "
+      "scopes");
+  fCmdPrint->SetToBeBroadcasted(false);
+
+  fCmdReset = new G4UIcmdWithoutParameter("/Surface/Profiler/reset", this);
+  fCmdReset->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+  fCmdReset->SetGuidance("Clear all timers and restart the wall clock");
+  fCmdReset->SetToBeBroadcasted(false);
+
+  fState = G4StateManager::GetStateManager()->GetCurrentState();
+  G4StateManager::GetStateManager()->RegisterDependent(this);
+}
+
+Surface::ProfilerMessenger::~ProfilerMessenger() {
+  G4StateManager::GetStateManager()->DeregisterDependent(this);
+  delete fCmdReset;
+  delete fCmdPrint;
+  delete fCmdSetTraceFile;
+  delete fCmdSetTraceLimit;
+  delete fCmdSetSampling;
+  delete fCmdEnable;
+  delete fSubDirectory;
+  delete fDirectory;
+}
+
+void Surface::ProfilerMessenger::SetNewValue(G4UIcommand *command,
+                                             G4String newValues) {
+  if (command == fCmdEnable) {
+    Profiler::SetEnabled(G4UIcmdWithABool::GetNewBoolValue(newValues));
+  } else if (command == fCmdSetSampling) {
+    Profiler::SetSampling(G4UIcmdWithAnInteger::GetNewIntValue(newValues));
+  } else if (command == fCmdSetTraceLimit) {
+    Profiler::SetTraceLimit(static_cast<std::size_t>(
+        G4UIcmdWithAnInteger::GetNewIntValue(newValues)));
+  } else if (command == fCmdSetTraceFile) {
+    fFilename = newValues;
+  } else if (command == fCmdPrint) {
+    Logger("Profiler").WriteAlways(Profiler::Report());
+  } else if (command == fCmdReset) {
+    Profiler::Reset();
+  }
+}
+
+G4bool Surface::ProfilerMessenger::Notify(
+    const G4ApplicationState requestedState) {
+  const G4ApplicationState previousState = fState;
+  fState = requestedState;
+  if (previousState != G4State_GeomClosed || requestedState != G4State_Idle ||
+      !Profiler::IsEnabled()) {
+    return true;
+  }
+  const Logger logger("Profiler");
+  logger.WriteAlways(Profiler::Report());
+  if (!fFilename.empty() && !Profiler::WriteTrace(fFilename)) {
+    logger.WriteError("Cannot write profiler trace to " + fFilename);
+  }
+  return true;
+}
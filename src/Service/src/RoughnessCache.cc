@@ -0,0 +1,400 @@
+/**
+ * @brief Implementation of RoughnessCache class
+ * @author agent
+ * @date 2026-10-17
+ * @file RoughnessCache.cc
+ */
+
+#include "Service/include/RoughnessCache.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "G4RotationMatrix.hh"
+#include "G4ThreeVector.hh"
+#include "G4Transform3D.hh"
+#include "Service/include/G4Voxelizer_Green.hh"
+#include "SurfaceGenerator/include/FacetStore.hh"
+
+namespace {
+constexpr char kMagic[8] = "SC4RGHC";
+constexpr std::uint32_t kVersion{2};
+constexpr std::uint32_t kByteOrder{0x01020304};
+
+/// FNV-1a, only used to name the file, the key itself is compared on load
+std::uint64_t HashKey(const std::string &key) {
+  std::uint64_t hash{14695981039346656037ULL};
+  for (const unsigned char c : key) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+void CreateDirectories(const std::string &path) {
+  for (std::size_t pos = path.find('/', 1); pos != std::string::npos;
+       pos = path.find('/', pos + 1)) {
+    mkdir(path.substr(0, pos).c_str(), 0755);
+  }
+  mkdir(path.c_str(), 0755);
+}
+
+std::size_t BitmaskBytes(const std::uint32_t nBits) {
+  return (static_cast<std::size_t>(nBits) + 7) / 8;
+}
+}  // namespace
+
+/**
+ * @brief Bounds checked sequential read of the mapped file
+ */
+class Surface::RoughnessCache::Reader {
+ public:
+  Reader(const unsigned char *begin, const unsigned char *end)
+      : fPos(begin), fEnd(end) {}
+
+  inline const unsigned char *Position() const { return fPos; }
+  inline G4bool AtEnd() const { return fPos == fEnd; }
+
+  /// Skips n items of given size, false if the file is too short
+  G4bool Skip(const std::uint64_t n, const std::size_t size = 1) {
+    if (n > static_cast<std::uint64_t>(fEnd - fPos) / size) {
+      return false;
+    }
+    fPos += n * size;
+    return true;
+  }
+
+  template <class T>
+  G4bool Read(T &value) {
+    return ReadArray(&value, 1);
+  }
+
+  template <class T>
+  G4bool ReadArray(T *values, const std::uint64_t n) {
+    const unsigned char *begin = fPos;
+    if (!Skip(n, sizeof(T))) {
+      return false;
+    }
+    if (n > 0) {
+      std::memcpy(values, begin, n * sizeof(T));
+    }
+    return true;
+  }
+
+ private:
+  const unsigned char *fPos;
+  const unsigned char *fEnd;
+};
+
+class Surface::RoughnessCache::Writer {
+ public:
+  explicit Writer(std::ofstream &out) : fOut(out) {}
+
+  template <class T>
+  void Write(const T &value) {
+    WriteArray(&value, 1);
+  }
+
+  template <class T>
+  void WriteArray(const T *values, const std::size_t n) {
+    fOut.write(reinterpret_cast<const char *>(values), n * sizeof(T));
+  }
+
+ private:
+  std::ofstream &fOut;
+};
+
+Surface::RoughnessCache::RoughnessCache(const G4String &directory,
+                                        const std::string &key)
+    : fKey(key) {
+  std::stringstream ss;
+  ss << directory << "/roughness_" << std::hex << std::setw(16)
+     << std::setfill('0') << HashKey(key) << ".cache";
+  fFilename = ss.str();
+}
+
+Surface::RoughnessCache::~RoughnessCache() { Close(); }
+
+void Surface::RoughnessCache::Close() {
+  if (fData != nullptr) {
+    munmap(const_cast<unsigned char *>(fData), fSize);
+  }
+  fData = nullptr;
+  fSize = 0;
+}
+
+G4bool Surface::RoughnessCache::Open() {
+  Close();
+  const int descriptor = open(fFilename.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    return false;
+  }
+  struct stat status {};
+  if (fstat(descriptor, &status) != 0 || status.st_size <= 0) {
+    close(descriptor);
+    return false;
+  }
+  fSize = static_cast<std::size_t>(status.st_size);
+  void *mapped = mmap(nullptr, fSize, PROT_READ, MAP_PRIVATE, descriptor, 0);
+  close(descriptor);  // mapping stays valid
+  if (mapped == MAP_FAILED) {
+    fSize = 0;
+    return false;
+  }
+  fData = static_cast<const unsigned char *>(mapped);
+  madvise(mapped, fSize, MADV_SEQUENTIAL);
+
+  Reader reader(fData, fData + fSize);
+  char magic[8];
+  std::uint32_t version{0};
+  std::uint32_t byteOrder{0};
+  std::uint64_t keySize{0};
+  std::uint64_t stateSize{0};
+  G4bool valid = reader.ReadArray(magic, 8) &&
+                 std::memcmp(magic, kMagic, sizeof(kMagic)) == 0 &&
+                 reader.Read(version) && version == kVersion &&
+                 reader.Read(byteOrder) && byteOrder == kByteOrder &&
+                 reader.Read(keySize) && keySize == fKey.size();
+  const unsigned char *key = reader.Position();
+  valid = valid && reader.Skip(keySize) &&
+          std::memcmp(key, fKey.data(), fKey.size()) == 0 &&
+          reader.Read(stateSize);
+  if (valid) {
+    const unsigned char *state = reader.Position();
+    valid = reader.Skip(stateSize);
+    if (valid) {
+      fEngineState.assign(reinterpret_cast<const char *>(state), stateSize);
+    }
+  }
+
+  valid = valid && reader.Read(fNDescriptions);
+  fDescriptions = reader.Position();
+  for (std::uint64_t i = 0; valid && i < fNDescriptions; ++i) {
+    valid = SkipDescription(reader);
+  }
+  valid = valid && reader.Read(fNFacets);
+  fFacets = reader.Position();
+  valid = valid && reader.Skip(fNFacets, 9 * sizeof(G4double));
+  fVoxels = reader.Position();
+  valid = valid && SkipVoxels(reader) && reader.AtEnd();
+  if (!valid) {
+    Close();
+  }
+  return valid;
+}
+
+G4bool Surface::RoughnessCache::SkipDescription(Reader &reader) {
+  std::uint32_t type{0};
+  std::uint32_t nParameter{0};
+  std::uint32_t nOuter{0};
+  return reader.Read(type) &&
+         type <= static_cast<std::uint32_t>(SolidDescription::Solid::Trd) &&
+         reader.Read(nParameter) && reader.Read(nOuter) &&
+         reader.Skip(12 + static_cast<std::uint64_t>(nParameter),
+                     sizeof(G4double)) &&
+         reader.Skip(nOuter, sizeof(std::int32_t));
+}
+
+G4bool Surface::RoughnessCache::SkipVoxels(Reader &reader) {
+  std::uint64_t n{0};
+  std::uint32_t nBits{0};
+  G4bool valid = reader.Read(n) && reader.Skip(n, 6 * sizeof(G4double)) &&
+                 reader.Skip(5, sizeof(std::int32_t));
+  for (auto axis = 0; valid && axis <= 2; ++axis) {
+    valid = reader.Read(n) && n > 0 && reader.Skip(n, sizeof(G4double));
+  }
+  for (auto i = 0; valid && i <= 3; ++i) {  // 3 bitmasks and empty
+    valid = reader.Read(nBits) && reader.Skip(BitmaskBytes(nBits));
+  }
+  std::uint64_t nLists{0};
+  valid = valid && reader.Read(nLists);
+  for (std::uint64_t i = 0; valid && i < nLists; ++i) {
+    valid = reader.Skip(1, sizeof(std::int32_t)) && reader.Read(n) &&
+            reader.Skip(n, sizeof(std::int32_t));
+  }
+  return valid;
+}
+
+std::vector<Surface::SolidDescription>
+Surface::RoughnessCache::GetDescription() const {
+  std::vector<SolidDescription> description(fNDescriptions);
+  Reader reader(fDescriptions, fData + fSize);
+  for (auto &solid : description) {
+    std::uint32_t type{0};
+    std::uint32_t nParameter{0};
+    std::uint32_t nOuter{0};
+    G4double rotation[9];
+    G4double translation[3];
+    reader.Read(type);
+    reader.Read(nParameter);
+    reader.Read(nOuter);
+    reader.ReadArray(rotation, 9);
+    reader.ReadArray(translation, 3);
+    solid.VolumeType = static_cast<SolidDescription::Solid>(type);
+    solid.VolumeParameter.resize(nParameter);
+    reader.ReadArray(solid.VolumeParameter.data(), nParameter);
+    solid.OuterSurface.resize(nOuter);
+    reader.ReadArray(solid.OuterSurface.data(), nOuter);
+    solid.Transform = G4Transform3D(
+        G4RotationMatrix(CLHEP::HepRep3x3(rotation)),
+        G4ThreeVector(translation[0], translation[1], translation[2]));
+  }
+  return description;
+}
+
+void Surface::RoughnessCache::FillFacetStore(FacetStore *store) const {
+  Reader reader(fFacets, fData + fSize);
+  G4double vertices[9];
+  for (std::uint64_t i = 0; i < fNFacets; ++i) {
+    reader.ReadArray(vertices, 9);
+    store->AppendFacet(G4ThreeVector(vertices[0], vertices[1], vertices[2]),
+                       G4ThreeVector(vertices[3], vertices[4], vertices[5]),
+                       G4ThreeVector(vertices[6], vertices[7], vertices[8]));
+  }
+}
+
+void Surface::RoughnessCache::FillVoxelizer(
+    G4Voxelizer_Green &voxelizer) const {
+  Reader reader(fVoxels, fData + fSize);
+  std::uint64_t n{0};
+  std::uint32_t nBits{0};
+  reader.Read(n);
+  voxelizer.fBoxes.resize(n);
+  G4double box[6];
+  for (auto &voxelBox : voxelizer.fBoxes) {
+    reader.ReadArray(box, 6);
+    voxelBox.hlen.set(box[0], box[1], box[2]);
+    voxelBox.pos.set(box[3], box[4], box[5]);
+  }
+  reader.Read(voxelizer.fNPerSlice);
+  reader.Read(voxelizer.fTotalCandidates);
+  reader.ReadArray(voxelizer.fMaxBoundary, 3);
+  for (auto &boundary : voxelizer.fBoundaries) {
+    reader.Read(n);
+    boundary.resize(n);
+    reader.ReadArray(boundary.data(), n);
+  }
+  for (auto &bitmask : voxelizer.fBitmasks) {
+    reader.Read(nBits);
+    bitmask.Set(nBits, reinterpret_cast<const char *>(reader.Position()));
+    reader.Skip(BitmaskBytes(nBits));
+  }
+  reader.Read(nBits);
+  voxelizer.fEmpty.Set(nBits,
+                       reinterpret_cast<const char *>(reader.Position()));
+  reader.Skip(BitmaskBytes(nBits));
+
+  std::uint64_t nLists{0};
+  reader.Read(nLists);
+  voxelizer.fCandidates.clear();
+  for (std::uint64_t i = 0; i < nLists; ++i) {
+    std::int32_t voxel{0};
+    reader.Read(voxel);
+    reader.Read(n);
+    std::vector<G4int> candidates(n);
+    reader.ReadArray(candidates.data(), n);
+    voxelizer.fCandidates.emplace_hint(voxelizer.fCandidates.end(), voxel,
+                                       std::move(candidates));
+  }
+  for (auto &counts : voxelizer.fCandidatesCounts) {
+    counts.resize(0);
+  }
+  voxelizer.BuildBoundingBox();
+}
+
+G4bool Surface::RoughnessCache::Write(
+    const std::vector<SolidDescription> &description, const FacetStore &store,
+    const G4Voxelizer_Green &voxelizer, const std::string &engineState) const {
+  CreateDirectories(fFilename.substr(0, fFilename.rfind('/')));
+  const std::string temporary =
+      fFilename + ".tmp." + std::to_string(static_cast<long>(getpid()));
+  std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    return false;
+  }
+  Writer writer(out);
+  writer.WriteArray(kMagic, sizeof(kMagic));
+  writer.Write(kVersion);
+  writer.Write(kByteOrder);
+  writer.Write(static_cast<std::uint64_t>(fKey.size()));
+  writer.WriteArray(fKey.data(), fKey.size());
+  writer.Write(static_cast<std::uint64_t>(engineState.size()));
+  writer.WriteArray(engineState.data(), engineState.size());
+
+  writer.Write(static_cast<std::uint64_t>(description.size()));
+  for (const auto &solid : description) {
+    const G4RotationMatrix rotation = solid.Transform.getRotation();
+    const G4ThreeVector translation = solid.Transform.getTranslation();
+    const G4double transform[12] = {
+        rotation.xx(),   rotation.xy(),   rotation.xz(),
+        rotation.yx(),   rotation.yy(),   rotation.yz(),
+        rotation.zx(),   rotation.zy(),   rotation.zz(),
+        translation.x(), translation.y(), translation.z()};
+    writer.Write(static_cast<std::uint32_t>(solid.VolumeType));
+    writer.Write(static_cast<std::uint32_t>(solid.VolumeParameter.size()));
+    writer.Write(static_cast<std::uint32_t>(solid.OuterSurface.size()));
+    writer.WriteArray(transform, 12);
+    writer.WriteArray(solid.VolumeParameter.data(),
+                      solid.VolumeParameter.size());
+    writer.WriteArray(solid.OuterSurface.data(), solid.OuterSurface.size());
+  }
+
+  writer.Write(static_cast<std::uint64_t>(store.Size()));
+  for (G4int facet = 0; facet < store.Size(); ++facet) {
+    for (auto i = 0; i < 3; ++i) {
+      const G4ThreeVector &vertex = store.GetVertex(facet, i);
+      const G4double xyz[3] = {vertex.x(), vertex.y(), vertex.z()};
+      writer.WriteArray(xyz, 3);
+    }
+  }
+
+  WriteVoxels(writer, voxelizer);
+  out.close();
+  if (!out || std::rename(temporary.c_str(), fFilename.c_str()) != 0) {
+    std::remove(temporary.c_str());
+    return false;
+  }
+  return true;
+}
+
+void Surface::RoughnessCache::WriteVoxels(Writer &writer,
+                                          const G4Voxelizer_Green &voxelizer) {
+  writer.Write(static_cast<std::uint64_t>(voxelizer.fBoxes.size()));
+  for (const auto &voxelBox : voxelizer.fBoxes) {
+    const G4double box[6] = {voxelBox.hlen.x(), voxelBox.hlen.y(),
+                             voxelBox.hlen.z(), voxelBox.pos.x(),
+                             voxelBox.pos.y(),  voxelBox.pos.z()};
+    writer.WriteArray(box, 6);
+  }
+  writer.Write(static_cast<std::int32_t>(voxelizer.fNPerSlice));
+  writer.Write(static_cast<std::int32_t>(voxelizer.fTotalCandidates));
+  for (const auto max : voxelizer.fMaxBoundary) {
+    writer.Write(static_cast<std::int32_t>(max));
+  }
+  for (const auto &boundary : voxelizer.fBoundaries) {
+    writer.Write(static_cast<std::uint64_t>(boundary.size()));
+    writer.WriteArray(boundary.data(), boundary.size());
+  }
+  for (const auto &bitmask : voxelizer.fBitmasks) {
+    writer.Write(static_cast<std::uint32_t>(bitmask.GetNbits()));
+    writer.WriteArray(bitmask.fAllBits, BitmaskBytes(bitmask.GetNbits()));
+  }
+  writer.Write(static_cast<std::uint32_t>(voxelizer.fEmpty.GetNbits()));
+  writer.WriteArray(voxelizer.fEmpty.fAllBits,
+                    BitmaskBytes(voxelizer.fEmpty.GetNbits()));
+
+  writer.Write(static_cast<std::uint64_t>(voxelizer.fCandidates.size()));
+  for (const auto &candidates : voxelizer.fCandidates) {
+    writer.Write(static_cast<std::int32_t>(candidates.first));
+    writer.Write(static_cast<std::uint64_t>(candidates.second.size()));
+    writer.WriteArray(candidates.second.data(), candidates.second.size());
+  }
+}
@@ -8,16 +8,31 @@
 #include "Service/include/RoughnessHelper.hh"
 
 #include <cstdlib>
+#include <sstream>
 
 #include "G4Box.hh"
 #include "G4LogicalVolume.hh"
 #include "G4MultiUnion.hh"
 #include "G4NistManager.hh"
 #include "G4UserLimits.hh"
+#include "Randomize.hh"
 #include "Service/include/G4Voxelizer_Green.hh"
+#include "Service/include/Profiler.hh"
+#include "Service/include/RoughnessCache.hh"
 #include "Service/include/RoughnessHelperMessenger.hh"
+#include "Service/include/VoxelTuner.hh"
+#include "SurfaceGenerator/include/Calculator.hh"
 #include "SurfaceGenerator/include/Describer.hh"
 #include "SurfaceGenerator/include/Generator.hh"
+#include "SurfaceGenerator/include/SpikeLatticeSolid.hh"
+
+namespace {
+std::string EngineState() {
+  std::ostringstream ss;
+  G4Random::getTheEngine()->put(ss);
+  return ss.str();
+}
+}  // namespace
 
 Surface::RoughnessHelper::RoughnessHelper(const G4String &name)
     : fLogger("RoughnessHelper_" + name),
@@ -41,9 +56,24 @@ Surface::RoughnessHelper::RoughnessHelper(const G4String &name,
       fMaterial(nullptr) {}
 
 void Surface::RoughnessHelper::Generate() {
+  SCORE4_PROFILE_SCOPE("RoughnessHelper::Generate");
   CheckValues();
-  BuildSurface();
-  BuildBasis();
+  if (fSolidType == RoughnessSolid::SpikeLattice) {
+    BuildLattice();
+  } else if (fCacheDir.empty()) {
+    BuildSurface();
+    BuildBasis();
+    Voxelize();
+  } else {
+    // key is taken before the build draws from the random engine
+    RoughnessCache cache(fCacheDir, CacheKey());
+    if (!LoadCache(cache)) {
+      BuildSurface();
+      BuildBasis();
+      Voxelize();
+      WriteCache(cache);
+    }
+  }
   Finalize();
   fLogger.WriteInfo("Build Roughness " + fName);
 }
@@ -162,11 +192,50 @@ void Surface::RoughnessHelper::SetBoundaryY(const G4int val) {
 void Surface::RoughnessHelper::SetBoundaryZ(const G4int val) {
   fNzBoundary = val;
 }
+void Surface::RoughnessHelper::SetBoundaryAuto(const G4bool val) {
+  fAutoBoundary = val;
+}
+void Surface::RoughnessHelper::SetVoxelMemoryLimit(const G4int megabytes) {
+  fVoxelMemoryLimit = megabytes;
+}
+void Surface::RoughnessHelper::SetVoxelThreads(const G4int val) {
+  fVoxelThreads = val;
+}
 
 void Surface::RoughnessHelper::SetStepLimit(const G4double val) {
   fStepLimit = new G4UserLimits(val);
 }
 
+void Surface::RoughnessHelper::SetCacheDir(const G4String &directory) {
+  fCacheDir = directory;
+}
+
+void Surface::RoughnessHelper::SetSolidType(const RoughnessSolid type) {
+  fSolidType = type;
+}
+
+void Surface::RoughnessHelper::SetSolidType(const G4String &type) {
+  if (type == "MultiUnion") {
+    SetSolidType(RoughnessSolid::MultiUnion);
+    return;
+  } else if (type == "SpikeLattice") {
+    SetSolidType(RoughnessSolid::SpikeLattice);
+    return;
+  }
+
+  std::stringstream ss;
+  ss << "\n";
+  ss << "ERROR\n";
+  ss << "Selected solid type is not valid: " << type << "\n";
+  ss << "Valid types are:\n";
+  ss << "\n";
+  ss << "MultiUnion\n";
+  ss << "SpikeLattice\n";
+  ss << "\n";
+  fLogger.WriteError(ss.str());
+  exit(EXIT_FAILURE);
+}
+
 void Surface::RoughnessHelper::CheckValues() {
   if (fStepLimit == nullptr) {
     const G4double min = std::min(fDxSpike, fDySpike);
@@ -222,8 +291,7 @@ void Surface::RoughnessHelper::CheckValues() {
   fLogger.WriteInfo("Values correct");
 }
 
-void Surface::RoughnessHelper::BuildSurface() {
-  // Prepare describer
+void Surface::RoughnessHelper::PrepareDescriber() {
   Surface::Describer &describer = fGenerator.GetDescriber();
   describer.SetNrSpike_X(fNxSpike);
   describer.SetNrSpike_Y(fNySpike);
@@ -233,7 +301,10 @@ void Surface::RoughnessHelper::BuildSurface() {
   describer.SetNLayer(fNLayer);
   describer.SetHeightDeviation(fDzSpikeDev);
   describer.SetSpikeform(fSpikeform);
+}
 
+void Surface::RoughnessHelper::BuildSurface() {
+  PrepareDescriber();
   fGenerator.GenerateSurface();
 
   fRoughness = dynamic_cast<G4MultiUnion *>(fGenerator.GetSolid());
@@ -249,16 +320,122 @@ void Surface::RoughnessHelper::BuildBasis() {
   G4Transform3D trafo{G4RotationMatrix(), placement};
   // Add to Roughness
   fRoughness->AddNode(*solidBasis, trafo);
+  fSolid = fRoughness;
   fLogger.WriteDetailInfo("Added basis to roughness");
 }
 
-void Surface::RoughnessHelper::Finalize() {
-  auto &voxelizer =
-      (Surface::G4Voxelizer_Green &)fRoughness->GetVoxels();
+void Surface::RoughnessHelper::BuildLattice() {
+  // seed of the spike heights drawn from the engine, as for all other
+  // random properties of the roughness
+  const auto seedHigh =
+      static_cast<std::uint64_t>(G4UniformRand() * 4294967296.);
+  const auto seedLow =
+      static_cast<std::uint64_t>(G4UniformRand() * 4294967296.);
+  const std::uint64_t seed = seedHigh << 32 | seedLow;
+  auto *lattice = new SpikeLatticeSolid(
+      fName + "_SpikeLattice", fSpikeform, fNxSpike, fNySpike, fDxSpike,
+      fDySpike, fDzSpikeMean, fDzSpikeDev, fNLayer, fDzBasis, seed);
+  lattice->FillFacetStore(fGenerator.GetFacetStore());
+  fSolid = lattice;
+  fLogger.WriteDetailInfo("Generated spike lattice");
+  const Calculator calculator{fGenerator.GetFacetStore()};
+  calculator.PrintSurfaceInformation();
+}
+
+Surface::G4Voxelizer_Green &Surface::RoughnessHelper::Voxelizer() const {
+  return (Surface::G4Voxelizer_Green &)fRoughness->GetVoxels();
+}
+
+void Surface::RoughnessHelper::Voxelize() {
+  SCORE4_PROFILE_SCOPE("RoughnessHelper::Voxelize");
+  Surface::G4Voxelizer_Green::SetBuildThreads(fVoxelThreads);
+  Surface::G4Voxelizer_Green::SetVerbose(fLogger.GetVerboseLvl());
+  if (fAutoBoundary) {
+    VoxelTuner tuner(fRoughness,
+                     static_cast<std::size_t>(fVoxelMemoryLimit) * 1000000);
+    const VoxelTuner::Setting chosen = tuner.Tune();
+    fNxBoundary = chosen.maxBoundary[0];
+    fNyBoundary = chosen.maxBoundary[1];
+    fNzBoundary = chosen.maxBoundary[2];
+    fLogger.WriteInfo(tuner.StreamInfo().str());
+    std::stringstream ss;
+    ss << "Chosen voxel boundaries (" << chosen.memory / 1e6 << " MB, "
+       << chosen.cost << " ns per ray), to pin them use:\n";
+    ss << PinBoundaryCommands();
+    fLogger.WriteInfo(ss.str());
+    return;
+  }
+  auto &voxelizer = Voxelizer();
   voxelizer.SetMaxBoundary(fNxBoundary, fNyBoundary, fNzBoundary);
   voxelizer.Voxelize(fRoughness);
+}
+
+std::string Surface::RoughnessHelper::PinBoundaryCommands() const {
+  std::stringstream ss;
+  const G4String path = "/Surface/RoughnessHelper/" + fName + "/";
+  ss << path << "setBoundaryNx " << fNxBoundary << "\n";
+  ss << path << "setBoundaryNy " << fNyBoundary << "\n";
+  ss << path << "setBoundaryNz " << fNzBoundary << "\n";
+  return ss.str();
+}
+
+std::string Surface::RoughnessHelper::CacheKey() const {
+  std::stringstream ss;
+  ss << std::hexfloat;  // exact representation of all lengths
+  ss << "spike " << fDxSpike << " " << fDySpike << " " << fDzSpikeMean << " "
+     << fDzSpikeDev << " " << fNxSpike << " " << fNySpike << " " << fNLayer
+     << " " << static_cast<G4int>(fSpikeform) << "\n";
+  ss << "basis " << fDxBasis << " " << fDyBasis << " " << fDzBasis << "\n";
+  if (fAutoBoundary) {
+    // the tuned boundaries are not an input, the first job that writes the
+    // file fixes them for all jobs with this key, see LoadCache()
+    ss << "boundary auto " << fVoxelMemoryLimit << "\n";
+  } else {
+    ss << "boundary " << fNxBoundary << " " << fNyBoundary << " "
+       << fNzBoundary << "\n";
+  }
+  ss << "engine\n" << EngineState();
+  return ss.str();
+}
+
+G4bool Surface::RoughnessHelper::LoadCache(RoughnessCache &cache) {
+  if (!cache.Open()) {
+    fLogger.WriteInfo("Cache miss " + cache.GetFilename());
+    return false;
+  }
+  fLogger.WriteInfo("Cache hit " + cache.GetFilename());
+  PrepareDescriber();
+  cache.FillFacetStore(fGenerator.GetFacetStore());
+  fGenerator.GenerateSurface(cache.GetDescription());
+  fRoughness = fGenerator.GetSolid();
+  BuildBasis();
+  cache.FillVoxelizer(Voxelizer());
+  if (fAutoBoundary) {
+    fNxBoundary = Voxelizer().GetMaxBoundary(0);
+    fNyBoundary = Voxelizer().GetMaxBoundary(1);
+    fNzBoundary = Voxelizer().GetMaxBoundary(2);
+    fLogger.WriteInfo("Voxel boundaries chosen by the job that wrote the "
+                      "cache, to pin them use:\n" +
+                      PinBoundaryCommands());
+  }
+  // continue with the random numbers a generation would have left behind
+  std::istringstream state(cache.GetEngineState());
+  G4Random::getTheEngine()->get(state);
+  return true;
+}
+
+void Surface::RoughnessHelper::WriteCache(const RoughnessCache &cache) {
+  if (cache.Write(fGenerator.GetDescriber().GetSolidDescription(),
+                  *fGenerator.GetFacetStore(), Voxelizer(), EngineState())) {
+    fLogger.WriteInfo("Wrote cache " + cache.GetFilename());
+  } else {
+    fLogger.WriteWarning("Failed to write cache " + cache.GetFilename());
+  }
+}
+
+void Surface::RoughnessHelper::Finalize() {
   std::string name = fName + "_roughness";
-  fLogicRoughness = new G4LogicalVolume(fRoughness, fMaterial, name);
+  fLogicRoughness = new G4LogicalVolume(fSolid, fMaterial, name);
   fLogicRoughness->SetUserLimits(fStepLimit);
   fLogger.WriteDetailInfo("Build Logical Volume " + name);
 }
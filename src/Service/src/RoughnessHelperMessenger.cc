@@ -8,6 +8,7 @@
 #include "Service/include/RoughnessHelperMessenger.hh"
 
 #include "G4ApplicationState.hh"
+#include "G4UIcmdWithABool.hh"
 #include "G4UIcmdWithADoubleAndUnit.hh"
 #include "G4UIcmdWithAString.hh"
 #include "G4UIcmdWithAnInteger.hh"
@@ -121,11 +122,50 @@ Surface::RoughnessHelperMessenger::RoughnessHelperMessenger(
                                         G4State_Idle);
   fCmdSetBoundaryNz->SetGuidance("Set number of boundaries in z direction");
 
+  const G4String cmdSetBoundaryAuto = ctrlPath + "setBoundaryAuto";
+  fCmdSetBoundaryAuto = new G4UIcmdWithABool(cmdSetBoundaryAuto, this);
+  fCmdSetBoundaryAuto->AvailableForStates(G4State_PreInit, G4State_Init,
+                                          G4State_Idle);
+  fCmdSetBoundaryAuto->SetGuidance(
+      "Choose number of boundaries by timing test voxelizations");
+  fCmdSetBoundaryAuto->SetDefaultValue(true);
+
+  const G4String cmdSetVoxelMemoryLimit = ctrlPath + "setVoxelMemoryLimit";
+  fCmdSetVoxelMemoryLimit =
+      new G4UIcmdWithAnInteger(cmdSetVoxelMemoryLimit, this);
+  fCmdSetVoxelMemoryLimit->AvailableForStates(G4State_PreInit, G4State_Init,
+                                              G4State_Idle);
+  fCmdSetVoxelMemoryLimit->SetGuidance(
+      "Set memory limit of the voxels in MB for setBoundaryAuto");
+
+  const G4String cmdSetVoxelThreads = ctrlPath + "setVoxelThreads";
+  fCmdSetVoxelThreads = new G4UIcmdWithAnInteger(cmdSetVoxelThreads, this);
+  fCmdSetVoxelThreads->AvailableForStates(G4State_PreInit, G4State_Init,
+                                          G4State_Idle);
+  fCmdSetVoxelThreads->SetGuidance(
+      "Set number of threads building the voxels, 0: all hardware threads");
+
   const G4String cmdSetStepLimit = ctrlPath + "setStepLimit";
   fCmdSetStepLimit = new G4UIcmdWithADoubleAndUnit(cmdSetStepLimit, this);
   fCmdSetStepLimit->AvailableForStates(G4State_PreInit, G4State_Init,
                                        G4State_Idle);
   fCmdSetStepLimit->SetGuidance("Set StepLimit for roughness");
+
+  const G4String cmdSetSolid = ctrlPath + "setSolid";
+  fCmdSetSolid = new G4UIcmdWithAString(cmdSetSolid, this);
+  fCmdSetSolid->AvailableForStates(G4State_PreInit, G4State_Init,
+                                   G4State_Idle);
+  fCmdSetSolid->SetGuidance(
+      "Set representation of roughness solid (MultiUnion or SpikeLattice)");
+  fCmdSetSolid->SetCandidates("MultiUnion SpikeLattice");
+  fCmdSetSolid->SetDefaultValue("MultiUnion");
+
+  const G4String cmdSetCacheDir = ctrlPath + "setCacheDir";
+  fCmdSetCacheDir = new G4UIcmdWithAString(cmdSetCacheDir, this);
+  fCmdSetCacheDir->AvailableForStates(G4State_PreInit, G4State_Init,
+                                      G4State_Idle);
+  fCmdSetCacheDir->SetGuidance(
+      "Set directory of the build cache of the MultiUnion roughness");
 }
 
 Surface::RoughnessHelperMessenger::~RoughnessHelperMessenger() {
@@ -173,9 +213,19 @@ Surface::RoughnessHelperMessenger::~RoughnessHelperMessenger() {
   fCmdSetBoundaryNy = nullptr;
   delete fCmdSetBoundaryNz;
   fCmdSetBoundaryNz = nullptr;
+  delete fCmdSetBoundaryAuto;
+  fCmdSetBoundaryAuto = nullptr;
+  delete fCmdSetVoxelMemoryLimit;
+  fCmdSetVoxelMemoryLimit = nullptr;
+  delete fCmdSetVoxelThreads;
+  fCmdSetVoxelThreads = nullptr;
 
   delete fCmdSetStepLimit;
   fCmdSetStepLimit = nullptr;
+  delete fCmdSetSolid;
+  fCmdSetSolid = nullptr;
+  delete fCmdSetCacheDir;
+  fCmdSetCacheDir = nullptr;
 }
 
 void Surface::RoughnessHelperMessenger::SetNewValue(G4UIcommand* command,
@@ -213,7 +263,18 @@ void Surface::RoughnessHelperMessenger::SetNewValue(G4UIcommand* command,
     fSource->SetBoundaryY(G4UIcmdWithAnInteger::GetNewIntValue(newValues));
   } else if (command == fCmdSetBoundaryNz) {
     fSource->SetBoundaryZ(G4UIcmdWithAnInteger::GetNewIntValue(newValues));
+  } else if (command == fCmdSetBoundaryAuto) {
+    fSource->SetBoundaryAuto(G4UIcmdWithABool::GetNewBoolValue(newValues));
+  } else if (command == fCmdSetVoxelMemoryLimit) {
+    fSource->SetVoxelMemoryLimit(
+        G4UIcmdWithAnInteger::GetNewIntValue(newValues));
+  } else if (command == fCmdSetVoxelThreads) {
+    fSource->SetVoxelThreads(G4UIcmdWithAnInteger::GetNewIntValue(newValues));
   } else if (command == fCmdSetStepLimit) {
     fSource->SetStepLimit(G4UIcmdWithADoubleAndUnit::GetNewDoubleValue(newValues));
+  } else if (command == fCmdSetSolid) {
+    fSource->SetSolidType(newValues);
+  } else if (command == fCmdSetCacheDir) {
+    fSource->SetCacheDir(newValues);
   }
 }
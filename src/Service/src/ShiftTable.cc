@@ -0,0 +1,253 @@
+/**
+ * @brief Implementation of ShiftTable class
+ * @author agent
+ * @date 2026-10-17
+ * @file ShiftTable.cc
+ */
+
+#include "Service/include/ShiftTable.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+namespace {
+G4bool IsZero(const G4double a) {
+  const G4double numeric_limit = std::numeric_limits<G4double>::epsilon() * 10;
+  return std::fabs(a) < numeric_limit;
+}
+}  // namespace
+
+G4bool Surface::ShiftTable::Load(const std::string &filename) {
+  std::ifstream file;
+  file.open(filename);
+  if (!file.is_open()) {
+    return false;
+  }
+  fDepth.clear();
+  fCounts.clear();
+  std::string line;
+  const std::string delimiter = ",";
+  while (getline(file, line)) {
+    const auto pos = line.find(delimiter);
+    const G4double depth = std::stod(line.substr(0, pos));
+    const G4double counts = std::stod(line.substr(pos + 1, pos + line.size()));
+    fDepth.push_back(depth);
+    fCounts.push_back(counts);
+  }
+  file.close();
+  Build();
+  return true;
+}
+
+void Surface::ShiftTable::SetRange(const G4double min, const G4double max) {
+  fMin = min;
+  fMax = max;
+  Build();
+}
+
+void Surface::ShiftTable::Build() {
+  fBins.clear();
+  fPrefix.clear();
+  fSampler = AliasTable();
+  fRangeProbability = 0.;
+  fRangeEmpty = false;
+  if (fDepth.size() < 2) {
+    return;
+  }
+  const G4double total = BuildBins(-DBL_MAX, DBL_MAX);
+  if (total <= 0) {
+    fBins.clear();
+    return;
+  }
+  fPrefix.reserve(fDepth.size());
+  fPrefix.push_back(0.);
+  for (std::size_t i = 0; i + 1 < fDepth.size(); ++i) {
+    fPrefix.push_back(fPrefix.back() + 0.5 * (fCounts[i] + fCounts[i + 1]));
+  }
+  const G4double min = fMin / CLHEP::nm;
+  const G4double max = fMax >= DBL_MAX ? DBL_MAX : fMax / CLHEP::nm;
+  const G4double inRange = BuildBins(min, max);
+  fRangeProbability = inRange / total;
+  if (inRange <= 0) {
+    fRangeEmpty = true;
+    BuildBins(-DBL_MAX, DBL_MAX);
+  }
+  std::vector<G4double> weights;
+  weights.reserve(fBins.size());
+  for (const auto &bin : fBins) {
+    weights.push_back(bin.weight);
+  }
+  fSampler.Build(weights);
+}
+
+G4double Surface::ShiftTable::BuildBins(const G4double min,
+                                        const G4double max) {
+  fBins.clear();
+  G4double total{0};
+  for (std::size_t i = 0; i + 1 < fDepth.size(); ++i) {
+    const G4double width = fDepth[i + 1] - fDepth[i];
+    // cuts as fraction t of the bin
+    G4double t0{0};
+    G4double t1{1};
+    if (width > 0) {
+      t0 = std::max(0., (min - fDepth[i]) / width);
+      t1 = std::min(1., (max - fDepth[i]) / width);
+    } else if (fDepth[i] < min || fDepth[i] > max) {
+      continue;
+    }
+    if (t1 <= t0) {
+      continue;
+    }
+    const G4double a = fCounts[i];
+    const G4double b = fCounts[i + 1];
+    Bin bin{fDepth[i] + t0 * width, (t1 - t0) * width, 0., a + t0 * (b - a),
+            a + t1 * (b - a)};
+    // the table weights a bin with its mean counts, independent of its width
+    bin.weight = (t1 - t0) * 0.5 * (bin.countsLow + bin.countsHigh);
+    total += bin.weight;
+    fBins.push_back(bin);
+  }
+  return total;
+}
+
+G4double Surface::ShiftTable::Sample() const {
+  const Bin &bin = fBins[fSampler.Sample()];
+  const G4double a = bin.countsLow;
+  const G4double b = bin.countsHigh;
+  const G4double rand = G4UniformRand();
+  // inverse of the cumulative distribution of the linear density in the bin
+  G4double t{rand};
+  if (!IsZero(b - a)) {
+    t = (std::sqrt(a * a * (1 - rand) + b * b * rand) - a) / (b - a);
+  }
+  return (bin.low + t * bin.width) * CLHEP::nm;
+}
+
+Surface::ShiftTable::Interval Surface::ShiftTable::GetSampledRange() const {
+  if (fDepth.empty()) {
+    return {0., 0.};
+  }
+  Interval range{fDepth.front() * CLHEP::nm, fDepth.back() * CLHEP::nm};
+  if (!fRangeEmpty) {
+    range.first = std::max(range.first, fMin);
+    range.second = std::min(range.second, fMax);
+  }
+  return range;
+}
+
+G4double Surface::ShiftTable::Cumulative(const G4double depth) const {
+  if (depth <= fDepth.front()) {
+    return 0.;
+  }
+  if (depth >= fDepth.back()) {
+    return 1.;
+  }
+  const std::size_t i =
+      std::upper_bound(fDepth.begin(), fDepth.end(), depth) - fDepth.begin() -
+      1;
+  const G4double a = fCounts[i];
+  const G4double b = fCounts[i + 1];
+  const G4double t = (depth - fDepth[i]) / (fDepth[i + 1] - fDepth[i]);
+  return (fPrefix[i] + t * (a + 0.5 * (b - a) * t)) / fPrefix.back();
+}
+
+G4double Surface::ShiftTable::InverseCumulative(
+    const G4double probability) const {
+  const G4double weight = probability * fPrefix.back();
+  std::size_t i =
+      std::upper_bound(fPrefix.begin(), fPrefix.end(), weight) -
+      fPrefix.begin();
+  i = std::min(std::max<std::size_t>(i, 1), fPrefix.size() - 1) - 1;
+  const G4double a = fCounts[i];
+  const G4double b = fCounts[i + 1];
+  const G4double rest = weight - fPrefix[i];
+  // solve a t + (b - a) t^2 / 2 = rest
+  G4double t{0};
+  if (!IsZero(b - a)) {
+    t = (std::sqrt(std::max(0., a * a + 2. * (b - a) * rest)) - a) / (b - a);
+  } else if (a > 0) {
+    t = rest / a;
+  }
+  t = std::min(1., std::max(0., t));
+  return fDepth[i] + t * (fDepth[i + 1] - fDepth[i]);
+}
+
+G4bool Surface::ShiftTable::SampleWithin(
+    const std::vector<Interval> &intervals, G4double &depth,
+    G4double &share) const {
+  share = 0.;
+  if (!IsReady()) {
+    return false;
+  }
+  const Interval range = GetSampledRange();
+  std::vector<Interval> cut;
+  std::vector<G4double> mass;
+  G4double total{0};
+  for (const auto &interval : intervals) {
+    const G4double low = std::max(interval.first, range.first) / CLHEP::nm;
+    const G4double high = std::min(interval.second, range.second) / CLHEP::nm;
+    if (high <= low) {
+      continue;
+    }
+    const G4double m = Cumulative(high) - Cumulative(low);
+    if (m <= 0) {
+      continue;
+    }
+    cut.emplace_back(low, high);
+    mass.push_back(m);
+    total += m;
+  }
+  const G4double rangeMass = Cumulative(range.second / CLHEP::nm) -
+                             Cumulative(range.first / CLHEP::nm);
+  if (total <= 0 || rangeMass <= 0) {
+    return false;
+  }
+  share = std::min(1., total / rangeMass);
+
+  G4double rest = G4UniformRand() * total;
+  std::size_t k{0};
+  while (k + 1 < cut.size() && rest >= mass[k]) {
+    rest -= mass[k];
+    ++k;
+  }
+  const G4double probability = Cumulative(cut[k].first) + rest;
+  const G4double inverse = InverseCumulative(probability);
+  depth = std::min(cut[k].second, std::max(cut[k].first, inverse)) * CLHEP::nm;
+  return true;
+}
+
+std::stringstream Surface::ShiftTable::StreamInfo() const {
+  std::stringstream ss;
+  ss << "Shift table:\n";
+  G4double total{0};
+  for (std::size_t i = 0; i + 1 < fCounts.size(); ++i) {
+    total += 0.5 * (fCounts[i] + fCounts[i + 1]);
+  }
+  G4double probability{0};
+  for (std::size_t i = 0; i < fCounts.size(); ++i) {
+    if (i > 0 && total > 0) {
+      probability += 0.5 * (fCounts[i - 1] + fCounts[i]) / total;
+    }
+    ss << "Shift: " << std::setw(10) << fDepth[i]
+       << " Counts: " << std::setw(10) << fCounts[i]
+       << " Summed probability: " << std::setw(10) << probability << "\n";
+  }
+  ss << "Range: " << fMin / CLHEP::nm << " nm to ";
+  if (fMax >= DBL_MAX) {
+    ss << "inf";
+  } else {
+    ss << fMax / CLHEP::nm << " nm";
+  }
+  ss << ", probability within range: " << fRangeProbability;
+  if (fRangeEmpty) {
+    ss << ", full table sampled";
+  }
+  ss << "\n";
+  return ss;
+}
@@ -0,0 +1,209 @@
+/**
+ * @brief Implementation of VertexFileWriter and VertexFileReader
+ * @author agent
+ * @date 2026-10-17
+ * @file VertexFile.cc
+ */
+
+#include "Service/include/VertexFile.hh"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "G4Exception.hh"
+
+namespace {
+constexpr char kMagic[8] = "SC4VTXS";
+constexpr std::uint32_t kVersion{1};
+constexpr std::uint32_t kByteOrder{0x01020304};
+constexpr std::streamoff kSizeOffset{sizeof(kMagic) + 2 * sizeof(kVersion)};
+constexpr std::streamoff kHeaderSize{kSizeOffset + sizeof(std::uint64_t)};
+}  // namespace
+
+Surface::VertexFileWriter::VertexFileWriter(const G4String &filename,
+                                            const std::size_t blockSize)
+    : fFilename(filename),
+      fTemporary(filename + ".tmp." +
+                 std::to_string(static_cast<long>(getpid()))),
+      fBlockSize(std::max<std::size_t>(blockSize, 1)) {}
+
+Surface::VertexFileWriter::~VertexFileWriter() {
+  if (fOpen) {
+    Wait();
+    fOut.close();
+    std::remove(fTemporary.c_str());
+  }
+}
+
+G4bool Surface::VertexFileWriter::Open() {
+  fOut.open(fTemporary, std::ios::binary | std::ios::trunc);
+  if (!fOut) {
+    return false;
+  }
+  const std::uint64_t size{0};  // set by Close()
+  fOut.write(kMagic, sizeof(kMagic));
+  fOut.write(reinterpret_cast<const char *>(&kVersion), sizeof(kVersion));
+  fOut.write(reinterpret_cast<const char *>(&kByteOrder), sizeof(kByteOrder));
+  fOut.write(reinterpret_cast<const char *>(&size), sizeof(size));
+  fBlock.reserve(fBlockSize);
+  fWriting.reserve(fBlockSize);
+  fSize = 0;
+  fOpen = true;
+  return static_cast<G4bool>(fOut);
+}
+
+void Surface::VertexFileWriter::Append(const VertexRecord &record) {
+  fBlock.push_back(record);
+  ++fSize;
+  if (fBlock.size() == fBlockSize) {
+    Flush();
+  }
+}
+
+void Surface::VertexFileWriter::Flush() {
+  Wait();
+  std::swap(fBlock, fWriting);
+  fBlock.clear();
+  fPending = std::async(std::launch::async, [this] {
+    fOut.write(reinterpret_cast<const char *>(fWriting.data()),
+               fWriting.size() * sizeof(VertexRecord));
+  });
+}
+
+void Surface::VertexFileWriter::Wait() {
+  if (fPending.valid()) {
+    fPending.get();
+  }
+}
+
+G4bool Surface::VertexFileWriter::Close() {
+  if (!fOpen) {
+    return false;
+  }
+  Flush();
+  Wait();
+  fOut.seekp(kSizeOffset);
+  fOut.write(reinterpret_cast<const char *>(&fSize), sizeof(fSize));
+  fOut.close();
+  fOpen = false;
+  if (!fOut || std::rename(fTemporary.c_str(), fFilename.c_str()) != 0) {
+    std::remove(fTemporary.c_str());
+    return false;
+  }
+  return true;
+}
+
+Surface::VertexFileReader::VertexFileReader(const std::size_t blockSize)
+    : fBlockSize(std::max<std::size_t>(blockSize, 1)) {}
+
+Surface::VertexFileReader::~VertexFileReader() { Wait(); }
+
+G4bool Surface::VertexFileReader::Open(const G4String &filename) {
+  Wait();
+  fIn.close();
+  fIn.clear();
+  fIn.open(filename, std::ios::binary);
+  char magic[sizeof(kMagic)];
+  std::uint32_t version{0};
+  std::uint32_t byteOrder{0};
+  std::uint64_t size{0};
+  fIn.read(magic, sizeof(magic));
+  fIn.read(reinterpret_cast<char *>(&version), sizeof(version));
+  fIn.read(reinterpret_cast<char *>(&byteOrder), sizeof(byteOrder));
+  fIn.read(reinterpret_cast<char *>(&size), sizeof(size));
+  if (!fIn || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      version != kVersion || byteOrder != kByteOrder) {
+    fIn.close();
+    fSize = 0;
+    SetRange(0, 0);
+    return false;
+  }
+  fIn.seekg(0, std::ios::end);
+  const std::streamoff stored =
+      (static_cast<std::streamoff>(fIn.tellg()) - kHeaderSize) /
+      static_cast<std::streamoff>(sizeof(VertexRecord));
+  if (!fIn || stored < 0 || size > static_cast<std::uint64_t>(stored)) {
+    fIn.close();
+    fSize = 0;
+    SetRange(0, 0);
+    return false;
+  }
+  fSize = size;
+  SetRange(0, fSize);
+  return true;
+}
+
+void Surface::VertexFileReader::SetRange(const std::uint64_t first,
+                                         const std::uint64_t count) {
+  Wait();
+  fRangeBegin = std::min(first, fSize);
+  fRangeEnd = fRangeBegin + std::min(count, fSize - fRangeBegin);
+  fNextRead = fRangeBegin;
+  fRestarts = 0;
+  fStarted = false;
+  fCurrent.clear();
+  fAhead.clear();
+  fIndex = 0;
+  if (fRangeEnd > fRangeBegin) {
+    ReadAhead();
+  }
+}
+
+void Surface::VertexFileReader::SetShard(const std::uint64_t index,
+                                         const std::uint64_t count) {
+  if (count == 0 || index >= count) {
+    SetRange(0, 0);
+    return;
+  }
+  const std::uint64_t base = fSize / count;
+  const std::uint64_t rest = fSize % count;
+  SetRange(index * base + std::min(index, rest),
+           base + (index < rest ? 1 : 0));
+}
+
+void Surface::VertexFileReader::ReadAhead() {
+  const std::uint64_t first = fNextRead;
+  const auto count = static_cast<std::size_t>(
+      std::min<std::uint64_t>(fBlockSize, fRangeEnd - first));
+  fAheadFirst = first;
+  fNextRead = first + count == fRangeEnd ? fRangeBegin : first + count;
+  fPending = std::async(std::launch::async, [this, first, count] {
+    fAhead.resize(count);
+    fIn.seekg(kHeaderSize + static_cast<std::streamoff>(
+                                first * sizeof(VertexRecord)));
+    fIn.read(reinterpret_cast<char *>(fAhead.data()),
+             count * sizeof(VertexRecord));
+    return static_cast<G4bool>(fIn);
+  });
+}
+
+void Surface::VertexFileReader::Wait() {
+  if (fPending.valid()) {
+    fPending.get();
+  }
+}
+
+const Surface::VertexRecord &Surface::VertexFileReader::Next() {
+  if (fIndex == fCurrent.size()) {
+    if (!fPending.valid()) {
+      G4Exception("VertexFileReader::Next()", "", FatalException,
+                  "No vertices to read, the range of the file is empty");
+    }
+    if (!fPending.get()) {
+      G4Exception("VertexFileReader::Next()", "", FatalException,
+                  "Reading the vertex file failed");
+    }
+    if (fStarted && fAheadFirst == fRangeBegin) {
+      ++fRestarts;
+    }
+    fStarted = true;
+    std::swap(fCurrent, fAhead);
+    fIndex = 0;
+    ReadAhead();
+  }
+  return fCurrent[fIndex++];
+}
@@ -0,0 +1,219 @@
+/**
+ * @brief Implementation of VoxelTuner class
+ * @author agent
+ * @date 2026-10-17
+ * @file VoxelTuner.cc
+ */
+
+#include "Service/include/VoxelTuner.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <random>
+
+#include "G4PhysicalConstants.hh"
+#include "Service/include/G4Voxelizer_Green.hh"
+
+namespace {
+constexpr std::uint64_t kRaySeed{20261017};
+constexpr G4int kRepetitions{3};
+constexpr G4int kMinBoundary{4};
+constexpr G4double kCostTolerance{1.05};
+}  // namespace
+
+Surface::VoxelTuner::VoxelTuner(G4MultiUnion *munion,
+                                const std::size_t memoryLimit,
+                                const G4int nRays)
+    : fUnion(munion), fMemoryLimit(memoryLimit), fNRays(nRays) {}
+
+Surface::G4Voxelizer_Green &Surface::VoxelTuner::Voxelizer() const {
+  return (Surface::G4Voxelizer_Green &)fUnion->GetVoxels();
+}
+
+Surface::VoxelTuner::Setting Surface::VoxelTuner::Tune() {
+  Voxelizer().CountBoundaries(fUnion, fNatural);
+  GenerateRays();
+  fMeasured.clear();
+
+  auto reduce = [](const G4int natural, const G4int factor) {
+    // max >= 2n keeps all n boundaries
+    return std::max(kMinBoundary, 2 * natural / factor);
+  };
+  auto best = [this]() -> const Setting * {
+    const Setting *fastest{nullptr};
+    for (const auto &setting : fMeasured) {
+      if (setting.cost >= 0 &&
+          (fastest == nullptr || setting.cost < fastest->cost)) {
+        fastest = &setting;
+      }
+    }
+    const Setting *chosen{fastest};
+    for (const auto &setting : fMeasured) {
+      if (setting.cost >= 0 &&
+          setting.cost <= kCostTolerance * fastest->cost &&
+          setting.memory < chosen->memory) {
+        chosen = &setting;
+      }
+    }
+    return chosen;
+  };
+
+  for (G4int factor = 1; factor <= 64; factor *= 4) {
+    Evaluate(reduce(fNatural[0], factor), reduce(fNatural[1], factor),
+             reduce(fNatural[2], 1), fMemoryLimit);
+  }
+  if (best() == nullptr) {  // nothing fits, take the coarsest setting
+    Evaluate(kMinBoundary, kMinBoundary, kMinBoundary,
+             std::numeric_limits<std::size_t>::max());
+  }
+  const Setting xy = *best();
+  for (G4int factor = 4; factor <= 64; factor *= 4) {
+    Evaluate(xy.maxBoundary[0], xy.maxBoundary[1],
+             reduce(fNatural[2], factor), fMemoryLimit);
+  }
+
+  const Setting chosen = *best();
+  const Setting &last = fMeasured.back();
+  if (last.cost < 0 ||
+      !std::equal(chosen.maxBoundary, chosen.maxBoundary + 3,
+                  last.maxBoundary)) {
+    Voxelizer().SetMaxBoundary(chosen.maxBoundary[0], chosen.maxBoundary[1],
+                               chosen.maxBoundary[2]);
+    Voxelizer().Voxelize(fUnion);
+  }
+  return chosen;
+}
+
+void Surface::VoxelTuner::GenerateRays() {
+  G4ThreeVector min;
+  G4ThreeVector max;
+  fUnion->BoundingLimits(min, max);
+  const G4ThreeVector margin = 0.1 * (max - min);
+  min -= margin;
+  max += margin;
+
+  std::mt19937_64 engine(kRaySeed);
+  std::uniform_real_distribution<G4double> uniform(0., 1.);
+  fRays.resize(fNRays);
+  for (auto &ray : fRays) {
+    for (auto axis = 0; axis <= 2; ++axis) {
+      ray.point[axis] = min[axis] + uniform(engine) * (max[axis] - min[axis]);
+    }
+    const G4double cosTheta = 2. * uniform(engine) - 1.;
+    const G4double sinTheta = std::sqrt(1. - cosTheta * cosTheta);
+    const G4double phi = CLHEP::twopi * uniform(engine);
+    ray.direction.set(sinTheta * std::cos(phi), sinTheta * std::sin(phi),
+                      cosTheta);
+  }
+}
+
+G4int Surface::VoxelTuner::KeptBoundaries(const G4int n, const G4int max) {
+  if (n <= max / 2) {
+    return n;
+  }
+  // every skip-th boundary and the last one, see BuildBoundaries()
+  const G4int skip = n / (max / 2);
+  return (n - 1) / skip + 1 + ((n - 1) % skip != 0 ? 1 : 0);
+}
+
+std::size_t Surface::VoxelTuner::PredictMemory(
+    const G4int maxBoundary[3]) const {
+  const G4double bitsPerSlice =
+      8. * sizeof(unsigned int) *
+      (1 + (fUnion->GetNumberOfSolids() - 1) / (8 * sizeof(unsigned int)));
+  G4double voxels{1};
+  G4double bitmasks{0};
+  for (auto axis = 0; axis <= 2; ++axis) {
+    const G4int kept = KeptBoundaries(fNatural[axis], maxBoundary[axis]);
+    voxels *= kept;
+    bitmasks += (kept - 1) * bitsPerSlice / 8.;
+  }
+  const G4double bytes = bitmasks + voxels / 8.;
+  constexpr std::size_t maxBytes = std::numeric_limits<std::size_t>::max();
+  if (bytes >= static_cast<G4double>(maxBytes)) {
+    return maxBytes;
+  }
+  return static_cast<std::size_t>(bytes);
+}
+
+void Surface::VoxelTuner::Evaluate(const G4int maxX, const G4int maxY,
+                                   const G4int maxZ,
+                                   const std::size_t memoryLimit) {
+  const G4int maxBoundary[3] = {maxX, maxY, maxZ};
+  // settings with the same boundaries are measured once
+  for (const auto &setting : fMeasured) {
+    G4bool same{setting.cost >= 0 || setting.memory > memoryLimit};
+    for (auto axis = 0; axis <= 2; ++axis) {
+      same = same &&
+             KeptBoundaries(fNatural[axis], setting.maxBoundary[axis]) ==
+                 KeptBoundaries(fNatural[axis], maxBoundary[axis]);
+    }
+    if (same) {
+      return;
+    }
+  }
+
+  Setting setting{{maxX, maxY, maxZ}, PredictMemory(maxBoundary), -1.};
+  if (setting.memory <= memoryLimit) {
+    Voxelizer().SetMaxBoundary(maxX, maxY, maxZ);
+    Voxelizer().Voxelize(fUnion);
+    setting.memory = Voxelizer().AllocatedMemory();
+    if (setting.memory <= memoryLimit) {
+      setting.cost = MeasureCost();
+    }
+  }
+  fMeasured.push_back(setting);
+}
+
+G4double Surface::VoxelTuner::MeasureCost() const {
+  G4double fastest{std::numeric_limits<G4double>::max()};
+  volatile G4double sink{0};
+  for (G4int repetition = 0; repetition < kRepetitions; ++repetition) {
+    G4double sum{0};
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto &ray : fRays) {
+      const EInside inside = fUnion->Inside(ray.point);
+      if (inside == kOutside) {
+        sum += fUnion->DistanceToIn(ray.point, ray.direction);
+        sum += fUnion->DistanceToIn(ray.point);
+      } else if (inside == kInside) {
+        sum += fUnion->DistanceToOut(ray.point, ray.direction);
+        sum += fUnion->DistanceToOut(ray.point);
+      }
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    sink = sink + sum;
+    const G4double time =
+        std::chrono::duration<G4double, std::nano>(stop - start).count();
+    fastest = std::min(fastest, time / fRays.size());
+  }
+  return fastest;
+}
+
+std::stringstream Surface::VoxelTuner::StreamInfo() const {
+  std::stringstream ss;
+  ss << "Voxel boundaries of " << fUnion->GetNumberOfSolids()
+     << " nodes, distinct boundaries x y z: " << fNatural[0] << " "
+     << fNatural[1] << " " << fNatural[2] << "\n";
+  ss << "Memory limit: " << fMemoryLimit / 1e6 << " MB, rays: " << fNRays
+     << "\n";
+  ss << std::setw(10) << "maxX" << std::setw(10) << "maxY" << std::setw(10)
+     << "maxZ" << std::setw(14) << "memory [MB]" << std::setw(14)
+     << "cost [ns]" << "\n";
+  for (const auto &setting : fMeasured) {
+    ss << std::setw(10) << setting.maxBoundary[0] << std::setw(10)
+       << setting.maxBoundary[1] << std::setw(10) << setting.maxBoundary[2]
+       << std::setw(14) << setting.memory / 1e6 << std::setw(14);
+    if (setting.cost >= 0) {
+      ss << setting.cost;
+    } else {
+      ss << "over limit";
+    }
+    ss << "\n";
+  }
+  return ss;
+}
@@ -0,0 +1,739 @@
+/**
+ * @brief Implementation of HeightFieldSolid.hh
+ * @author agent
+ * @date 2026-10-17
+ * @file HeightFieldSolid.cc
+ */
+
+#include "Surface/HeightFieldSolid.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <utility>
+
+#include "G4BoundingEnvelope.hh"
+#include "G4Exception.hh"
+#include "G4GeometryTolerance.hh"
+#include "G4PolyhedronArbitrary.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4VGraphicsScene.hh"
+#include "Randomize.hh"
+
+namespace Surface {
+
+namespace {
+/// t at which a ray leaves the cells [first, last) of one axis
+G4double axis_exit(const G4double position, const G4double direction,
+                   const G4double lower_edge, const G4double step,
+                   const G4int first, const G4int last) {
+  if (direction > 0.) {
+    return (lower_edge + last * step - position) / direction;
+  }
+  if (direction < 0.) {
+    return (lower_edge + first * step - position) / direction;
+  }
+  return kInfinity;
+}
+}  // namespace
+
+HeightFieldSolid::HeightFieldSolid(const G4String &name, const G4int nx,
+                                   const G4int ny, const G4double length_x,
+                                   const G4double length_y,
+                                   std::vector<float> heights)
+    : G4VSolid(name),
+      f_nx(nx),
+      f_ny(ny),
+      f_half_x(0.5 * length_x),
+      f_half_y(0.5 * length_y),
+      f_step_x(0),
+      f_step_y(0),
+      f_top(std::move(heights)),
+      f_half_tolerance(
+          0.5 * G4GeometryTolerance::GetInstance()->GetSurfaceTolerance()) {
+  if (f_nx < 2 || f_ny < 2 || length_x <= 0 || length_y <= 0 ||
+      f_top.size() != static_cast<std::size_t>(f_nx) * f_ny) {
+    G4Exception("HeightFieldSolid::HeightFieldSolid()", "", FatalException,
+                ("Invalid dimensions for height field " + name).c_str());
+  }
+  f_step_x = length_x / (f_nx - 1);
+  f_step_y = length_y / (f_ny - 1);
+  const auto range = std::minmax_element(f_top.begin(), f_top.end());
+  f_min_top = *range.first;
+  f_max_top = *range.second;
+  if (f_min_top <= 0) {
+    G4Exception("HeightFieldSolid::HeightFieldSolid()", "", FatalException,
+                ("Top of height field must be above z=0: " + name).c_str());
+  }
+  build_pyramid();
+  calculate_volume_and_area();
+}
+
+HeightFieldSolid *HeightFieldSolid::FromFile(const G4String &name,
+                                             const G4String &filename) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    G4Exception("HeightFieldSolid::FromFile()", "", FatalException,
+                ("Failed to open height field file " + filename).c_str());
+  }
+  char magic[8];
+  std::uint32_t version{0};
+  std::uint32_t nx{0};
+  std::uint32_t ny{0};
+  G4double length[2]{0, 0};
+  G4double body_height{0};
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char *>(&version), sizeof(version));
+  file.read(reinterpret_cast<char *>(&nx), sizeof(nx));
+  file.read(reinterpret_cast<char *>(&ny), sizeof(ny));
+  file.read(reinterpret_cast<char *>(length), sizeof(length));
+  file.read(reinterpret_cast<char *>(&body_height), sizeof(body_height));
+  if (!file || std::string(magic, 7) != "SC4HMAP" || version != 1) {
+    G4Exception("HeightFieldSolid::FromFile()", "", FatalException,
+                ("Not a height field file (version 1): " + filename).c_str());
+  }
+  std::vector<float> heights(static_cast<std::size_t>(nx) * ny);
+  file.read(reinterpret_cast<char *>(heights.data()),
+            static_cast<std::streamsize>(heights.size() * sizeof(float)));
+  if (!file) {
+    G4Exception("HeightFieldSolid::FromFile()", "", FatalException,
+                ("Height field file truncated: " + filename).c_str());
+  }
+  // python tool writes um, heights relative to top of body
+  for (auto &height : heights) {
+    height = static_cast<float>((height + body_height) * um);
+  }
+  return new HeightFieldSolid(name, static_cast<G4int>(nx),
+                              static_cast<G4int>(ny), length[0] * um,
+                              length[1] * um, std::move(heights));
+}
+
+void HeightFieldSolid::build_pyramid() {
+  const G4int cells_x = f_nx - 1;
+  const G4int cells_y = f_ny - 1;
+  f_levels.clear();
+  // level 0: blocks of 2x2 cells, from the grid points
+  MipLevel level;
+  level.nx = (cells_x + 1) / 2;
+  level.ny = (cells_y + 1) / 2;
+  level.min.resize(static_cast<std::size_t>(level.nx) * level.ny);
+  level.max.resize(level.min.size());
+  for (G4int by = 0; by < level.ny; ++by) {
+    for (G4int bx = 0; bx < level.nx; ++bx) {
+      float min = f_top[static_cast<std::size_t>(2 * by) * f_nx + 2 * bx];
+      float max = min;
+      for (G4int iy = 2 * by; iy <= std::min(2 * by + 2, f_ny - 1); ++iy) {
+        for (G4int ix = 2 * bx; ix <= std::min(2 * bx + 2, f_nx - 1); ++ix) {
+          const float height = f_top[static_cast<std::size_t>(iy) * f_nx + ix];
+          min = std::min(min, height);
+          max = std::max(max, height);
+        }
+      }
+      level.min[static_cast<std::size_t>(by) * level.nx + bx] = min;
+      level.max[static_cast<std::size_t>(by) * level.nx + bx] = max;
+    }
+  }
+  f_levels.push_back(std::move(level));
+  // further levels from the level below
+  while (f_levels.back().nx > 1 || f_levels.back().ny > 1) {
+    const MipLevel &below = f_levels.back();
+    MipLevel next;
+    next.nx = (below.nx + 1) / 2;
+    next.ny = (below.ny + 1) / 2;
+    next.min.resize(static_cast<std::size_t>(next.nx) * next.ny);
+    next.max.resize(next.min.size());
+    for (G4int by = 0; by < next.ny; ++by) {
+      for (G4int bx = 0; bx < next.nx; ++bx) {
+        float min = below.min[static_cast<std::size_t>(2 * by) * below.nx +
+                              2 * bx];
+        float max = below.max[static_cast<std::size_t>(2 * by) * below.nx +
+                              2 * bx];
+        for (G4int iy = 2 * by; iy < std::min(2 * by + 2, below.ny); ++iy) {
+          for (G4int ix = 2 * bx; ix < std::min(2 * bx + 2, below.nx); ++ix) {
+            const std::size_t idx = static_cast<std::size_t>(iy) * below.nx + ix;
+            min = std::min(min, below.min[idx]);
+            max = std::max(max, below.max[idx]);
+          }
+        }
+        next.min[static_cast<std::size_t>(by) * next.nx + bx] = min;
+        next.max[static_cast<std::size_t>(by) * next.nx + bx] = max;
+      }
+    }
+    f_levels.push_back(std::move(next));
+  }
+}
+
+void HeightFieldSolid::calculate_volume_and_area() {
+  const G4double cell_area = f_step_x * f_step_y;
+  f_cubic_volume = 0;
+  f_top_area = 0;
+  f_max_triangle_area = 0;
+  auto triangle_area = [this](const G4double dz_x, const G4double dz_y) {
+    return 0.5 * std::sqrt(dz_x * dz_x * f_step_y * f_step_y +
+                           dz_y * dz_y * f_step_x * f_step_x +
+                           f_step_x * f_step_x * f_step_y * f_step_y);
+  };
+  for (G4int iy = 0; iy < f_ny - 1; ++iy) {
+    for (G4int ix = 0; ix < f_nx - 1; ++ix) {
+      const G4double h00 = Top(ix, iy);
+      const G4double h10 = Top(ix + 1, iy);
+      const G4double h01 = Top(ix, iy + 1);
+      const G4double h11 = Top(ix + 1, iy + 1);
+      // two prisms below the triangles
+      f_cubic_volume += cell_area / 6. * (2. * h00 + h10 + 2. * h11 + h01);
+      const G4double lower = triangle_area(h10 - h00, h11 - h10);
+      const G4double upper = triangle_area(h11 - h01, h01 - h00);
+      f_top_area += lower + upper;
+      f_max_triangle_area = std::max({f_max_triangle_area, lower, upper});
+    }
+  }
+  for (G4double &area : f_wall_area) {
+    area = 0;
+  }
+  for (G4int iy = 0; iy < f_ny - 1; ++iy) {
+    f_wall_area[0] += 0.5 * (Top(0, iy) + Top(0, iy + 1)) * f_step_y;
+    f_wall_area[1] +=
+        0.5 * (Top(f_nx - 1, iy) + Top(f_nx - 1, iy + 1)) * f_step_y;
+  }
+  for (G4int ix = 0; ix < f_nx - 1; ++ix) {
+    f_wall_area[2] += 0.5 * (Top(ix, 0) + Top(ix + 1, 0)) * f_step_x;
+    f_wall_area[3] +=
+        0.5 * (Top(ix, f_ny - 1) + Top(ix + 1, f_ny - 1)) * f_step_x;
+  }
+  f_surface_area = 4. * f_half_x * f_half_y + f_wall_area[0] +
+                   f_wall_area[1] + f_wall_area[2] + f_wall_area[3] +
+                   f_top_area;
+}
+
+G4int HeightFieldSolid::CellX(const G4double x) const {
+  const auto ix = static_cast<G4int>(std::floor((x + f_half_x) / f_step_x));
+  return std::min(std::max(ix, 0), f_nx - 2);
+}
+
+G4int HeightFieldSolid::CellY(const G4double y) const {
+  const auto iy = static_cast<G4int>(std::floor((y + f_half_y) / f_step_y));
+  return std::min(std::max(iy, 0), f_ny - 2);
+}
+
+G4double HeightFieldSolid::HeightAt(const G4double x, const G4double y,
+                                    G4double *grad_x,
+                                    G4double *grad_y) const {
+  const G4int ix = CellX(x);
+  const G4int iy = CellY(y);
+  const G4double fx = (x - PointX(ix)) / f_step_x;
+  const G4double fy = (y - PointY(iy)) / f_step_y;
+  const G4double h00 = Top(ix, iy);
+  G4double dz_x{0};
+  G4double dz_y{0};
+  if (fx >= fy) {  // triangle (ix,iy), (ix+1,iy), (ix+1,iy+1)
+    dz_x = Top(ix + 1, iy) - h00;
+    dz_y = Top(ix + 1, iy + 1) - Top(ix + 1, iy);
+  } else {  // triangle (ix,iy), (ix+1,iy+1), (ix,iy+1)
+    dz_x = Top(ix + 1, iy + 1) - Top(ix, iy + 1);
+    dz_y = Top(ix, iy + 1) - h00;
+  }
+  if (grad_x != nullptr) {
+    *grad_x = dz_x / f_step_x;
+    *grad_y = dz_y / f_step_y;
+  }
+  return h00 + fx * dz_x + fy * dz_y;
+}
+
+G4ThreeVector HeightFieldSolid::TopNormal(const G4double x,
+                                          const G4double y) const {
+  G4double grad_x{0};
+  G4double grad_y{0};
+  HeightAt(x, y, &grad_x, &grad_y);
+  return G4ThreeVector(-grad_x, -grad_y, 1.).unit();
+}
+
+G4double HeightFieldSolid::TopDistance(const G4ThreeVector &p) const {
+  G4double grad_x{0};
+  G4double grad_y{0};
+  const G4double height = HeightAt(p.x(), p.y(), &grad_x, &grad_y);
+  return (p.z() - height) / std::sqrt(1. + grad_x * grad_x + grad_y * grad_y);
+}
+
+G4double HeightFieldSolid::TopSafety(const G4ThreeVector &p,
+                                     const G4bool above) const {
+  const G4int cells_x = f_nx - 1;
+  const G4int cells_y = f_ny - 1;
+  const G4int ix = CellX(p.x());
+  const G4int iy = CellY(p.y());
+  // distance to the block edges inside the patch, the top surface outside of
+  // the block is at least this far away
+  auto edge_distance = [&](const G4int shift) {
+    const G4int first_x = (ix >> shift) << shift;
+    const G4int first_y = (iy >> shift) << shift;
+    const G4int last_x = std::min(first_x + (1 << shift), cells_x);
+    const G4int last_y = std::min(first_y + (1 << shift), cells_y);
+    G4double distance{kInfinity};
+    if (first_x > 0) distance = std::min(distance, p.x() - PointX(first_x));
+    if (last_x < cells_x) distance = std::min(distance, PointX(last_x) - p.x());
+    if (first_y > 0) distance = std::min(distance, p.y() - PointY(first_y));
+    if (last_y < cells_y) distance = std::min(distance, PointY(last_y) - p.y());
+    return distance;
+  };
+
+  const G4double corners[4] = {Top(ix, iy), Top(ix + 1, iy), Top(ix, iy + 1),
+                               Top(ix + 1, iy + 1)};
+  const G4double cell_min = *std::min_element(corners, corners + 4);
+  const G4double cell_max = *std::max_element(corners, corners + 4);
+  G4double safety =
+      std::min(above ? p.z() - cell_max : cell_min - p.z(), edge_distance(0));
+  for (std::size_t level = 0; level < f_levels.size(); ++level) {
+    const G4int shift = static_cast<G4int>(level) + 1;
+    const MipLevel &mip = f_levels[level];
+    const std::size_t idx =
+        static_cast<std::size_t>(iy >> shift) * mip.nx + (ix >> shift);
+    const G4double bound = std::min(
+        above ? p.z() - mip.max[idx] : mip.min[idx] - p.z(), edge_distance(shift));
+    safety = std::max(safety, bound);
+  }
+  return safety;
+}
+
+G4bool HeightFieldSolid::ClipBox(const G4ThreeVector &p, const G4ThreeVector &v,
+                                 G4double &t_min, G4double &t_max,
+                                 G4int &exit_axis) const {
+  const G4double lo[3] = {-f_half_x, -f_half_y, 0.};
+  const G4double hi[3] = {f_half_x, f_half_y, f_max_top};
+  t_min = -kInfinity;
+  t_max = kInfinity;
+  exit_axis = -1;
+  for (G4int axis = 0; axis < 3; ++axis) {
+    if (v[axis] == 0.) {
+      if (p[axis] < lo[axis] || p[axis] > hi[axis]) {
+        return false;
+      }
+      continue;
+    }
+    G4double t_lo = (lo[axis] - p[axis]) / v[axis];
+    G4double t_hi = (hi[axis] - p[axis]) / v[axis];
+    if (t_lo > t_hi) {
+      std::swap(t_lo, t_hi);
+    }
+    t_min = std::max(t_min, t_lo);
+    if (t_hi < t_max) {
+      t_max = t_hi;
+      exit_axis = axis;
+    }
+  }
+  return t_min <= t_max;
+}
+
+G4double HeightFieldSolid::BlockExit(const G4ThreeVector &p,
+                                     const G4ThreeVector &v, const G4int shift,
+                                     const G4int ix, const G4int iy) const {
+  const G4int first_x = (ix >> shift) << shift;
+  const G4int first_y = (iy >> shift) << shift;
+  const G4double t_x =
+      axis_exit(p.x(), v.x(), -f_half_x, f_step_x, first_x,
+                std::min(first_x + (1 << shift), f_nx - 1));
+  const G4double t_y =
+      axis_exit(p.y(), v.y(), -f_half_y, f_step_y, first_y,
+                std::min(first_y + (1 << shift), f_ny - 1));
+  return std::min(t_x, t_y);
+}
+
+G4double HeightFieldSolid::MarchTop(const G4ThreeVector &p,
+                                    const G4ThreeVector &v,
+                                    const G4double t_start,
+                                    const G4double t_end,
+                                    const G4bool entering) const {
+  G4double t{t_start};
+  while (t < t_end) {
+    // cell ahead of the ray at t
+    G4int ix = CellX(p.x() + t * v.x());
+    G4int iy = CellY(p.y() + t * v.y());
+    G4double t_x = axis_exit(p.x(), v.x(), -f_half_x, f_step_x, ix, ix + 1);
+    if (t_x <= t) {
+      ix += v.x() > 0. ? 1 : -1;
+      if (ix < 0 || ix > f_nx - 2) {
+        return kInfinity;
+      }
+      t_x = axis_exit(p.x(), v.x(), -f_half_x, f_step_x, ix, ix + 1);
+    }
+    G4double t_y = axis_exit(p.y(), v.y(), -f_half_y, f_step_y, iy, iy + 1);
+    if (t_y <= t) {
+      iy += v.y() > 0. ? 1 : -1;
+      if (iy < 0 || iy > f_ny - 2) {
+        return kInfinity;
+      }
+      t_y = axis_exit(p.y(), v.y(), -f_half_y, f_step_y, iy, iy + 1);
+    }
+
+    // skip the largest block the ray passes completely above/below
+    G4bool skipped{false};
+    for (auto level = static_cast<G4int>(f_levels.size()) - 1; level >= 0;
+         --level) {
+      const G4int shift = level + 1;
+      const MipLevel &mip = f_levels[static_cast<std::size_t>(level)];
+      const std::size_t idx =
+          static_cast<std::size_t>(iy >> shift) * mip.nx + (ix >> shift);
+      const G4double t_block = std::min(BlockExit(p, v, shift, ix, iy), t_end);
+      const G4double z_start = p.z() + t * v.z();
+      const G4double z_end = p.z() + t_block * v.z();
+      const G4bool clear =
+          entering ? std::min(z_start, z_end) > mip.max[idx] + f_half_tolerance
+                   : std::max(z_start, z_end) < mip.min[idx] - f_half_tolerance;
+      if (clear) {
+        t = t_block;
+        skipped = true;
+        break;
+      }
+    }
+    if (skipped) {
+      continue;
+    }
+
+    // test both triangles of the cell, split at the diagonal
+    const G4double t_cell = std::min({t_x, t_y, t_end});
+    const G4double fx_0 = (p.x() - PointX(ix)) / f_step_x;
+    const G4double fy_0 = (p.y() - PointY(iy)) / f_step_y;
+    const G4double fx_v = v.x() / f_step_x;
+    const G4double fy_v = v.y() / f_step_y;
+    G4double cuts[3] = {t, t_cell, t_cell};
+    if (fx_v != fy_v) {
+      const G4double t_diagonal = (fy_0 - fx_0) / (fx_v - fy_v);
+      if (t_diagonal > t && t_diagonal < t_cell) {
+        cuts[1] = t_diagonal;
+      }
+    }
+    const G4double h00 = Top(ix, iy);
+    for (G4int piece = 0; piece < 2; ++piece) {
+      const G4double a = cuts[piece];
+      const G4double b = cuts[piece + 1];
+      if (b <= a) {
+        continue;
+      }
+      const G4double t_mid = 0.5 * (a + b);
+      G4double dz_x{0};
+      G4double dz_y{0};
+      if (fx_0 + t_mid * fx_v >= fy_0 + t_mid * fy_v) {
+        dz_x = Top(ix + 1, iy) - h00;
+        dz_y = Top(ix + 1, iy + 1) - Top(ix + 1, iy);
+      } else {
+        dz_x = Top(ix + 1, iy + 1) - Top(ix, iy + 1);
+        dz_y = Top(ix, iy + 1) - h00;
+      }
+      auto gap = [&](const G4double time) {
+        return p.z() + time * v.z() -
+               (h00 + (fx_0 + time * fx_v) * dz_x + (fy_0 + time * fy_v) * dz_y);
+      };
+      const G4double gap_a = gap(a);
+      const G4double gap_b = gap(b);
+      // rays touching the surface within tolerance do not cross it
+      const G4bool crossing =
+          entering ? gap_b < -f_half_tolerance && gap_b < gap_a
+                   : gap_b > f_half_tolerance && gap_b > gap_a;
+      if (crossing) {
+        const G4double root = a + gap_a / (gap_a - gap_b) * (b - a);
+        return std::max(root, t_start);
+      }
+    }
+    t = t_cell;
+  }
+  return kInfinity;
+}
+
+EInside HeightFieldSolid::Inside(const G4ThreeVector &p) const {
+  if (std::fabs(p.x()) > f_half_x + f_half_tolerance ||
+      std::fabs(p.y()) > f_half_y + f_half_tolerance ||
+      p.z() < -f_half_tolerance || p.z() > f_max_top + f_half_tolerance) {
+    return kOutside;
+  }
+  const G4double distance =
+      std::max({std::fabs(p.x()) - f_half_x, std::fabs(p.y()) - f_half_y,
+                -p.z(), TopDistance(p)});
+  if (distance < -f_half_tolerance) {
+    return kInside;
+  }
+  if (distance > f_half_tolerance) {
+    return kOutside;
+  }
+  return kSurface;
+}
+
+G4ThreeVector HeightFieldSolid::SurfaceNormal(const G4ThreeVector &p) const {
+  const G4double distances[5] = {
+      std::fabs(std::fabs(p.x()) - f_half_x),
+      std::fabs(std::fabs(p.y()) - f_half_y), std::fabs(p.z()),
+      std::fabs(TopDistance(p)), kInfinity};
+  const G4ThreeVector normals[4] = {G4ThreeVector(p.x() < 0 ? -1 : 1, 0, 0),
+                                    G4ThreeVector(0, p.y() < 0 ? -1 : 1, 0),
+                                    G4ThreeVector(0, 0, -1),
+                                    TopNormal(p.x(), p.y())};
+  G4ThreeVector sum(0, 0, 0);
+  G4int nearest{4};
+  for (G4int i = 0; i < 4; ++i) {
+    if (distances[i] <= f_half_tolerance) {
+      sum += normals[i];
+    }
+    if (distances[i] < distances[nearest]) {
+      nearest = i;
+    }
+  }
+  if (sum.mag2() > 0.) {
+    return sum.unit();
+  }
+  return normals[nearest];
+}
+
+G4double HeightFieldSolid::DistanceToIn(const G4ThreeVector &p,
+                                        const G4ThreeVector &v) const {
+  G4double t_min{0};
+  G4double t_max{0};
+  G4int exit_axis{-1};
+  if (!ClipBox(p, v, t_min, t_max, exit_axis) ||
+      t_max <= std::max(t_min, 0.) + f_half_tolerance) {
+    return kInfinity;
+  }
+  const G4double t_start = std::max(t_min, 0.);
+  if (t_min > -f_half_tolerance) {
+    // ray enters the bounding box, below the top surface this is a wall or
+    // the bottom
+    const G4ThreeVector entry = p + t_start * v;
+    if (entry.z() < HeightAt(entry.x(), entry.y())) {
+      return t_start < f_half_tolerance ? 0. : t_start;
+    }
+  }
+  const G4double t = MarchTop(p, v, t_start, t_max, true);
+  if (t == kInfinity) {
+    return kInfinity;
+  }
+  return t < f_half_tolerance ? 0. : t;
+}
+
+G4double HeightFieldSolid::DistanceToIn(const G4ThreeVector &p) const {
+  const G4double distance_box =
+      std::max({std::fabs(p.x()) - f_half_x, std::fabs(p.y()) - f_half_y,
+                -p.z(), p.z() - f_max_top});
+  if (distance_box > 0.) {
+    return distance_box;
+  }
+  const G4double safety = TopSafety(p, true);
+  return safety > 0. ? safety : 0.;
+}
+
+G4double HeightFieldSolid::DistanceToOut(const G4ThreeVector &p,
+                                         const G4ThreeVector &v,
+                                         const G4bool calcNorm,
+                                         G4bool *validNorm,
+                                         G4ThreeVector *n) const {
+  G4double t_min{0};
+  G4double t_max{0};
+  G4int exit_axis{-1};
+  if (!ClipBox(p, v, t_min, t_max, exit_axis) || t_max < 0.) {
+    t_max = 0.;
+  }
+  const G4double t_top = MarchTop(p, v, 0., t_max, false);
+  G4double distance{t_max};
+  G4ThreeVector normal;
+  G4bool valid{true};
+  if (t_top < t_max || (exit_axis == 2 && v.z() > 0.) || exit_axis < 0) {
+    distance = std::min(t_top, t_max);
+    const G4ThreeVector exit = p + distance * v;
+    normal = TopNormal(exit.x(), exit.y());
+    valid = false;  // top surface is not convex
+  } else {
+    normal[exit_axis] = v[exit_axis] > 0. ? 1. : -1.;
+  }
+  if (calcNorm) {
+    *validNorm = valid;
+    *n = normal;
+  }
+  return distance < f_half_tolerance ? 0. : distance;
+}
+
+G4double HeightFieldSolid::DistanceToOut(const G4ThreeVector &p) const {
+  const G4double safety =
+      std::min({f_half_x - std::fabs(p.x()), f_half_y - std::fabs(p.y()),
+                p.z(), TopSafety(p, false)});
+  return safety > 0. ? safety : 0.;
+}
+
+void HeightFieldSolid::BoundingLimits(G4ThreeVector &pMin,
+                                      G4ThreeVector &pMax) const {
+  pMin.set(-f_half_x, -f_half_y, 0.);
+  pMax.set(f_half_x, f_half_y, f_max_top);
+}
+
+G4bool HeightFieldSolid::CalculateExtent(const EAxis pAxis,
+                                         const G4VoxelLimits &pVoxelLimit,
+                                         const G4AffineTransform &pTransform,
+                                         G4double &pMin, G4double &pMax) const {
+  G4ThreeVector bmin;
+  G4ThreeVector bmax;
+  BoundingLimits(bmin, bmax);
+  G4BoundingEnvelope bbox(bmin, bmax);
+  return bbox.CalculateExtent(pAxis, pVoxelLimit, pTransform, pMin, pMax);
+}
+
+G4ThreeVector HeightFieldSolid::GetPointOnTopSurface(
+    G4ThreeVector &normal) const {
+  // cell and triangle by rejection on the triangle area
+  G4int ix{0};
+  G4int iy{0};
+  G4bool lower{true};
+  G4double dz_x{0};
+  G4double dz_y{0};
+  G4double area{0};
+  do {
+    ix = std::min(static_cast<G4int>(G4UniformRand() * (f_nx - 1)), f_nx - 2);
+    iy = std::min(static_cast<G4int>(G4UniformRand() * (f_ny - 1)), f_ny - 2);
+    lower = G4UniformRand() < 0.5;
+    if (lower) {
+      dz_x = Top(ix + 1, iy) - Top(ix, iy);
+      dz_y = Top(ix + 1, iy + 1) - Top(ix + 1, iy);
+    } else {
+      dz_x = Top(ix + 1, iy + 1) - Top(ix, iy + 1);
+      dz_y = Top(ix, iy + 1) - Top(ix, iy);
+    }
+    area = 0.5 * std::sqrt(dz_x * dz_x * f_step_y * f_step_y +
+                           dz_y * dz_y * f_step_x * f_step_x +
+                           f_step_x * f_step_x * f_step_y * f_step_y);
+  } while (G4UniformRand() * f_max_triangle_area > area);
+
+  G4double a = G4UniformRand();
+  G4double b = G4UniformRand();
+  if (a + b > 1.) {
+    a = 1. - a;
+    b = 1. - b;
+  }
+  const G4double fx = lower ? a + b : a;
+  const G4double fy = lower ? b : a + b;
+  normal = G4ThreeVector(-dz_x / f_step_x, -dz_y / f_step_y, 1.).unit();
+  return {PointX(ix) + fx * f_step_x, PointY(iy) + fy * f_step_y,
+          Top(ix, iy) + fx * dz_x + fy * dz_y};
+}
+
+G4ThreeVector HeightFieldSolid::GetPointOnSurface() const {
+  G4double select = G4UniformRand() * f_surface_area;
+  if (select < f_top_area) {
+    G4ThreeVector normal;
+    return GetPointOnTopSurface(normal);
+  }
+  select -= f_top_area;
+  const G4double bottom_area = 4. * f_half_x * f_half_y;
+  if (select < bottom_area) {
+    return {(2. * G4UniformRand() - 1.) * f_half_x,
+            (2. * G4UniformRand() - 1.) * f_half_y, 0.};
+  }
+  select -= bottom_area;
+  G4int wall{0};
+  while (wall < 3 && select >= f_wall_area[wall]) {
+    select -= f_wall_area[wall];
+    ++wall;
+  }
+  // uniform on the wall by rejection below the upper edge
+  const G4bool along_y = wall < 2;
+  while (true) {
+    const G4double s = G4UniformRand();
+    const G4double z = G4UniformRand() * f_max_top;
+    G4ThreeVector point;
+    if (along_y) {
+      point.set(wall == 0 ? -f_half_x : f_half_x,
+                -f_half_y + s * 2. * f_half_y, z);
+    } else {
+      point.set(-f_half_x + s * 2. * f_half_x,
+                wall == 2 ? -f_half_y : f_half_y, z);
+    }
+    if (z <= HeightAt(point.x(), point.y())) {
+      return point;
+    }
+  }
+}
+
+G4GeometryType HeightFieldSolid::GetEntityType() const {
+  return {"HeightFieldSolid"};
+}
+
+G4VSolid *HeightFieldSolid::Clone() const {
+  return new HeightFieldSolid(*this);
+}
+
+std::size_t HeightFieldSolid::AllocatedMemory() const {
+  std::size_t memory = sizeof(*this) + f_top.capacity() * sizeof(float);
+  for (const auto &level : f_levels) {
+    memory += sizeof(level) +
+              (level.min.capacity() + level.max.capacity()) * sizeof(float);
+  }
+  return memory;
+}
+
+std::ostream &HeightFieldSolid::StreamInfo(std::ostream &os) const {
+  const G4int old_precision = os.precision(16);
+  os << "-----------------------------------------------------------\n"
+     << "    *** Dump for solid - " << GetName() << " ***\n"
+     << "    ===================================================\n"
+     << " Solid type: HeightFieldSolid\n"
+     << " Parameters: \n"
+     << "   grid points x  : " << f_nx << "\n"
+     << "   grid points y  : " << f_ny << "\n"
+     << "   half length x  : " << f_half_x / mm << " mm \n"
+     << "   half length y  : " << f_half_y / mm << " mm \n"
+     << "   min height     : " << f_min_top / mm << " mm \n"
+     << "   max height     : " << f_max_top / mm << " mm \n"
+     << "   pyramid levels : " << f_levels.size() << "\n"
+     << "   memory         : " << AllocatedMemory() / 1e6 << " MB \n"
+     << "-----------------------------------------------------------\n";
+  os.precision(old_precision);
+  return os;
+}
+
+void HeightFieldSolid::DescribeYourselfTo(G4VGraphicsScene &scene) const {
+  scene.AddSolid(*this);
+}
+
+G4Polyhedron *HeightFieldSolid::CreatePolyhedron() const {
+  const G4int n_vertices = f_nx * f_ny + 4;
+  const G4int n_facets =
+      2 * (f_nx - 1) * (f_ny - 1) + 2 * f_nx + 2 * f_ny + 1;
+  auto *polyhedron = new G4PolyhedronArbitrary(n_vertices, n_facets);
+  for (G4int iy = 0; iy < f_ny; ++iy) {
+    for (G4int ix = 0; ix < f_nx; ++ix) {
+      polyhedron->AddVertex(G4ThreeVector(PointX(ix), PointY(iy), Top(ix, iy)));
+    }
+  }
+  // bottom corners
+  const G4int b0 = f_nx * f_ny + 1;  // (-x,-y)
+  const G4int b1 = b0 + 1;           // (+x,-y)
+  const G4int b2 = b0 + 2;           // (+x,+y)
+  const G4int b3 = b0 + 3;           // (-x,+y)
+  polyhedron->AddVertex(G4ThreeVector(-f_half_x, -f_half_y, 0));
+  polyhedron->AddVertex(G4ThreeVector(f_half_x, -f_half_y, 0));
+  polyhedron->AddVertex(G4ThreeVector(f_half_x, f_half_y, 0));
+  polyhedron->AddVertex(G4ThreeVector(-f_half_x, f_half_y, 0));
+
+  auto vertex = [this](const G4int ix, const G4int iy) {
+    return iy * f_nx + ix + 1;
+  };
+  for (G4int iy = 0; iy < f_ny - 1; ++iy) {
+    for (G4int ix = 0; ix < f_nx - 1; ++ix) {
+      polyhedron->AddFacet(vertex(ix, iy), vertex(ix + 1, iy),
+                           vertex(ix + 1, iy + 1));
+      polyhedron->AddFacet(vertex(ix, iy), vertex(ix + 1, iy + 1),
+                           vertex(ix, iy + 1));
+    }
+  }
+  // walls as triangle fans from a bottom corner, counterclockwise from outside
+  for (G4int ix = 0; ix < f_nx - 1; ++ix) {
+    polyhedron->AddFacet(b0, vertex(ix + 1, 0), vertex(ix, 0));
+    polyhedron->AddFacet(b2, vertex(ix, f_ny - 1), vertex(ix + 1, f_ny - 1));
+  }
+  polyhedron->AddFacet(b0, b1, vertex(f_nx - 1, 0));
+  polyhedron->AddFacet(b2, b3, vertex(0, f_ny - 1));
+  for (G4int iy = 0; iy < f_ny - 1; ++iy) {
+    polyhedron->AddFacet(b3, vertex(0, iy), vertex(0, iy + 1));
+    polyhedron->AddFacet(b1, vertex(f_nx - 1, iy + 1), vertex(f_nx - 1, iy));
+  }
+  polyhedron->AddFacet(b3, b0, vertex(0, 0));
+  polyhedron->AddFacet(b1, b2, vertex(f_nx - 1, f_ny - 1));
+  polyhedron->AddFacet(b0, b3, b2, b1);
+  polyhedron->SetReferences();
+  return polyhedron;
+}
+
+}  // namespace Surface
@@ -0,0 +1,166 @@
+/**
+ * @brief Definition of HeightFieldSolid class
+ * @author agent
+ * @date 2026-10-17
+ * @file HeightFieldSolid.hh
+ */
+
+#ifndef SURFACE_HEIGHTFIELDSOLID_HH
+#define SURFACE_HEIGHTFIELDSOLID_HH
+
+#include <vector>
+
+#include "G4ThreeVector.hh"
+#include "G4VSolid.hh"
+
+namespace Surface {
+/**
+ * @brief HeightFieldSolid is a body whose top surface is given by heights on a
+ * regular xy grid.
+ * @details Same triangulation as the tessellated mesh written by the python
+ * tool: nx * ny grid points spanning [-length_x/2, length_x/2] x
+ * [-length_y/2, length_y/2], two triangles per grid cell split along the
+ * diagonal (ix,iy)-(ix+1,iy+1), vertical walls and a flat bottom. The solid is
+ * shifted by the body height compared to the mesh, its bottom is at z=0
+ * instead of z=-body_height. LogicalSurface places both by their bounding
+ * limits, so the placed geometry is the same.
+ * Heights are stored as float, together with a min/max pyramid over blocks of
+ * 2^(level+1) cells. Rays walk the cells with a 2D DDA and skip every block
+ * they pass above (DistanceToIn) or below (DistanceToOut).
+ */
+class HeightFieldSolid : public G4VSolid {
+ public:
+  /**
+   * @param heights z of the top surface, row major (index = iy * nx + ix),
+   * all > 0
+   */
+  HeightFieldSolid(const G4String &name, G4int nx, G4int ny, G4double length_x,
+                   G4double length_y, std::vector<float> heights);
+  ~HeightFieldSolid() override = default;
+
+  /**
+   * @brief Reads a height field file written by HeightFieldWriter.py
+   * @details Binary, little endian: char[8] "SC4HMAP", uint32 version,
+   * uint32 nx, uint32 ny, float64 length_x, length_y, body_height (um),
+   * float32 height[ny][nx] (um, relative to top of body)
+   */
+  static HeightFieldSolid *FromFile(const G4String &name,
+                                    const G4String &filename);
+
+  EInside Inside(const G4ThreeVector &p) const override;
+  G4ThreeVector SurfaceNormal(const G4ThreeVector &p) const override;
+  G4double DistanceToIn(const G4ThreeVector &p,
+                        const G4ThreeVector &v) const override;
+  G4double DistanceToIn(const G4ThreeVector &p) const override;
+  G4double DistanceToOut(const G4ThreeVector &p, const G4ThreeVector &v,
+                         G4bool calcNorm = false, G4bool *validNorm = nullptr,
+                         G4ThreeVector *n = nullptr) const override;
+  G4double DistanceToOut(const G4ThreeVector &p) const override;
+
+  void BoundingLimits(G4ThreeVector &pMin, G4ThreeVector &pMax) const override;
+  G4bool CalculateExtent(EAxis pAxis, const G4VoxelLimits &pVoxelLimit,
+                         const G4AffineTransform &pTransform, G4double &pMin,
+                         G4double &pMax) const override;
+
+  G4double GetCubicVolume() override { return f_cubic_volume; }
+  G4double GetSurfaceArea() override { return f_surface_area; }
+  G4ThreeVector GetPointOnSurface() const override;
+
+  G4GeometryType GetEntityType() const override;
+  G4VSolid *Clone() const override;
+  std::ostream &StreamInfo(std::ostream &os) const override;
+
+  void DescribeYourselfTo(G4VGraphicsScene &scene) const override;
+  G4Polyhedron *CreatePolyhedron() const override;
+
+  /**
+   * @brief Area weighted random point on the top surface (without walls and
+   * bottom), outward normal stored in normal
+   */
+  G4ThreeVector GetPointOnTopSurface(G4ThreeVector &normal) const;
+  inline G4double GetTopSurfaceArea() const { return f_top_area; }
+
+  inline G4int GetNx() const { return f_nx; }
+  inline G4int GetNy() const { return f_ny; }
+  inline G4double GetHalfLengthX() const { return f_half_x; }
+  inline G4double GetHalfLengthY() const { return f_half_y; }
+  inline G4double GetMaxHeight() const { return f_max_top; }
+  /// Memory of heights and pyramid in bytes
+  std::size_t AllocatedMemory() const;
+
+ private:
+  /// min/max of the top surface over blocks of 2^(level+1) x 2^(level+1) cells
+  struct MipLevel {
+    G4int nx;
+    G4int ny;
+    std::vector<float> min;
+    std::vector<float> max;
+  };
+
+  inline G4double Top(G4int ix, G4int iy) const {
+    return f_top[static_cast<std::size_t>(iy) * f_nx + ix];
+  }
+  inline G4double PointX(G4int ix) const { return -f_half_x + ix * f_step_x; }
+  inline G4double PointY(G4int iy) const { return -f_half_y + iy * f_step_y; }
+  G4int CellX(G4double x) const;
+  G4int CellY(G4double y) const;
+
+  /**
+   * @brief Height of top surface at (x,y), gradient of the triangle in
+   * gradient (x,y components)
+   */
+  G4double HeightAt(G4double x, G4double y, G4double *grad_x = nullptr,
+                    G4double *grad_y = nullptr) const;
+  G4ThreeVector TopNormal(G4double x, G4double y) const;
+  /// signed distance to the plane of the triangle below/above p
+  G4double TopDistance(const G4ThreeVector &p) const;
+
+  /**
+   * @brief Lower bound of the distance from p to the top surface
+   * @param above true: p is above the surface, false: p is below
+   */
+  G4double TopSafety(const G4ThreeVector &p, G4bool above) const;
+
+  /**
+   * @brief First t in [t_start, t_end] where the ray crosses the top surface
+   * @param entering true: crossing from above to below, false: from below to
+   * above
+   * @return kInfinity if no crossing
+   */
+  G4double MarchTop(const G4ThreeVector &p, const G4ThreeVector &v,
+                    G4double t_start, G4double t_end, G4bool entering) const;
+  /// t at which the ray leaves the block of 2^shift cells containing cell
+  G4double BlockExit(const G4ThreeVector &p, const G4ThreeVector &v,
+                     G4int shift, G4int ix, G4int iy) const;
+
+  /**
+   * @brief Clips ray to the bounding box of the solid
+   * @param exit_axis axis (0,1,2) of the face the ray leaves through
+   */
+  G4bool ClipBox(const G4ThreeVector &p, const G4ThreeVector &v,
+                 G4double &t_min, G4double &t_max, G4int &exit_axis) const;
+
+  void build_pyramid();
+  void calculate_volume_and_area();
+
+ private:
+  G4int f_nx;
+  G4int f_ny;
+  G4double f_half_x;
+  G4double f_half_y;
+  G4double f_step_x;  ///< distance of grid points
+  G4double f_step_y;
+  std::vector<float> f_top;  ///< z of top surface at grid points
+  std::vector<MipLevel> f_levels;
+  G4double f_min_top{0};
+  G4double f_max_top{0};
+  G4double f_cubic_volume{0};
+  G4double f_surface_area{0};
+  G4double f_top_area{0};
+  G4double f_wall_area[4]{0, 0, 0, 0};  ///< -x, +x, -y, +y
+  G4double f_max_triangle_area{0};
+  G4double f_half_tolerance;
+};
+}  // namespace Surface
+
+#endif  // SURFACE_HEIGHTFIELDSOLID_HH
@@ -8,24 +8,35 @@
 #include <utility>
 
 #include "LogicalSurface.hh"
+#include "G4Box.hh"
 #include "G4GDMLParser.hh"
 #include "G4SolidStore.hh"
 #include "G4PVPlacement.hh"
+#include "G4PVReplica.hh"
 #include "G4Exception.hh"
 #include "Randomize.hh"
 #include <numeric>
 
 namespace Surface {
 
-LogicalSurface::LogicalSurface(G4String name, G4String  gdml_filename,
+LogicalSurface::LogicalSurface(G4String name, G4String filename,
                                G4int nx, G4int ny, G4Material* material,
                                G4Material* envelope_material,
-                               VerboseLevel verbose_lvl)
-    : f_name(std::move(name)), f_gdml_filename(std::move(gdml_filename)),
-      f_nx(nx), f_ny(ny),
+                               VerboseLevel verbose_lvl,
+                               PlacementMode placement_mode,
+                               G4bool check_overlaps)
+    : f_name(std::move(name)), f_filename(std::move(filename)),
+      f_nx(nx), f_ny(ny), f_placement_mode(placement_mode),
+      f_check_overlaps(check_overlaps),
       f_material(material), f_envelope_material(envelope_material),
       f_logger("LogicalSurfaceVolume", verbose_lvl) {
-  load_gdml();
+  if (has_extension(f_filename, ".hmap")) {
+    load_height_field();
+  } else if (has_extension(f_filename, ".smesh")) {
+    load_mesh();
+  } else {
+    load_gdml();
+  }
   place_surface_element_inside_volume();
   f_logger.WriteInfo([this]{return this->information();});
 }
@@ -34,28 +45,59 @@ void LogicalSurface::load_gdml() {
   G4GDMLParser parser;
   const G4bool validate_gdml{false};
   //validation should be done by the python module generating the gdml file
-  parser.Read(f_gdml_filename, validate_gdml);
+  parser.Read(f_filename, validate_gdml);
   const G4SolidStore *store = G4SolidStore::GetInstance();
   G4VSolid *importedSolid = store->back();
   if(!importedSolid){
     G4Exception("DetectorConstruction::Construct()",
                 "",FatalException,"Failed to retrieve solid from GDML!");
   }
-  f_logger.WriteDebugInfo("Solid loaded from GDML file " + f_gdml_filename);
+  f_logger.WriteDebugInfo("Solid loaded from GDML file " + f_filename);
   f_surface_element = dynamic_cast<G4TessellatedSolid*>(importedSolid);
+  if(!f_surface_element){
+    G4Exception("LogicalSurface::load_gdml()",
+                "",FatalException,"Solid from GDML is not tessellated!");
+  }
 }
 
-void LogicalSurface::place_surface_element_inside_volume() {
-  const double extend_x = f_surface_element->GetMaxXExtent();
-  const double extend_y = f_surface_element->GetMaxYExtent();
-  const double extend_z = f_surface_element->GetMaxXExtent();
+void LogicalSurface::load_mesh() {
+  const MeshFile mesh(f_filename);
+  f_surface_element = mesh.BuildTessellatedSolid(f_name + "_mesh");
+  f_logger.WriteDebugInfo("Solid loaded from mesh file " + f_filename);
+}
+
+G4bool LogicalSurface::has_extension(const G4String &filename,
+                                     const G4String &extension) {
+  return filename.size() > extension.size() &&
+         filename.compare(filename.size() - extension.size(),
+                          extension.size(), extension) == 0;
+}
+
+void LogicalSurface::load_height_field() {
+  f_height_field = HeightFieldSolid::FromFile(f_name + "_height_field",
+                                              f_filename);
+  f_logger.WriteDebugInfo("Solid loaded from height field file " + f_filename);
+}
 
-  const int nx{f_nx};
-  const int ny{f_ny};
+G4VSolid *LogicalSurface::surface_solid() const {
+  if (f_height_field) {
+    return f_height_field;
+  }
+  return f_surface_element;
+}
+
+void LogicalSurface::place_surface_element_inside_volume() {
+  G4ThreeVector extend_min;
+  G4ThreeVector extend_max;
+  surface_solid()->BoundingLimits(extend_min, extend_max);
+  const ElementFrame frame = element_frame(extend_min, extend_max);
+  f_extend_x = frame.half_size.x();
+  f_extend_y = frame.half_size.y();
+  f_element_offset = frame.offset;
 
-  const G4double envelope_size_x = extend_x * nx;
-  const G4double envelope_size_y = extend_y * ny;
-  const G4double envelope_size_z = extend_z;
+  const G4double envelope_size_x = f_extend_x * f_nx;
+  const G4double envelope_size_y = f_extend_y * f_ny;
+  const G4double envelope_size_z = frame.half_size.z();
   f_shift_to_zero = envelope_size_z;
 
   auto *envelope_solid = new G4Box(f_name + "_SD",envelope_size_x,
@@ -65,25 +107,68 @@ void LogicalSurface::place_surface_element_inside_volume() {
                                          f_envelope_material,
                                          f_name + "_envelope");
 
-  auto *logical_surface_element = new G4LogicalVolume(f_surface_element,
+  auto *logical_surface_element = new G4LogicalVolume(surface_solid(),
                                                       f_material,
                                                       f_name);
+  if (f_placement_mode == PlacementMode::Replica) {
+    place_replica(logical_surface_element);
+    return;
+  }
 //place surface element inside envelope
-  for(int ix=0; ix < nx; ix++){
-    for(int iy=0; iy < ny; iy++){
-      G4ThreeVector surfacePlacement{-envelope_size_x + extend_x + 2 * ix * extend_x,
-                                     -envelope_size_y + extend_y + 2 * iy * extend_y,
-                                     -envelope_size_z};
+  for(int ix=0; ix < f_nx; ix++){
+    for(int iy=0; iy < f_ny; iy++){
+      const auto idx = static_cast<size_t>(ix * f_ny + iy);
       auto name = "LogicalSurface_"
                   + std::to_string(ix) + "_"
                   + std::to_string(iy);
 
-      new G4PVPlacement(nullptr,surfacePlacement,logical_surface_element,
-                        name,f_logical_envelope,false,0,true);
+      new G4PVPlacement(nullptr,element_position(idx),logical_surface_element,
+                        name,f_logical_envelope,false,0,f_check_overlaps);
     }
   }
 }
 
+LogicalSurface::ElementFrame LogicalSurface::element_frame(
+    const G4ThreeVector &extend_min, const G4ThreeVector &extend_max) {
+  ElementFrame frame;
+  frame.half_size = (extend_max - extend_min) / 2;
+  frame.offset = -(extend_max + extend_min) / 2;
+  frame.offset.setZ(-frame.half_size.z() - extend_min.z());
+  return frame;
+}
+
+void LogicalSurface::place_replica(G4LogicalVolume *logical_surface_element) {
+  // envelope is sliced along x, each slice along y, every cell holds one
+  // element: one physical volume per axis instead of one per element
+  const G4double envelope_size_y = f_extend_y * f_ny;
+  const G4double envelope_size_z = f_shift_to_zero;
+  auto *slice_solid = new G4Box(f_name + "_slice_x", f_extend_x,
+                                envelope_size_y, envelope_size_z);
+  auto *logical_slice = new G4LogicalVolume(slice_solid, f_envelope_material,
+                                            f_name + "_slice_x");
+  new G4PVReplica(f_name + "_slices_x", logical_slice, f_logical_envelope,
+                  kXAxis, f_nx, 2 * f_extend_x);
+
+  auto *cell_solid = new G4Box(f_name + "_cell", f_extend_x, f_extend_y,
+                               envelope_size_z);
+  auto *logical_cell = new G4LogicalVolume(cell_solid, f_envelope_material,
+                                           f_name + "_cell");
+  new G4PVReplica(f_name + "_slices_y", logical_cell, logical_slice,
+                  kYAxis, f_ny, 2 * f_extend_y);
+
+  new G4PVPlacement(nullptr, f_element_offset,
+                    logical_surface_element, "LogicalSurface", logical_cell,
+                    false, 0, f_check_overlaps);
+}
+
+G4ThreeVector LogicalSurface::element_position(const size_t idx) const {
+  const auto ix = static_cast<G4int>(idx) / f_ny;
+  const auto iy = static_cast<G4int>(idx) % f_ny;
+  return G4ThreeVector((2 * ix + 1 - f_nx) * f_extend_x,
+                       (2 * iy + 1 - f_ny) * f_extend_y, 0) +
+         f_element_offset;
+}
+
 G4LogicalVolume *LogicalSurface::get_logical_handle() {
   if (f_logical_envelope) {
     return f_logical_envelope;
@@ -116,14 +201,7 @@ G4bool LogicalSurface::facet_part_of_surface(G4TriangularFacet *facet){
 }
 
 size_t LogicalSurface::random_select_facet() const {
-  const G4double random = G4UniformRand();
-  const size_t size = f_probability.size();
-  for (size_t idx = 0; idx < size; idx++) {
-    if (random <= f_probability[idx]) {
-      return idx;
-    }
-  }
-  exit(EXIT_FAILURE);  // should never happen
+  return f_facet_sampler.Sample();
 }
 
 size_t LogicalSurface::random_select_placed_element() const{
@@ -133,21 +211,31 @@ size_t LogicalSurface::random_select_placed_element() const{
 
 void LogicalSurface::sample_point(G4ThreeVector &point,
                                   G4ThreeVector &direction) {
+  const auto element_idx = random_select_placed_element();
+  const G4ThreeVector position = element_position(element_idx);
+  if (f_height_field) {
+    point = f_height_field->GetPointOnTopSurface(direction) + position;
+    SCORE4_LOG_DEBUG(f_logger,
+                     "Sampled element idx: " + std::to_string(element_idx));
+    return;
+  }
   if(!f_probability_generated){
     generate_probability();
   }
-  const auto element_idx = random_select_placed_element();
-  auto *daughter = f_logical_envelope->GetDaughter(static_cast<G4int>(element_idx));
-  G4ThreeVector element_position = daughter->GetTranslation();
   const auto facet_idx = random_select_facet();
-  const auto *facet = f_surface_element->GetFacet(static_cast<G4int>(facet_idx));
+  const auto *facet = f_facets[facet_idx];
   const auto point_on_facet = facet->GetPointOnFace();
-  point = point_on_facet + element_position;
+  point = point_on_facet + position;
   direction = facet->GetSurfaceNormal();
-  f_logger.WriteDebugInfo("Sampled element idx: " + std::to_string(element_idx));
-  f_logger.WriteDebugInfo("Sampled   facet idx: " + std::to_string(facet_idx));
+  SCORE4_LOG_DEBUG(f_logger,
+                   "Sampled element idx: " + std::to_string(element_idx));
+  SCORE4_LOG_DEBUG(f_logger,
+                   "Sampled   facet idx: " + std::to_string(facet_idx));
 }
 G4double LogicalSurface::surface_area() const {
+  if (f_height_field) {
+    return f_height_field->GetTopSurfaceArea();
+  }
   G4double area{0};
   for (auto *facet:f_facets) {
     area += facet->GetArea();
@@ -155,6 +243,13 @@ G4double LogicalSurface::surface_area() const {
   return area;
 }
 
+const std::vector<G4TriangularFacet*> &LogicalSurface::get_surface_facets() {
+  if (!f_height_field && f_facets.empty()) {
+    fill_facet_store();
+  }
+  return f_facets;
+}
+
 void LogicalSurface::fill_facet_store() {
   f_logger.WriteDetailInfo("Filling facet store");
   f_facets.clear();
@@ -168,6 +263,10 @@ void LogicalSurface::fill_facet_store() {
   f_logger.WriteDebugInfo("Filled facet store with " + std::to_string(f_facets.size()) + " facets");
 }
 void LogicalSurface::generate_probability() {
+  if (f_height_field) {
+    f_logger.WriteDetailInfo("Height field samples its top surface directly");
+    return;
+  }
   f_logger.WriteDetailInfo("Generating probability vector");
   fill_facet_store();
   const auto size = f_facets.size();
@@ -184,6 +283,7 @@ void LogicalSurface::generate_probability() {
     cumulative_sum += area;
     f_probability.push_back(cumulative_sum / total_area);
   }
+  f_facet_sampler.Build(areas);
   f_probability_generated = true;
 }
 
@@ -195,13 +295,21 @@ G4String LogicalSurface::information() const {
   stream << "*****  Information of LogicalSurface Object  *****\n";
   stream << "**************************************************\n";
   stream << "* LogicalSurface Object: " << f_name << "\n";
-  stream << "* GDML filename: " << f_gdml_filename << "\n";
-  stream << "* Solid name: " << f_surface_element->GetName() << "\n";
-  stream << "* Memory facets: " << f_surface_element->AllocatedMemoryWithoutVoxels()/1e6 << " MB \n";
-  stream << "* Memory total : " << f_surface_element->AllocatedMemory()/1e6 << "MB \n";
-  stream << "* Number of facets: " << f_surface_element->GetNumberOfFacets() << "\n";
-  stream << "* Max extension x: " << f_surface_element->GetMaxXExtent() * f_nx << "\n";
-  stream << "* Max extension y: " << f_surface_element->GetMaxYExtent() * f_ny << "\n";
+  stream << "* Surface filename: " << f_filename << "\n";
+  stream << "* Solid name: " << surface_solid()->GetName() << "\n";
+  if (f_height_field) {
+    stream << "* Memory total : " << f_height_field->AllocatedMemory()/1e6 << " MB \n";
+    stream << "* Height field points: nx=" << f_height_field->GetNx()
+           << " ny=" << f_height_field->GetNy() << "\n";
+    stream << "* Max extension x: " << f_height_field->GetHalfLengthX() * f_nx << "\n";
+    stream << "* Max extension y: " << f_height_field->GetHalfLengthY() * f_ny << "\n";
+  } else {
+    stream << "* Memory facets: " << f_surface_element->AllocatedMemoryWithoutVoxels()/1e6 << " MB \n";
+    stream << "* Memory total : " << f_surface_element->AllocatedMemory()/1e6 << "MB \n";
+    stream << "* Number of facets: " << f_surface_element->GetNumberOfFacets() << "\n";
+    stream << "* Max extension x: " << f_surface_element->GetMaxXExtent() * f_nx << "\n";
+    stream << "* Max extension y: " << f_surface_element->GetMaxYExtent() * f_ny << "\n";
+  }
   //must add height information
   stream << "* Placed elements: nx=" << f_nx << "ny=" << f_ny << "total=" << f_nx*f_ny << "\n";
   stream << "* Envelope material: " << f_envelope_material->GetName() << "\n";
@@ -246,10 +354,12 @@ G4String LogicalSurface::placed_elements_information() const {
   stream << "*****          - placed elements -           *****\n";
   stream << "**************************************************\n";
   stream << "* Placed elements: nx=" << f_nx << " ny=" << f_ny << " total=" << f_nx*f_ny << "\n";
+  stream << "* Placement: "
+         << (f_placement_mode == PlacementMode::Replica ? "replica" : "single")
+         << "\n";
   for(G4int idx = 0; idx < f_nx * f_ny; idx++){
-    auto *daughter = f_logical_envelope->GetDaughter(idx);
-    stream << "* Name: " << daughter->GetName() << "\n";
-    stream << "* Position: " << daughter->GetTranslation() << "\n";
+    stream << "* Element: ix=" << idx / f_ny << " iy=" << idx % f_ny << "\n";
+    stream << "* Position: " << element_position(static_cast<size_t>(idx)) << "\n";
   }
   stream << "**************************************************\n";
   stream << "**************************************************\n";
@@ -13,19 +13,45 @@
 #include "G4TessellatedSolid.hh"
 #include "G4TriangularFacet.hh"
 
+#include "Service/include/AliasTable.hh"
 #include "Service/include/Logger.hh"
+#include "Surface/HeightFieldSolid.hh"
+#include "Surface/MeshFile.hh"
 
 namespace Surface {
 /**
  * @brief LogicalSurface class for placement of LogicalSurface
  * @details The class handles loading of LogicalSurface from GDML file and placing it
- * multiple times at a defined position.
+ * multiple times at a defined position. Files ending with .hmap are loaded as
+ * HeightFieldSolid instead of a tessellated mesh, files ending with .smesh are
+ * read as binary mesh (MeshFile) without parsing XML.
  */
 class LogicalSurface {
  public:
-  LogicalSurface(G4String name, G4String gdml_filename, G4int nx, G4int ny,
+  /**
+   * @brief How the nx * ny elements are placed in the envelope
+   * @details Single (default): one G4PVPlacement per element. Replica:
+   * envelope sliced by G4PVReplica in x and y, a single placement of the
+   * element per cell, for large nx * ny.
+   */
+  enum class PlacementMode { Single, Replica };
+
+  /**
+   * @brief Box of one element inside the envelope
+   * @details half_size is half the bounding box of the element, offset
+   * moves the element to the centre of its cell in x and y and its bottom on
+   * the bottom of the envelope.
+   */
+  struct ElementFrame {
+    G4ThreeVector half_size;
+    G4ThreeVector offset;
+  };
+
+  LogicalSurface(G4String name, G4String filename, G4int nx, G4int ny,
                  G4Material* material, G4Material* envelope_material,
-                 VerboseLevel verbose_lvl = VerboseLevel::Default);
+                 VerboseLevel verbose_lvl = VerboseLevel::Default,
+                 PlacementMode placement_mode = PlacementMode::Single,
+                 G4bool check_overlaps = true);
 
   G4LogicalVolume* get_logical_handle();
 
@@ -37,6 +63,24 @@ class LogicalSurface {
 
   inline G4double get_shift_to_zero() const {return f_shift_to_zero;}
 
+  /// number of placed elements, nx * ny
+  inline size_t get_number_of_elements() const {
+    return static_cast<size_t>(f_nx) * static_cast<size_t>(f_ny);
+  }
+  inline G4int get_ny() const {return f_ny;}
+  /// position of element idx (= ix * ny + iy) inside the envelope
+  G4ThreeVector element_position(size_t idx) const;
+  /// nullptr if the surface is a tessellated solid
+  inline const HeightFieldSolid *get_height_field() const {
+    return f_height_field;
+  }
+  /// facets of the surface of one element, empty for a height field
+  const std::vector<G4TriangularFacet*> &get_surface_facets();
+
+  /// frame of an element with the bounding limits extend_min, extend_max
+  static ElementFrame element_frame(const G4ThreeVector &extend_min,
+                                    const G4ThreeVector &extend_max);
+
   void show_information() const;
   void show_probability_information() const;
   void show_placed_elements_information()const;
@@ -45,7 +89,13 @@ class LogicalSurface {
 
  private:
   void load_gdml();
+  void load_height_field();
+  void load_mesh();
+  static G4bool has_extension(const G4String &filename,
+                              const G4String &extension);
+  G4VSolid *surface_solid() const;
   void place_surface_element_inside_volume();
+  void place_replica(G4LogicalVolume *logical_surface_element);
 
   static G4bool facet_above_height(G4TriangularFacet * facet) ;
   static G4bool facet_part_of_surface(G4TriangularFacet *facet);
@@ -62,17 +112,24 @@ class LogicalSurface {
 
  private:
   G4String f_name;
-  G4String f_gdml_filename;
+  G4String f_filename;
   G4int f_nx;
   G4int f_ny;
-  G4double f_shift_to_zero;
+  PlacementMode f_placement_mode;
+  G4bool f_check_overlaps;
+  G4double f_extend_x{0};
+  G4double f_extend_y{0};
+  G4double f_shift_to_zero;  ///< half height of the envelope
+  G4ThreeVector f_element_offset;
   G4Material *f_material;
   G4Material *f_envelope_material;
   Logger f_logger;
   G4TessellatedSolid *f_surface_element{nullptr};
+  HeightFieldSolid *f_height_field{nullptr};
   G4LogicalVolume *f_logical_envelope{nullptr};
   std::vector<G4TriangularFacet*> f_facets;
   std::vector<G4double> f_probability;
+  AliasTable f_facet_sampler;
   G4bool f_probability_generated{false};
 };
 }  // namespace Surface
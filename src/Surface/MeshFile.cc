@@ -0,0 +1,140 @@
+/**
+ * @brief Implementation of MeshFile.hh
+ * @author agent
+ * @date 2026-10-17
+ * @file MeshFile.cc
+ */
+
+#include "Surface/MeshFile.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "G4Exception.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TriangularFacet.hh"
+
+namespace Surface {
+
+namespace {
+constexpr char k_magic[8] = "SC4MESH";
+constexpr std::uint32_t k_version{1};
+constexpr std::size_t k_header_size{40};
+
+template <class T>
+T read_at(const unsigned char *data) {
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+}  // namespace
+
+MeshFile::MeshFile(const G4String &filename) : f_filename(filename) {
+  const int descriptor = open(f_filename.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    fatal("MeshFile::MeshFile()", "Failed to open mesh file ");
+  }
+  struct stat status {};
+  if (fstat(descriptor, &status) != 0 ||
+      static_cast<std::size_t>(status.st_size) < k_header_size) {
+    close(descriptor);
+    fatal("MeshFile::MeshFile()", "Mesh file too short ");
+  }
+  f_size = static_cast<std::size_t>(status.st_size);
+  void *mapped = mmap(nullptr, f_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+  close(descriptor);  // mapping stays valid
+  if (mapped == MAP_FAILED) {
+    f_size = 0;
+    fatal("MeshFile::MeshFile()", "Failed to map mesh file ");
+  }
+  f_data = static_cast<const unsigned char *>(mapped);
+  madvise(mapped, f_size, MADV_SEQUENTIAL);
+
+  if (std::memcmp(f_data, k_magic, sizeof(k_magic)) != 0 ||
+      read_at<std::uint32_t>(f_data + 8) != k_version) {
+    fatal("MeshFile::MeshFile()", "Not a mesh file (version 1): ");
+  }
+  f_vertex_bytes = read_at<std::uint32_t>(f_data + 12);
+  f_n_vertices = read_at<std::uint64_t>(f_data + 16);
+  f_n_faces = read_at<std::uint64_t>(f_data + 24);
+  f_length_unit = read_at<G4double>(f_data + 32) * mm;
+  if ((f_vertex_bytes != 4 && f_vertex_bytes != 8) || f_length_unit <= 0 ||
+      f_n_vertices > UINT32_MAX) {
+    fatal("MeshFile::MeshFile()", "Invalid header of mesh file ");
+  }
+  // counts bounded by the file size first, the block sizes cannot overflow
+  const std::uint64_t payload = f_size - k_header_size;
+  const std::uint64_t vertex_size = 3 * f_vertex_bytes;
+  const std::uint64_t face_size = 3 * sizeof(std::uint32_t);
+  if (f_n_vertices > payload / vertex_size || f_n_faces > payload / face_size) {
+    fatal("MeshFile::MeshFile()",
+          "Size of mesh file does not match header ");
+  }
+  const std::uint64_t vertex_block = f_n_vertices * vertex_size;
+  const std::uint64_t face_block = f_n_faces * face_size;
+  if (vertex_block + face_block != payload) {
+    fatal("MeshFile::MeshFile()",
+          "Size of mesh file does not match header ");
+  }
+  f_vertices = f_data + k_header_size;
+  f_faces = f_vertices + vertex_block;
+
+  std::uint32_t face[3];
+  for (std::uint64_t idx = 0; idx < f_n_faces; ++idx) {
+    GetFace(idx, face);
+    if (face[0] >= f_n_vertices || face[1] >= f_n_vertices ||
+        face[2] >= f_n_vertices) {
+      fatal("MeshFile::MeshFile()",
+            "Vertex index out of range in mesh file ");
+    }
+  }
+}
+
+MeshFile::~MeshFile() {
+  if (f_data) {
+    munmap(const_cast<unsigned char *>(f_data), f_size);
+  }
+}
+
+G4ThreeVector MeshFile::GetVertex(const std::uint64_t idx) const {
+  const unsigned char *vertex = f_vertices + idx * 3 * f_vertex_bytes;
+  if (f_vertex_bytes == 4) {
+    return G4ThreeVector(read_at<float>(vertex), read_at<float>(vertex + 4),
+                         read_at<float>(vertex + 8)) *
+           f_length_unit;
+  }
+  return G4ThreeVector(read_at<G4double>(vertex),
+                       read_at<G4double>(vertex + 8),
+                       read_at<G4double>(vertex + 16)) *
+         f_length_unit;
+}
+
+void MeshFile::GetFace(const std::uint64_t idx, std::uint32_t face[3]) const {
+  std::memcpy(face, f_faces + idx * 3 * sizeof(std::uint32_t),
+              3 * sizeof(std::uint32_t));
+}
+
+G4TessellatedSolid *MeshFile::BuildTessellatedSolid(
+    const G4String &name) const {
+  auto *solid = new G4TessellatedSolid(name);
+  std::uint32_t face[3];
+  for (std::uint64_t idx = 0; idx < f_n_faces; ++idx) {
+    GetFace(idx, face);
+    solid->AddFacet(new G4TriangularFacet(GetVertex(face[0]),
+                                          GetVertex(face[1]),
+                                          GetVertex(face[2]), ABSOLUTE));
+  }
+  solid->SetSolidClosed(true);
+  return solid;
+}
+
+void MeshFile::fatal(const char *method, const G4String &message) const {
+  G4Exception(method, "", FatalException,
+              (message + f_filename).c_str());
+}
+
+}  // namespace Surface
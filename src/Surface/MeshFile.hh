@@ -0,0 +1,61 @@
+/**
+ * @brief Definition of MeshFile class
+ * @author agent
+ * @date 2026-10-17
+ * @file MeshFile.hh
+ */
+
+#ifndef SURFACE_MESHFILE_HH
+#define SURFACE_MESHFILE_HH
+
+#include <cstddef>
+#include <cstdint>
+
+#include "G4String.hh"
+#include "G4TessellatedSolid.hh"
+#include "G4ThreeVector.hh"
+
+namespace Surface {
+/**
+ * @brief Read only, memory mapped view of a binary mesh file written by
+ * MeshWriter.py
+ * @details Layout, little endian:
+ * char[8] "SC4MESH", uint32 version, uint32 vertex_bytes (4: float32,
+ * 8: float64), uint64 n_vertices, uint64 n_faces, float64 length_unit (mm per
+ * file unit), vertex[n_vertices][3], uint32 face[n_faces][3].
+ * Vertices are decoded on access, the file is never copied as a whole.
+ * Header, file size and face indices are checked when the file is opened.
+ */
+class MeshFile {
+ public:
+  explicit MeshFile(const G4String &filename);
+  ~MeshFile();
+  MeshFile(const MeshFile &) = delete;
+  MeshFile &operator=(const MeshFile &) = delete;
+
+  inline std::uint64_t GetNumberOfVertices() const { return f_n_vertices; }
+  inline std::uint64_t GetNumberOfFaces() const { return f_n_faces; }
+  /// vertex in Geant4 units
+  G4ThreeVector GetVertex(std::uint64_t idx) const;
+  void GetFace(std::uint64_t idx, std::uint32_t face[3]) const;
+
+  /// Facets in file order, solid closed (and voxelized)
+  G4TessellatedSolid *BuildTessellatedSolid(const G4String &name) const;
+
+ private:
+  void fatal(const char *method, const G4String &message) const;
+
+ private:
+  G4String f_filename;
+  const unsigned char *f_data{nullptr};
+  std::size_t f_size{0};
+  std::uint32_t f_vertex_bytes{0};
+  std::uint64_t f_n_vertices{0};
+  std::uint64_t f_n_faces{0};
+  G4double f_length_unit{0};
+  const unsigned char *f_vertices{nullptr};
+  const unsigned char *f_faces{nullptr};
+};
+}  // namespace Surface
+
+#endif  // SURFACE_MESHFILE_HH
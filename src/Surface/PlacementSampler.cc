@@ -0,0 +1,128 @@
+/**
+ * @brief Implementation of PlacementSampler
+ * @author agent
+ * @date 2026-10-17
+ * @file PlacementSampler.cc
+ */
+
+#include "PlacementSampler.hh"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+
+#include "G4Exception.hh"
+#include "G4TriangularFacet.hh"
+#include "LogicalSurface.hh"
+#include "Randomize.hh"
+#include "SurfaceSourceStore.hh"
+
+namespace Surface {
+
+void PlacementSampler::build(SurfaceSourceStore &store) {
+  f_placements.clear();
+  f_facets.clear();
+  f_entries.clear();
+  // weights of one element, as LogicalSurface::surface_area(), a placement is
+  // sampled by the area of a single element independent of nx * ny
+  std::vector<G4double> weights;
+  // facets of a LogicalSurface placed several times are stored once
+  std::map<LogicalSurface *, std::pair<size_t, size_t>> facet_range;
+
+  for (size_t idx = 0; idx < store.size(); idx++) {
+    LogicalSurface *volume = store.get_volume(idx);
+    const G4RotationMatrix *rotation = store.get_rotation(idx);
+    // inverse because the placement rotates the frame, local to global
+    const G4RotationMatrix to_global =
+        rotation != nullptr ? rotation->inverse() : G4RotationMatrix();
+    const G4ThreeVector first = volume->element_position(0);
+    const auto ny = static_cast<size_t>(volume->get_ny());
+    const size_t elements = volume->get_number_of_elements();
+    f_placements.push_back(
+        Placement{to_global,
+                  to_global * first + store.get_position(idx),
+                  to_global * (volume->element_position(ny) - first),
+                  to_global * (volume->element_position(1) - first),
+                  elements,
+                  ny,
+                  volume->get_height_field()});
+
+    const auto placement = static_cast<std::uint32_t>(idx);
+    if (volume->get_height_field() != nullptr) {
+      f_entries.push_back(
+          Entry{placement, std::numeric_limits<std::uint32_t>::max()});
+      weights.push_back(volume->get_height_field()->GetTopSurfaceArea());
+      continue;
+    }
+    auto range = facet_range.find(volume);
+    if (range == facet_range.end()) {
+      const size_t begin = f_facets.size();
+      for (const auto *facet : volume->get_surface_facets()) {
+        const G4ThreeVector vertex = facet->GetVertex(0);
+        f_facets.push_back(Facet{vertex, facet->GetVertex(1) - vertex,
+                                 facet->GetVertex(2) - vertex,
+                                 facet->GetSurfaceNormal()});
+      }
+      range = facet_range
+                  .emplace(volume, std::make_pair(begin, f_facets.size()))
+                  .first;
+    }
+    for (size_t facet = range->second.first; facet < range->second.second;
+         facet++) {
+      const Facet &f = f_facets[facet];
+      const G4double area = 0.5 * f.edge_1.cross(f.edge_2).mag();
+      f_entries.push_back(
+          Entry{placement, static_cast<std::uint32_t>(facet)});
+      weights.push_back(area);
+    }
+  }
+  if (f_entries.empty()) {
+    G4Exception("PlacementSampler::build()", "", FatalException,
+                "No surfaces in SurfaceSourceStore!");
+  }
+  f_sampler.Build(weights);
+}
+
+size_t PlacementSampler::sample(G4ThreeVector &point,
+                                G4ThreeVector &direction) const {
+  const Entry &entry = f_entries[f_sampler.Sample()];
+  const Placement &placement = f_placements[entry.placement];
+  const auto element = std::min(
+      static_cast<size_t>(static_cast<G4double>(placement.elements) *
+                          G4UniformRand()),
+      placement.elements - 1);
+
+  G4ThreeVector local;
+  if (placement.height_field != nullptr) {
+    local = placement.height_field->GetPointOnTopSurface(direction);
+  } else {
+    // as G4TriangularFacet::GetPointOnFace()
+    const Facet &facet = f_facets[entry.facet];
+    G4double u = G4UniformRand();
+    G4double v = G4UniformRand();
+    if (u + v > 1.) {
+      u = 1. - u;
+      v = 1. - v;
+    }
+    local = facet.vertex + u * facet.edge_1 + v * facet.edge_2;
+    direction = facet.normal;
+  }
+  const auto ix = static_cast<G4double>(element / placement.ny);
+  const auto iy = static_cast<G4double>(element % placement.ny);
+  point = placement.to_global * local + placement.origin +
+          ix * placement.step_x + iy * placement.step_y;
+  direction = placement.to_global * direction;
+  return entry.placement;
+}
+
+G4double PlacementSampler::placement_probability(
+    const size_t placement) const {
+  G4double probability{0};
+  for (size_t idx = 0; idx < f_entries.size(); idx++) {
+    if (f_entries[idx].placement == placement) {
+      probability += f_sampler.GetProbability(idx);
+    }
+  }
+  return probability;
+}
+}  // namespace Surface
@@ -0,0 +1,83 @@
+/**
+ * @brief Definition of PlacementSampler class
+ * @author agent
+ * @date 2026-10-17
+ * @file PlacementSampler.hh
+ */
+
+#ifndef SURFACE_PLACEMENTSAMPLER_HH
+#define SURFACE_PLACEMENTSAMPLER_HH
+
+#include <cstdint>
+#include <vector>
+
+#include "G4RotationMatrix.hh"
+#include "G4ThreeVector.hh"
+#include "Service/include/AliasTable.hh"
+#include "Surface/HeightFieldSolid.hh"
+
+namespace Surface {
+
+class SurfaceSourceStore;
+
+/**
+ * @brief Flat table of all placed surfaces of the SurfaceSourceStore
+ * @details build() compiles the store once. Every placement keeps its
+ * transformation to the global frame and the global offsets between
+ * neighbouring elements, the facets of each LogicalSurface are stored once in
+ * its local frame. One alias table selects a (placement, facet) pair with the
+ * facet area as weight, a height field counts as one facet with its top
+ * surface area. As before, a placement is sampled by the area of one of its
+ * elements and the element is drawn uniformly. A sample costs the alias
+ * lookup, a uniform element index and one rotation.
+ */
+class PlacementSampler {
+ public:
+  void build(SurfaceSourceStore &store);
+  inline G4bool is_built() const { return !f_entries.empty(); }
+
+  /**
+   * @brief Samples a point uniformly on all placed surfaces
+   * @param point global position of the point
+   * @param direction global surface normal at the point
+   * @return index of the placement in the SurfaceSourceStore
+   */
+  size_t sample(G4ThreeVector &point, G4ThreeVector &direction) const;
+
+  /// probability of the placement, sum of its entries
+  G4double placement_probability(size_t placement) const;
+  inline size_t size() const { return f_entries.size(); }
+
+ private:
+  struct Placement {
+    G4RotationMatrix to_global;
+    G4ThreeVector origin;  ///< global position of element 0
+    G4ThreeVector step_x;  ///< global offset from element ix to ix + 1
+    G4ThreeVector step_y;  ///< global offset from element iy to iy + 1
+    size_t elements;
+    size_t ny;
+    const HeightFieldSolid *height_field;
+  };
+
+  /// facet in the local frame of its LogicalSurface
+  struct Facet {
+    G4ThreeVector vertex;
+    G4ThreeVector edge_1;
+    G4ThreeVector edge_2;
+    G4ThreeVector normal;
+  };
+
+  struct Entry {
+    std::uint32_t placement;
+    std::uint32_t facet;  ///< unused for height fields
+  };
+
+ private:
+  std::vector<Placement> f_placements;
+  std::vector<Facet> f_facets;
+  std::vector<Entry> f_entries;
+  AliasTable f_sampler;
+};
+}  // namespace Surface
+
+#endif  // SURFACE_PLACEMENTSAMPLER_HH
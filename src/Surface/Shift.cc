@@ -7,81 +7,31 @@
 
 #include "Shift.hh"
 
-#include <cstdlib>
-#include <fstream>
-#include <limits>
 #include <string>
 
-#include "G4Material.hh"
-#include "G4SystemOfUnits.hh"
 #include "G4ThreeVector.hh"
-#include "G4TransportationManager.hh"
 #include "G4Types.hh"
-#include "G4VPhysicalVolume.hh"
-#include "Randomize.hh"
 
 Surface::Shift::Shift(const VerboseLevel verbose)
-    : fShiftTableReady(false),
-      fMinShift(0.),
-      fMaxShift(DBL_MAX),
-      fConfineMaterialName(""),
-      fLogger("Shift", verbose) {}
+    : fLogger("Shift", verbose) {}
 
 Surface::Shift::Shift(const G4String &filename, const VerboseLevel verbose)
-    : fShiftTableReady(false),
-      fMinShift(0.),
-      fMaxShift(DBL_MAX),
-      fConfineMaterialName(""),
-      fLogger("Shift", verbose){
+    : fLogger("Shift", verbose){
   LoadShiftTable(filename);
 }
 
-G4double Surface::Shift::CalcShift() {
-  G4double random = G4UniformRand();
-  for (size_t i = 0; i < fBarProbability.size(); ++i) {
-    if (random <= fBarProbability[i]) {
-      return Interpolate(i) * CLHEP::nm;
-    }
-  }
-  exit(EXIT_FAILURE);
-}
-
 void Surface::Shift::DoShift(G4ThreeVector &position,
                              const G4ThreeVector &direction) {
-  if (!fShiftTableReady) {
+  if (!fShiftTable.IsReady()) {
     const G4String error_msg = "Shift called, but ShiftTable not ready. No shift done!";
     G4Exception("Shift::DoShift()",
                 "", FatalException,
                 error_msg);
   }
 
-  G4int counter{0};
-  while (true) {
-    const G4double shift = CalcShift();
-
-    const G4ThreeVector normedDirection = direction / direction.r();
-    const G4ThreeVector newPosition = position - normedDirection * shift;
-
-    ++counter;
-    if (counter > 10000) {
-      fLogger.WriteError(
-          "Counter of ShiftTable > 10,000! Now performing shift "
-          "with value outside marked area");
-      position = newPosition;
-      return;
-    }
-
-    if (fMinShift > shift || shift > fMaxShift) {
-      continue;
-    }
-
-    if (!IsConfinedToMaterial(newPosition)) {
-      continue;
-    }
-    fLogger.WriteDebugInfo("Shift done: " + std::to_string(shift));
-    position = newPosition;
-    return;
-  }
+  const G4ThreeVector normedDirection = direction / direction.r();
+  position -= normedDirection * fConfinement.SampleShift(
+      fShiftTable, position, normedDirection, fLogger);
 }
 
 void Surface::Shift::DoShiftByValue(const G4double shift,
@@ -92,15 +42,7 @@ void Surface::Shift::DoShiftByValue(const G4double shift,
 }
 
 std::stringstream Surface::Shift::StreamShiftTable() const {
-  std::stringstream ss;
-  ss << "Shift table:\n";
-  for (size_t i = 0; i < fProbability.size(); ++i) {
-    ss << "Shift: " << std::setw(10) << fShift[i]
-       << " Counts: " << std::setw(10) << fProbability[i]
-       << " Summed probability: " << std::setw(10) << fBarProbability[i]
-       << "\n";
-  }
-  return ss;
+  return fShiftTable.StreamInfo();
 }
 
 void Surface::Shift::PrintShiftTable() {
@@ -108,108 +50,49 @@ void Surface::Shift::PrintShiftTable() {
 }
 
 void Surface::Shift::LoadShiftTable(const std::string &filename) {
-  std::ifstream file;
-  file.open(filename);
-  if (!file.is_open()) {
+  if (!fShiftTable.Load(filename)) {
     const G4String error_msg = "File for shift table not found at: " + filename;
     G4Exception("Shift::LoadShiftTable()",
                 "", FatalException,
                 error_msg);
     return;
   }
-  std::string line;
-  const std::string delimiter = ",";
-  while (getline(file, line)) {
-    const auto pos = line.find(delimiter);
-    const G4double depth = std::stod(line.substr(0, pos));
-    const G4double counts = std::stod(line.substr(pos + 1, pos + line.size()));
-    fShift.push_back(depth);
-    fProbability.push_back(counts);
-  }
-  file.close();
-  G4double counts{0};
-  for (size_t i = 0; i < fProbability.size() - 1; ++i) {
-    counts += Interpolate(0.5, fProbability.at(i), fProbability.at(i + 1));
-  }
-
-  G4double probability{0};
-  for (size_t i = 0; i < fProbability.size() - 1; ++i) {
-    probability +=
-        Interpolate(0.5, fProbability.at(i), fProbability.at(i + 1)) / counts;
-    fBarProbability.push_back(probability);
-  }
-  fShiftTableReady = true;
-}
-
-G4double Surface::Shift::Interpolate(const G4double xNormed,
-                                     const G4double lowerY,
-                                     const G4double upperY) {
-  const G4double k = (upperY - lowerY);
-  const G4double result = lowerY + xNormed * k;
-  return result;
-}
-
-G4double Surface::Shift::Interpolate(const size_t idx) {
-  const G4double a = fProbability[idx];
-  const G4double b = fProbability[idx + 1];
-  const G4double rand = G4UniformRand();
-  const G4double minShift = fShift[idx];
-  const G4double maxShift = fShift[idx + 1];
-  auto IsZero = [](const G4double a) {
-    const G4double numeric_limit =
-        std::numeric_limits<G4double>::epsilon() * 10;
-    return fabs(a) < numeric_limit;
-  };
-  G4double tmp = 0;
-  if (IsZero(b - a)) {
-    tmp = rand;
-  } else {
-    tmp = sqrt(a * a * (1 - rand) + b * b * rand);
-    tmp -= a;
-    tmp /= (b - a);
+  if (!fShiftTable.IsReady()) {
+    fLogger.WriteError("Shift table without counts in: " + filename);
   }
-  const G4double shift = minShift + tmp * (maxShift - minShift);
-  // fLogger.WriteDebugInfo("prob[idx]: " + std::to_string(lowProb) +
-  //                        " prob[idx + 1]: " + std::to_string(highProb) +
-  //                        " minShift: " + std::to_string(minShift) +
-  //                        " maxShift: " + std::to_string(maxShift) +
-  //                        " rand: " + std::to_string(rand) +
-  //                        " result: " + std::to_string(shift));
-  return shift;
+  WarnIfRangeEmpty();
 }
 
 void Surface::Shift::SetMinShift(const G4double min) {
-  fMinShift = min;
+  fShiftTable.SetMin(min);
   fLogger.WriteInfo("Min shift set to " + std::to_string(min));
+  WarnIfRangeEmpty();
 }
 void Surface::Shift::SetMaxShift(const G4double max) {
-  fMaxShift = max;
+  fShiftTable.SetMax(max);
   fLogger.WriteInfo("Max shift set to " + std::to_string(max));
+  WarnIfRangeEmpty();
 }
 
-G4bool Surface::Shift::IsConfinedToMaterial(const G4ThreeVector &point) {
-  if (fConfineMaterialName.empty()) {
-    return true;
+void Surface::Shift::WarnIfRangeEmpty() const {
+  if (fShiftTable.IsReady() && fShiftTable.IsRangeEmpty()) {
+    fLogger.WriteWarning(
+        "No shift of the table between min and max shift, shifts are drawn "
+        "from the full table");
   }
-  G4ThreeVector null(0., 0., 0.);
-
-  const G4VPhysicalVolume *physVol =
-      G4TransportationManager::GetTransportationManager()
-          ->GetNavigatorForTracking()
-          ->LocateGlobalPointAndSetup(point, &null, true);
+}
 
-  const G4String matName =
-      physVol->GetLogicalVolume()->GetMaterial()->GetName();
+void Surface::Shift::ConfineToMaterial(const G4String &materialName) {
+  fConfinement.SetMaterial(materialName);
+}
 
-  fLogger.WriteDebugInfo("Material Name of physical Volume is: " + matName);
-  if (matName == fConfineMaterialName) {
-    return true;
-  }
-  return false;
+void Surface::Shift::SetConfinementMode(
+    const MaterialConfinement::Mode mode) {
+  fConfinement.SetMode(mode);
 }
 
-void Surface::Shift::ConfineToMaterial(const G4String &materialName) {
-  fConfineMaterialName = materialName;
+void Surface::Shift::PrintConfinementStatistics() const {
+  fLogger.WriteInfo(fConfinement.StreamStatistics().str());
 }
 
 void Surface::Shift::SetVerboseLvl(const VerboseLevel verboseLvl) {
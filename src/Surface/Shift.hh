@@ -9,10 +9,11 @@
 #define SURFACE_SHIFT_HH
 
 #include <string>
-#include <vector>
 
 #include "G4ThreeVector.hh"
 #include "Service/include/Logger.hh"
+#include "Service/include/MaterialConfinement.hh"
+#include "Service/include/ShiftTable.hh"
 
 namespace Surface {
 /**
@@ -33,23 +34,19 @@ class Shift {
   void SetMinShift(G4double min);
   void SetMaxShift(G4double max);
   void ConfineToMaterial(const G4String &materialName);
+  /// Boundary (default): depths are drawn within the material directly
+  void SetConfinementMode(MaterialConfinement::Mode mode);
+  /// Locates done for the confinement and saved against rejection sampling
+  void PrintConfinementStatistics() const;
   void SetVerboseLvl(VerboseLevel verboseLvl);
   void SetVerboseLvl(G4int verboseLvl);
 
  private:
-  G4double Interpolate(size_t);
-  static G4double Interpolate(G4double, G4double, G4double);
-  G4double CalcShift();
-  G4bool IsConfinedToMaterial(const G4ThreeVector &point);
+  void WarnIfRangeEmpty() const;
 
  private:
-  std::vector<G4double> fProbability;
-  std::vector<G4double> fShift;
-  std::vector<G4double> fBarProbability;
-  G4bool fShiftTableReady;
-  G4double fMinShift;
-  G4double fMaxShift;
-  G4String fConfineMaterialName;
+  ShiftTable fShiftTable;
+  MaterialConfinement fConfinement;
   Logger fLogger;
   //ShiftMessenger *fMessenger;
 };
@@ -6,10 +6,8 @@
 */
 
 #include "Source.hh"
-#include "LogicalSurface.hh"
-#include "Randomize.hh"
-#include <vector>
-#include <numeric>
+#include "Service/include/VertexFile.hh"
+#include <sstream>
 
 namespace Surface {
 
@@ -21,64 +19,63 @@ Source::Source(const G4String &name, Shift * shift, VerboseLevel verbose_lvl)
   f_logger.WriteDetailInfo("Instantiated Source " + f_name);
 }
 
-void Source::generate_probability() {
-  f_logger.WriteDebugInfo("Setup of probability vector");
-  const auto size = f_store.size();
-  std::vector<G4double> areas;
-  areas.reserve(size);
-  for (size_t idx = 0; idx < size; idx++) {
-    auto *volume = f_store.get_volume(idx);
-    areas.push_back(volume->surface_area());
+size_t Source::sample_surface_point(G4ThreeVector &point,
+                                     G4ThreeVector &direction) {
+  if (not f_sampler.is_built()) {
+    f_logger.WriteDebugInfo("Compiling placements of SurfaceSourceStore");
+    f_sampler.build(f_store);
+    f_logger.WriteDetailInfo([this] { return sampler_information(); });
   }
-  f_probability.clear();
-  f_probability.reserve(size);
-  const G4double total_area = std::accumulate(areas.begin(), areas.end(), 0.);
-  G4double cumulative_sum{0};
-  for (auto area : areas) {
-    cumulative_sum += area;
-    if(total_area <= 0){
-      G4String error_msg = "Total area of surface <= 0!";
-      G4Exception("Source::generate_probability()",
-                  "", FatalException,
-                  error_msg);
-    }
-    f_probability.push_back(cumulative_sum / total_area);
-  }
-  f_probability_generated = true;
+  return f_sampler.sample(point, direction);
 }
 
-size_t Source::random_select_logical_surface_idx() const {
-  const G4double random = G4UniformRand();
-  const size_t size = f_probability.size();
-  for (size_t idx = 0; idx < size; idx++) {
-    if (random <= f_probability[idx]) {
-      f_logger.WriteDebugInfo("Sampling idx from probability vector.");
-      return idx;
-    }
+G4String Source::sampler_information() const {
+  std::stringstream stream;
+  stream << "Source " << f_name << ": " << f_store.size()
+         << " placements, " << f_sampler.size() << " (placement, facet) "
+         << "entries\n";
+  for (size_t idx = 0; idx < f_store.size(); idx++) {
+    stream << "* Placement " << idx << " sampled: "
+           << f_sampler.placement_probability(idx) * 100. << " %\n";
   }
-  exit(EXIT_FAILURE);  // should never happen
+  return stream.str();
 }
 
 void Source::GeneratePrimaryVertex(G4Event *event) {
-  if (not f_probability_generated) {
-    generate_probability();
-  }
-
-  const size_t idx = random_select_logical_surface_idx();
-  auto *volume = dynamic_cast<LogicalSurface *>(f_store.get_volume(idx));
   G4ThreeVector point{};
   G4ThreeVector direction{};
-  volume->sample_point(point, direction);
-  auto *rotation_matrix = f_store.get_rotation(idx);
-  point.transform(rotation_matrix->inverse()); //inverse because I go from local to global
-  direction.transform(rotation_matrix->inverse());
-  point += f_store.get_position(idx);
+  sample_surface_point(point, direction);
   f_particle_generator->GeneratePrimaryVertex(event);
   if(f_shift != nullptr){
     f_shift->DoShift(point, direction);
   }
   event->GetPrimaryVertex(0)->SetPosition(point.x(), point.y(), point.z());
-  f_logger.WriteDebugInfo("Set point for primary vertex: ", point);
+  SCORE4_LOG_DEBUG(f_logger, "Set point for primary vertex: ", point);
+}
+
+G4bool Source::write_vertices(const G4String &filename, const size_t n) {
+  VertexFileWriter writer(filename);
+  if (not writer.Open()) {
+    f_logger.WriteError("Cannot create vertex file " + filename);
+    return false;
+  }
+  for (size_t i = 0; i < n; i++) {
+    G4ThreeVector point{};
+    G4ThreeVector direction{};
+    const size_t idx = sample_surface_point(point, direction);
+    if(f_shift != nullptr){
+      f_shift->DoShift(point, direction);
+    }
+    writer.Append(VertexRecord{{point.x(), point.y(), point.z()},
+                               {direction.x(), direction.y(), direction.z()},
+                               static_cast<std::int32_t>(idx), -1});
+  }
+  if (not writer.Close()) {
+    f_logger.WriteError("Writing vertex file " + filename + " failed");
+    return false;
+  }
+  f_logger.WriteInfo("Wrote " + std::to_string(n) + " vertices to " + filename);
+  return true;
 }
 
 Source::~Source() {
@@ -11,31 +11,40 @@
 #include "G4GeneralParticleSource.hh"
 #include "G4VPrimaryGenerator.hh"
 #include "Shift.hh"
+#include "Surface/PlacementSampler.hh"
 #include "Surface/SurfaceSourceStore.hh"
 
 namespace Surface {
 /**
  * @brief This class is a particle generator for simulating a surface contamination
- * @details Surfaces must be added to this source and are later sampled directly
- * from the logical volume.
+ * @details Surfaces must be added to this source. At the first event the
+ * placements of the SurfaceSourceStore are compiled into a PlacementSampler,
+ * which samples all surfaces directly.
  */
 class Source : public G4VPrimaryGenerator {
  public:
   explicit Source(const G4String &name, Shift *shift, VerboseLevel verbose_lvl = VerboseLevel::Default);
   ~Source() override;
   void GeneratePrimaryVertex(G4Event *event) override;
+  /**
+   * @brief Samples n vertices into a vertex file, see VertexStream
+   * @details The index of the placement in the SurfaceSourceStore is stored as
+   * cell of the vertex.
+   * @return false if the file could not be written
+   */
+  G4bool write_vertices(const G4String &filename, size_t n);
 
  private:
-  void generate_probability();
-  size_t random_select_logical_surface_idx() const;
+  /// samples a point and its normal on a random surface, in global frame
+  size_t sample_surface_point(G4ThreeVector &point, G4ThreeVector &direction);
+  G4String sampler_information() const;
 
  private:
   G4GeneralParticleSource *f_particle_generator;
   G4String f_name;
   SurfaceSourceStore &f_store = SurfaceSourceStore::getInstance();
   Surface::Shift *f_shift{nullptr};
-  std::vector<G4double> f_probability;
-  G4bool f_probability_generated{false};
+  PlacementSampler f_sampler;
   Logger f_logger;
 };
 }  // namespace Surface
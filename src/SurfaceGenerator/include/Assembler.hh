@@ -32,8 +32,10 @@ class Assembler {
 
   /**
    * @brief Calls the assembler to assemble solid and add all selected facets to the FacetStore.
+   * @param fillFacetStore false: only the solid is assembled, e.g. if the
+   * facets were restored from a cache
    */
-  void Assemble();
+  void Assemble(G4bool fillFacetStore = true);
 
   /**
    * @brief Get handle G4Solid after assembling it.
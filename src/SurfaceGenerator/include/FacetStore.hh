@@ -7,13 +7,17 @@
 #ifndef SRC_SURFACEGENERATOR_INCLUDE_FACETSTORE_HH_
 #define SRC_SURFACEGENERATOR_INCLUDE_FACETSTORE_HH_
 
+#include <atomic>
+#include <cstddef>
 #include <vector>
 
 #include "G4String.hh"
 #include "G4ThreeVector.hh"
 #include "G4Transform3D.hh"
 #include "G4TriangularFacet.hh"
+#include "Service/include/AliasTable.hh"
 #include "Service/include/Logger.hh"
+#include "SurfaceGenerator/include/SurfaceStatistics.hh"
 
 namespace Surface {
 
@@ -22,6 +26,11 @@ namespace Surface {
  * @details Stores and handles G4TriangularFacets to represent a surface.
  * Allows further to sample uniformly distributed points on this surface and
  * to draw the surface using a GUI.
+ * Facets are not kept as G4TriangularFacet objects. The store holds
+ * contiguous arrays of the vertices, the edges AB and AC, the unit normals
+ * and the areas, one entry (three for vertices) per facet. A point is sampled
+ * as A + u AB + v AC with two random numbers, folded back into the triangle
+ * if u + v > 1.
  */
 class FacetStore {
  private:
@@ -34,10 +43,13 @@ class FacetStore {
  public:
   explicit FacetStore(const G4String &name , VerboseLevel verboseLvl = VerboseLevel::Default)
       : fName("FacetStore_" + name), fLogger("FacetStore_" + name, verboseLvl) {}
+  /// Copies the facets and the closed state, fClosed is atomic
+  FacetStore(const FacetStore &other);
+  FacetStore &operator=(const FacetStore &other);
 
 /**
  * @brief Closes FacetStore and prepares it for usage in simulation.
- * After closing it, no facets can be added anymore.
+ * After closing it, no facets can be added anymore. Thread safe.
  */
   void CloseFacetStore();
 
@@ -52,13 +64,22 @@ class FacetStore {
   G4ThreeVector GetRandomPoint(G4ThreeVector &surfaceNormal);
   /**
    * @brief Appends Triangular Facet to Fact Store.
-   * @param facet Pointer to facet which will be added to store
+   * @param facet Pointer to facet which will be added to store. The store
+   * copies the vertices and takes ownership, the facet is deleted.
    */
   void AppendToFacetVector(G4TriangularFacet *facet);
+  /**
+   * @brief Appends the triangle (a, b, c) to the store
+   */
+  void AppendFacet(const G4ThreeVector &a, const G4ThreeVector &b,
+                   const G4ThreeVector &c);
 
   void DrawFacets();
 
-  inline G4bool GetIsStoreClosed() const { return fClosed; }
+  /// Safe to call from worker threads while another thread closes the store
+  inline G4bool GetIsStoreClosed() const {
+    return fClosed.load(std::memory_order_acquire);
+  }
   ///
   /// Writes Vertices of Facet and its share of surface area to file.
   /// \param aFilename Name of logfile
@@ -68,8 +89,6 @@ class FacetStore {
   void PrintInfo() const;
   std::stringstream StreamInfo() const;
 
-  std::vector<G4TriangularFacet *>::const_iterator GetIterBegin() const;
-  std::vector<G4TriangularFacet *>::const_iterator GetIterEnd() const;
   void SetTransformation(const G4ThreeVector &transformation) {
     fTransform = transformation;
   }
@@ -80,30 +99,62 @@ class FacetStore {
   inline G4ThreeVector GetTransformation() const { return fTransform; }
   inline G4String GetStoreName() const { return fName; }
 
-  inline G4int Size() const { return static_cast<G4int>(fFacetVector.size()); }
+  inline G4int Size() const { return static_cast<G4int>(fFacetArea.size()); }
+  /// Vertex k (0, 1, 2) of facet i
+  inline const G4ThreeVector &GetVertex(std::size_t i, G4int k) const {
+    return fVertices[3 * i + k];
+  }
+  /// Unit normal of facet i
+  inline const G4ThreeVector &GetSurfaceNormal(std::size_t i) const {
+    return fNormals[i];
+  }
+  inline G4double GetFacetArea(std::size_t i) const { return fFacetArea[i]; }
+  /**
+   * @brief Returns total area of all facets, available after closing the store
+   */
+  inline G4double GetArea() const { return fArea; }
+  /**
+   * @brief Returns the roughness parameters of the facets
+   * @details Computed on the first call and kept until a facet is appended.
+   * Thread safe.
+   */
+  const SurfaceStatistics &GetStatistics() const;
 
  private:
   /**
    * @brief Calculates the facets relative surface
    * @details Calculates the facets relative surface in comparison to total
    * surface of all facets in the facet store and stores result in fFacetProbability.
-   * Sum of all values is equal to one.
+   * Sum of all values is equal to one. Builds the alias table used for sampling.
    */
   void CalculateFacetProbability();
+  /**
+   * @brief Returns index of a facet selected with probability of its area share
+   */
+  size_t RandomFacetIdx() const;
   /**
    * @brief returns edges of selected facet
-   * @param facet Facet to get edges from
+   * @param facet Index of the facet to get edges from
    * @return
    */
-  static FacetEdges GetFacetLines(const G4TriangularFacet &facet) ;
+  FacetEdges GetFacetLines(std::size_t facet) const;
+  /// Uniformly distributed point on facet i, without transformation
+  G4ThreeVector GetPointOnFacet(std::size_t i) const;
 
-  std::vector<G4TriangularFacet *>
-      fFacetVector;  ///< vector of Triangular Facets
+  std::vector<G4ThreeVector> fVertices;  ///< vertices A, B, C of all facets
+  std::vector<G4ThreeVector> fEdgesAB;   ///< B - A
+  std::vector<G4ThreeVector> fEdgesAC;   ///< C - A
+  std::vector<G4ThreeVector> fNormals;   ///< unit normals
+  std::vector<G4double> fFacetArea;      ///< area of single facets
   std::vector<G4double>
       fFacetProbability;  ///< Stores share of single Triangular Facet area to
                           ///< total area.
-  G4bool fClosed{false};  ///< Indicates if Facet Store is closed and facets can
-                          ///< not be added anymore.
+  Surface::AliasTable fFacetSampler;  ///< O(1) facet selection
+  std::atomic<G4bool> fClosed{false};  ///< Indicates if Facet Store is closed
+                                       ///< and facets can not be added anymore.
+  G4double fArea{0};  ///< Total area of all facets
+  mutable SurfaceStatistics fStatistics;  ///< Cache of GetStatistics()
+  mutable G4bool fStatisticsValid{false};
   G4ThreeVector fTransform; ///< Stores coordinates of FacetStore
   G4String fName;
   Surface::Logger fLogger;
@@ -39,6 +39,12 @@ class SurfaceGenerator {
    */
   void GenerateSurface();
 
+  /**
+   * @brief Generate solid from a known description, without calling the
+   * Describer. The outer facets have to be in the FacetStore already.
+   */
+  void GenerateSurface(const std::vector<SolidDescription> &description);
+
   /**
    * @brief Reference to describer instance. Is used to define the patch of rough surface using parameters
    * @return Reference to describer instance.
@@ -62,6 +68,8 @@ class SurfaceGenerator {
    * @brief Calls and executes Assembler to generate a Solid based on description
    */
   void Assemble();
+  void Assemble(const std::vector<SolidDescription> &description,
+                G4bool fillFacetStore);
 
   /**
    * @brief Calls calculator to get SurfaceParameters
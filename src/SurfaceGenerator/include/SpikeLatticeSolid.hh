@@ -0,0 +1,148 @@
+/**
+ * @brief Analytic solid of a regular lattice of spikes on a basis box
+ * @author agent
+ * @date 2026-10-17
+ * @file SpikeLatticeSolid.hh
+ */
+
+#ifndef SRC_SURFACEGENERATOR_INCLUDE_SPIKELATTICESOLID_HH
+#define SRC_SURFACEGENERATOR_INCLUDE_SPIKELATTICESOLID_HH
+
+#include <cstdint>
+#include <vector>
+
+#include "G4ThreeVector.hh"
+#include "G4VSolid.hh"
+#include "SurfaceGenerator/include/Describer.hh"
+
+namespace Surface {
+
+class FacetStore;
+
+/**
+ * @brief SpikeLatticeSolid describes the same rough patch as the G4MultiUnion
+ * built by SurfaceGenerator, without a node per spike.
+ * @details The patch consists of a basis box spanning
+ * [-nX*spikeDx, nX*spikeDx] x [-nY*spikeDy, nY*spikeDy] x [-2*basisDz, 0] and
+ * one spike per lattice cell with cell half widths (spikeDx, spikeDy). A spike
+ * is a stack of Trd layers, identical for all cells except for the height of
+ * UniformPyramid spikes, which is derived from a seeded hash of the cell.
+ * The cell of a point is found by integer division, rays walk the cells with a
+ * 2D DDA and only test the spikes of visited cells. Memory does not depend on
+ * the number of spikes.
+ */
+class SpikeLatticeSolid : public G4VSolid {
+ public:
+  SpikeLatticeSolid(const G4String &name, Describer::SpikeShape shape,
+                    G4int nX, G4int nY, G4double spikeDx, G4double spikeDy,
+                    G4double meanHeight, G4double heightDeviation,
+                    G4int nLayer, G4double basisDz, std::uint64_t seed = 0);
+  ~SpikeLatticeSolid() override = default;
+
+  EInside Inside(const G4ThreeVector &p) const override;
+  G4ThreeVector SurfaceNormal(const G4ThreeVector &p) const override;
+  G4double DistanceToIn(const G4ThreeVector &p,
+                        const G4ThreeVector &v) const override;
+  G4double DistanceToIn(const G4ThreeVector &p) const override;
+  G4double DistanceToOut(const G4ThreeVector &p, const G4ThreeVector &v,
+                         G4bool calcNorm = false, G4bool *validNorm = nullptr,
+                         G4ThreeVector *n = nullptr) const override;
+  G4double DistanceToOut(const G4ThreeVector &p) const override;
+
+  void BoundingLimits(G4ThreeVector &pMin, G4ThreeVector &pMax) const override;
+  G4bool CalculateExtent(EAxis pAxis, const G4VoxelLimits &pVoxelLimit,
+                         const G4AffineTransform &pTransform, G4double &pMin,
+                         G4double &pMax) const override;
+
+  G4double GetCubicVolume() override { return fCubicVolume; }
+  G4double GetSurfaceArea() override { return fSurfaceArea; }
+  G4ThreeVector GetPointOnSurface() const override;
+
+  G4GeometryType GetEntityType() const override;
+  G4VSolid *Clone() const override;
+  std::ostream &StreamInfo(std::ostream &os) const override;
+
+  void DescribeYourselfTo(G4VGraphicsScene &scene) const override;
+  G4Polyhedron *CreatePolyhedron() const override;
+
+  /**
+   * @brief Appends the outer surface of all spikes to a FacetStore, with the
+   * same facets the Assembler would create for the G4MultiUnion
+   */
+  void FillFacetStore(FacetStore *store) const;
+
+  /**
+   * @brief Height of the spike in cell (ix, iy)
+   */
+  G4double CellHeight(G4int ix, G4int iy) const;
+
+  inline G4int GetNx() const { return fNx; }
+  inline G4int GetNy() const { return fNy; }
+  inline G4double GetMaxHeight() const { return fMaxHeight; }
+
+ private:
+  /// plane n*q <= d in coordinates relative to a cell center
+  struct Plane {
+    G4ThreeVector n;
+    G4double d;
+  };
+
+  G4int CellX(G4double x) const;
+  G4int CellY(G4double y) const;
+  inline G4double CellCenterX(G4int ix) const {
+    return -fX + (2 * ix + 1) * fDx;
+  }
+  inline G4double CellCenterY(G4int iy) const {
+    return -fY + (2 * iy + 1) * fDy;
+  }
+
+  std::size_t NumberOfLayers() const { return fLayerZ.size() - 1; }
+  void LayerPlanes(std::size_t layer, G4double height, Plane planes[6]) const;
+  void BasisPlanes(Plane planes[6]) const;
+  G4double SpikeDistance(G4double u, G4double v, G4double z,
+                         G4double height) const;
+
+  G4double CellSpikeArea(G4double height) const;
+  G4double CellSpikeVolume(G4double height) const;
+
+  static G4bool ClipConvex(const Plane planes[6], const G4ThreeVector &p,
+                           const G4ThreeVector &v, G4double &tIn,
+                           G4double &tOut, G4int &outPlane);
+  static G4bool ClipSlabs(const G4ThreeVector &p, const G4ThreeVector &v,
+                          const G4ThreeVector &lo, const G4ThreeVector &hi,
+                          G4double &tMin, G4double &tMax);
+
+  template <class F>
+  void WalkCells(const G4ThreeVector &p, const G4ThreeVector &v, G4double tMin,
+                 G4double tMax, F &&visit) const;
+
+  void InitProfile(G4double meanHeight, G4int nLayer);
+  void InitVolumeAndArea();
+
+ private:
+  Describer::SpikeShape fShape;
+  G4int fNx;
+  G4int fNy;
+  G4double fDx;  ///< half width of a cell
+  G4double fDy;
+  G4double fX;   ///< half width of the patch
+  G4double fY;
+  G4double fZBottom;       ///< lower end of basis box
+  G4double fHeight;        ///< height of a spike (UniformPyramid: mean)
+  G4double fHeightDeviation;
+  G4double fMaxHeight;     ///< highest spike in the lattice
+  std::uint64_t fSeed;
+
+  std::vector<G4double> fLayerZ;   ///< layer boundaries relative to height
+  std::vector<G4double> fLayerWx;  ///< half widths at layer boundaries
+  std::vector<G4double> fLayerWy;
+
+  G4double fCubicVolume{0};
+  G4double fSurfaceArea{0};
+  G4double fSpikeArea{0};
+  G4double fMaxCellArea{0};
+  G4double fHalfTolerance;
+};
+}  // namespace Surface
+
+#endif  // SRC_SURFACEGENERATOR_INCLUDE_SPIKELATTICESOLID_HH
@@ -0,0 +1,49 @@
+/**
+ * @brief Roughness parameters of a triangulated surface
+ * @author agent
+ * @date 2026-10-17
+ * @file SurfaceStatistics.hh
+ */
+
+#ifndef SRC_SURFACEGENERATOR_INCLUDE_SURFACESTATISTICS_HH
+#define SRC_SURFACEGENERATOR_INCLUDE_SURFACESTATISTICS_HH
+
+#include "G4Types.hh"
+
+namespace Surface {
+
+class FacetStore;
+
+/**
+ * @brief SurfaceStatistics holds the roughness parameters of the facets of a
+ * FacetStore, heights are the z components of the vertices.
+ * @details Every facet is a plane over its projection on xy, so all integrals
+ * are closed form: \f$ \int_T z^k dxdy = \frac{2 A_T}{(k+1)(k+2)}
+ * h_k(z_1,z_2,z_3) \f$ with the projected area \f$ A_T \f$ and the complete
+ * homogeneous polynomial \f$ h_k \f$ of the vertex heights. Facets crossing
+ * the mean height contribute to Sa with the part cut off by the mean plane.
+ * Compute() needs two passes over the facets, the first for the mean height,
+ * the second for the moments around it (Sa, Sq, Ssk, Sku). Each pass sums
+ * fixed blocks of facets on several threads and adds the block sums pairwise
+ * in a fixed order, the result does not depend on the number of threads.
+ */
+struct SurfaceStatistics {
+  G4double ProjectedSurface{};  ///< Area of projected surface
+  G4double MeanHeight{};        ///< Mean height
+  G4double Sz{};                ///< Maximum Height
+  G4double Sa{};                ///< Arithmetical mean height
+  G4double Sv{};                ///< Maximum pit height
+  G4double Sp{};                ///< Maximum peak height
+  G4double Sku{};               ///< Kurtosis
+  G4double Ssk{};               ///< Skewness
+  G4double Sq{};                ///< Root mean square height
+  G4double Area{};              ///< Area of surface
+
+  /**
+   * @param threads number of threads, <= 0: all hardware threads
+   */
+  static SurfaceStatistics Compute(const FacetStore &store, G4int threads = 0);
+};
+}  // namespace Surface
+
+#endif  // SRC_SURFACEGENERATOR_INCLUDE_SURFACESTATISTICS_HH
@@ -11,7 +11,6 @@
 #include "G4ThreeVector.hh"
 #include "G4Transform3D.hh"
 #include "G4Trd.hh"
-#include "G4TriangularFacet.hh"
 #include "G4VFacet.hh"
 #include "SurfaceGenerator/include/FacetStore.hh"
 #include "SurfaceGenerator/include/Storage.hh"
@@ -21,7 +20,7 @@ using Volumetype = Surface::SolidDescription::Solid;
 Surface::Assembler::Assembler(FacetStore *store)
     : fLogger("Assembler"), fFacetStore(store) {}
 
-void Surface::Assembler::Assemble() {
+void Surface::Assembler::Assemble(const G4bool fillFacetStore) {
   auto *AssembledSolid = new G4MultiUnion;
   for (const auto &description : fDescription) {
     G4VSolid *newSolid = GetSingleSolid(description);
@@ -40,7 +39,9 @@ void Surface::Assembler::Assemble() {
     }
     G4Transform3D transform{description.Transform};
     AssembledSolid->AddNode(*newSolid, transform);
-    AddToFacetStore(description);
+    if (fillFacetStore) {
+      AddToFacetStore(description);
+    }
   }
   fSolid = AssembledSolid;
   fLogger.WriteInfo("Finished assemble");
@@ -60,11 +61,11 @@ for (G4int i = 0; i < NVertices; ++i) {
       Tmp_Vertices.emplace_back(
           Vertices[i].x(), Vertices[i].y(), Vertices[i].z());
     }
-    fFacetStore->AppendToFacetVector(new G4TriangularFacet{
-        Tmp_Vertices[0], Tmp_Vertices[1], Tmp_Vertices[2], ABSOLUTE});
+    fFacetStore->AppendFacet(Tmp_Vertices[0], Tmp_Vertices[1],
+                             Tmp_Vertices[2]);
     if (NVertices == 4) {
-      fFacetStore->AppendToFacetVector(new G4TriangularFacet{
-          Tmp_Vertices[0], Tmp_Vertices[2], Tmp_Vertices[3], ABSOLUTE});
+      fFacetStore->AppendFacet(Tmp_Vertices[0], Tmp_Vertices[2],
+                               Tmp_Vertices[3]);
     }
   }
   delete newSolid;
@@ -11,6 +11,7 @@
 #include <iomanip>
 #include <iostream>
 
+#include "G4AutoLock.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4ThreeVector.hh"
 #include "G4TriangularFacet.hh"
@@ -19,63 +20,117 @@
 #include "G4UImanager.hh"
 #include "Randomize.hh"
 
+namespace {
+G4Mutex closeFacetStoreMutex = G4MUTEX_INITIALIZER;
+G4Mutex statisticsMutex = G4MUTEX_INITIALIZER;
+}  // namespace
+
+Surface::FacetStore::FacetStore(const FacetStore &other)
+    : fVertices(other.fVertices),
+      fEdgesAB(other.fEdgesAB),
+      fEdgesAC(other.fEdgesAC),
+      fNormals(other.fNormals),
+      fFacetArea(other.fFacetArea),
+      fFacetProbability(other.fFacetProbability),
+      fFacetSampler(other.fFacetSampler),
+      fClosed(other.GetIsStoreClosed()),
+      fArea(other.fArea),
+      fStatistics(other.fStatistics),
+      fStatisticsValid(other.fStatisticsValid),
+      fTransform(other.fTransform),
+      fName(other.fName),
+      fLogger(other.fLogger) {}
+
+Surface::FacetStore &Surface::FacetStore::operator=(const FacetStore &other) {
+  if (this == &other) {
+    return *this;
+  }
+  fVertices = other.fVertices;
+  fEdgesAB = other.fEdgesAB;
+  fEdgesAC = other.fEdgesAC;
+  fNormals = other.fNormals;
+  fFacetArea = other.fFacetArea;
+  fFacetProbability = other.fFacetProbability;
+  fFacetSampler = other.fFacetSampler;
+  fArea = other.fArea;
+  fStatistics = other.fStatistics;
+  fStatisticsValid = other.fStatisticsValid;
+  fTransform = other.fTransform;
+  fName = other.fName;
+  fLogger = other.fLogger;
+  fClosed.store(other.GetIsStoreClosed(), std::memory_order_release);
+  return *this;
+}
+
 void Surface::FacetStore::CloseFacetStore() {
+  // stores may be shared between worker threads
+  G4AutoLock lock(&closeFacetStoreMutex);
   if (GetIsStoreClosed()) {
     return;
   }
   CalculateFacetProbability();
-  fClosed = true;
+  // publishes the sampler to threads seeing the store closed
+  fClosed.store(true, std::memory_order_release);
   fLogger.WriteInfo(StreamInfo().str());
 }
 
 void Surface::FacetStore::CalculateFacetProbability() {
   G4double TotalArea{0};
-  for (auto &facet : fFacetVector) {
-    TotalArea += facet->GetArea();
+  for (const auto area : fFacetArea) {
+    TotalArea += area;
   }
-  fFacetProbability.reserve(fFacetVector.size());
+  fFacetProbability.reserve(fFacetArea.size());
   G4double AreaTmp{0};
   // Calculates probability and sums it up
-  for (auto &facet : fFacetVector) {
-    AreaTmp += facet->GetArea();
+  for (const auto area : fFacetArea) {
+    AreaTmp += area;
     fFacetProbability.emplace_back(AreaTmp / TotalArea);
   }
+  fFacetSampler.Build(fFacetArea);
+  fArea = TotalArea;
 }
 
-G4ThreeVector Surface::FacetStore::GetRandomPoint() const {
-  G4double random = G4UniformRand();
-  for (size_t i = 0; i < fFacetProbability.size(); ++i) {
-    if (random <= fFacetProbability[i]) {
-      auto point = fFacetVector[i]->GetPointOnFace();
-      point = fTransform + point;
-      return point;
-    }
+size_t Surface::FacetStore::RandomFacetIdx() const {
+  if (fFacetSampler.IsEmpty()) {
+    fLogger.WriteError("No facet to sample from, FacetStore not closed");
+    exit(EXIT_FAILURE);
+  }
+  return fFacetSampler.Sample();
+}
+
+G4ThreeVector Surface::FacetStore::GetPointOnFacet(const std::size_t i) const {
+  G4double u = G4UniformRand();
+  G4double v = G4UniformRand();
+  if (u + v > 1.) {
+    u = 1. - u;
+    v = 1. - v;
   }
-  exit(EXIT_FAILURE);
+  return fVertices[3 * i] + u * fEdgesAB[i] + v * fEdgesAC[i];
+}
+
+G4ThreeVector Surface::FacetStore::GetRandomPoint() const {
+  const size_t i = RandomFacetIdx();
+  auto point = GetPointOnFacet(i);
+  point = fTransform + point;
+  return point;
 }
 
 G4ThreeVector Surface::FacetStore::GetRandomPoint(
     G4ThreeVector &surfaceNormal) {
-  G4double random = G4UniformRand();
-  for (size_t i = 0; i < fFacetProbability.size(); ++i) {
-    if (random <= fFacetProbability[i]) {
-      auto point = fFacetVector[i]->GetPointOnFace();
-      surfaceNormal = fFacetVector[i]->GetSurfaceNormal();
-      surfaceNormal /= surfaceNormal.r();
-      point = fTransform + point;
-      return point;
-    }
-  }
-  exit(EXIT_FAILURE);
+  const size_t i = RandomFacetIdx();
+  auto point = GetPointOnFacet(i);
+  surfaceNormal = fNormals[i];
+  point = fTransform + point;
+  return point;
 }
 
 Surface::FacetStore::FacetEdges Surface::FacetStore::GetFacetLines(
-    const G4TriangularFacet &aFacet) {
+    const std::size_t aFacet) const {
   G4String (*toStr)(G4double) = G4UIcommand::ConvertToString;
   G4String edgeAB, edgeBC, edgeCA, edgeAMid;
-  auto vertexA = aFacet.GetVertex(0);
-  auto vertexB = aFacet.GetVertex(1);
-  auto vertexC = aFacet.GetVertex(2);
+  const auto &vertexA = GetVertex(aFacet, 0);
+  const auto &vertexB = GetVertex(aFacet, 1);
+  const auto &vertexC = GetVertex(aFacet, 2);
   auto vertexMid = (vertexB + vertexC) / 2.;
   edgeAB = toStr(vertexA.getX()) + " " + toStr(vertexA.getY()) + " " +
            toStr(vertexA.getZ()) + " " + toStr(vertexB.getX()) + " " +
@@ -98,8 +153,8 @@ void Surface::FacetStore::DrawFacets() {
   UI->ApplyCommand("/vis/set/colour 1 0 0");
   UI->ApplyCommand("/vis/set/linewidth 1.5");
 
-  for (const auto &facet : fFacetVector) {
-    FacetEdges edges{GetFacetLines(*facet)};
+  for (std::size_t facet = 0; facet < fFacetArea.size(); ++facet) {
+    FacetEdges edges{GetFacetLines(facet)};
     UI->ApplyCommand("/vis/scene/add/line " + edges.edgeAB);
     UI->ApplyCommand("/vis/scene/add/line " + edges.edgeBC);
     UI->ApplyCommand("/vis/scene/add/line " + edges.edgeCA);
@@ -118,7 +173,34 @@ void Surface::FacetStore::LogFacetStore(const G4String &&aFilename) const {
 }
 
 void Surface::FacetStore::AppendToFacetVector(G4TriangularFacet *aFacet) {
-  fFacetVector.push_back(aFacet);
+  AppendFacet(aFacet->GetVertex(0), aFacet->GetVertex(1),
+              aFacet->GetVertex(2));
+  delete aFacet;
+}
+
+void Surface::FacetStore::AppendFacet(const G4ThreeVector &a,
+                                      const G4ThreeVector &b,
+                                      const G4ThreeVector &c) {
+  const G4ThreeVector edgeAB = b - a;
+  const G4ThreeVector edgeAC = c - a;
+  const G4ThreeVector cross = edgeAB.cross(edgeAC);
+  fVertices.push_back(a);
+  fVertices.push_back(b);
+  fVertices.push_back(c);
+  fEdgesAB.push_back(edgeAB);
+  fEdgesAC.push_back(edgeAC);
+  fNormals.push_back(cross.unit());
+  fFacetArea.push_back(0.5 * cross.mag());
+  fStatisticsValid = false;
+}
+
+const Surface::SurfaceStatistics &Surface::FacetStore::GetStatistics() const {
+  G4AutoLock lock(&statisticsMutex);
+  if (!fStatisticsValid) {
+    fStatistics = SurfaceStatistics::Compute(*this);
+    fStatisticsValid = true;
+  }
+  return fStatistics;
 }
 
 void Surface::FacetStore::LogFacetStore(const G4String &aFilename) const {
@@ -131,11 +213,10 @@ void Surface::FacetStore::LogFacetStore(const G4String &aFilename) const {
     G4cout << "File not open" << G4endl;
     return;
   }
-  for (size_t i = 0; i < fFacetVector.size(); ++i) {
-    auto *face = fFacetVector.at(i);
-    out << std::fixed << std::setprecision(10) << face->GetVertex(0) << " , ";
-    out << std::fixed << std::setprecision(10) << face->GetVertex(1) << " , ";
-    out << std::fixed << std::setprecision(10) << face->GetVertex(2) << " , ";
+  for (size_t i = 0; i < fFacetArea.size(); ++i) {
+    out << std::fixed << std::setprecision(10) << GetVertex(i, 0) << " , ";
+    out << std::fixed << std::setprecision(10) << GetVertex(i, 1) << " , ";
+    out << std::fixed << std::setprecision(10) << GetVertex(i, 2) << " , ";
     out << std::fixed << std::setprecision(10) << fFacetProbability.at(i)
         << "\n";
   }
@@ -151,7 +232,7 @@ std::stringstream Surface::FacetStore::StreamInfo() const {
   ss << "**************************************************\n";
   ss << "\n";
   ss << "Name: " << fName << "\n";
-  ss << "Number of Facets: " << fFacetVector.size() << "\n";
+  ss << "Number of Facets: " << fFacetArea.size() << "\n";
 
   if (fLogger.IsDetailInfoLvl()) {
     ss << "\n";
@@ -162,16 +243,15 @@ std::stringstream Surface::FacetStore::StreamInfo() const {
     }
     ss << "\n";
     G4double previousProbability{0};
-    for (size_t i = 0; i < fFacetVector.size(); ++i) {
-      const auto *facet = fFacetVector.at(i);
+    for (size_t i = 0; i < fFacetArea.size(); ++i) {
       ss << std::setw(5) << i << ",";
       if (fLogger.IsDebugInfoLvl()) {
-        ss << std::fixed << std::setprecision(10) << facet->GetVertex(0) << ",";
-        ss << std::fixed << std::setprecision(10) << facet->GetVertex(1) << ",";
-        ss << std::fixed << std::setprecision(10) << facet->GetVertex(2) << ",";
+        ss << std::fixed << std::setprecision(10) << GetVertex(i, 0) << ",";
+        ss << std::fixed << std::setprecision(10) << GetVertex(i, 1) << ",";
+        ss << std::fixed << std::setprecision(10) << GetVertex(i, 2) << ",";
       }
       ss << std::fixed << std::setprecision(10)
-         << facet->GetArea() / (CLHEP::mm * CLHEP::mm) << ",";
+         << fFacetArea[i] / (CLHEP::mm * CLHEP::mm) << ",";
       ss << std::fixed << std::setprecision(10)
          << (fFacetProbability.at(i) - previousProbability) * 100. << "\n";
       previousProbability = fFacetProbability.at(i);
@@ -186,13 +266,3 @@ std::stringstream Surface::FacetStore::StreamInfo() const {
 void Surface::FacetStore::PrintInfo() const {
   G4cout << StreamInfo().str() << G4endl;
 }
-
-std::vector<G4TriangularFacet *>::const_iterator
-Surface::FacetStore::GetIterBegin() const {
-  return fFacetVector.cbegin();
-}
-
-std::vector<G4TriangularFacet *>::const_iterator
-Surface::FacetStore::GetIterEnd() const {
-  return fFacetVector.cend();
-}
@@ -7,6 +7,7 @@
 
 #include "SurfaceGenerator/include/Generator.hh"
 #include "Service/include/Logger.hh"
+#include "Service/include/Profiler.hh"
 #include "SurfaceGenerator/include/Assembler.hh"
 #include "SurfaceGenerator/include/Calculator.hh"
 #include "SurfaceGenerator/include/Describer.hh"
@@ -28,25 +29,38 @@ void Surface::SurfaceGenerator::GenerateSurface() {
   Calculate();
 }
 
+void Surface::SurfaceGenerator::GenerateSurface(
+    const std::vector<SolidDescription> &description) {
+  Assemble(description, false);
+  Calculate();
+}
+
 void Surface::SurfaceGenerator::Assemble() {
-  fLogger.WriteDetailInfo("Calling assemble");
-  const auto description = fDescriber.GetSolidDescription();
+  Assemble(fDescriber.GetSolidDescription(), true);
+}
 
+void Surface::SurfaceGenerator::Assemble(
+    const std::vector<SolidDescription> &description,
+    const G4bool fillFacetStore) {
+  SCORE4_PROFILE_SCOPE("Assembler::Assemble");
+  fLogger.WriteDetailInfo("Calling assemble");
   Surface::Assembler Assembler(fFacetStore);
   Assembler.SetDescription(description);
-  Assembler.Assemble();
+  Assembler.Assemble(fillFacetStore);
   fSolidHandle = Assembler.GetSolid();
   fLogger.WriteDetailInfo("Number of solids used for Assemble: " +
                           std::to_string(fSolidHandle->GetNumberOfSolids()));
 }
 
 void Surface::SurfaceGenerator::Calculate() {
+  SCORE4_PROFILE_SCOPE("Calculator::PrintSurfaceInformation");
   fLogger.WriteDetailInfo("Calling calculate");
   const Calculator calculator{fFacetStore};
   calculator.PrintSurfaceInformation();
 }
 
 void Surface::SurfaceGenerator::GenerateDescription() {
+  SCORE4_PROFILE_SCOPE("Describer::Generate");
   fLogger.WriteDetailInfo("Calling description");
   fDescriber.Generate();
   fLogger.WriteDebugInfo(fDescriber.GetInfoDescription());
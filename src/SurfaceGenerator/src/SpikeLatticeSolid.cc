@@ -0,0 +1,867 @@
+/**
+ * @brief Implementation of SpikeLatticeSolid class
+ * @author agent
+ * @date 2026-10-17
+ * @file SpikeLatticeSolid.cc
+ */
+
+#include "SurfaceGenerator/include/SpikeLatticeSolid.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "G4BoundingEnvelope.hh"
+#include "G4Exception.hh"
+#include "G4GeometryTolerance.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4PolyhedronArbitrary.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4VGraphicsScene.hh"
+#include "Randomize.hh"
+#include "SurfaceGenerator/include/FacetStore.hh"
+
+namespace {
+// width of the tip of a spike, same as used by Spike
+const G4double kTopWidth = 1e-3 * CLHEP::nm;
+
+/**
+ * @brief Uniform number in (0,1) from cell (ix,iy), counter based hash
+ * (splitmix64)
+ */
+G4double HashUniform(const std::uint64_t seed, const G4int ix, const G4int iy,
+                     const std::uint64_t stream) {
+  std::uint64_t z = seed + stream * 0xd1b54a32d192ed03ULL +
+                    ((static_cast<std::uint64_t>(ix) << 32) |
+                     static_cast<std::uint32_t>(iy)) *
+                        0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  z = z ^ (z >> 31);
+  return (static_cast<G4double>(z >> 11) + 0.5) / 9007199254740992.;  // 2^53
+}
+}  // namespace
+
+Surface::SpikeLatticeSolid::SpikeLatticeSolid(
+    const G4String &name, const Describer::SpikeShape shape, const G4int nX,
+    const G4int nY, const G4double spikeDx, const G4double spikeDy,
+    const G4double meanHeight, const G4double heightDeviation,
+    const G4int nLayer, const G4double basisDz, const std::uint64_t seed)
+    : G4VSolid(name),
+      fShape(shape),
+      fNx(nX),
+      fNy(nY),
+      fDx(spikeDx),
+      fDy(spikeDy),
+      fX(nX * spikeDx),
+      fY(nY * spikeDy),
+      fZBottom(-2. * basisDz),
+      fHeight(meanHeight),
+      fHeightDeviation(heightDeviation),
+      fMaxHeight(0),
+      fSeed(seed),
+      fHalfTolerance(
+          0.5 * G4GeometryTolerance::GetInstance()->GetSurfaceTolerance()) {
+  if (fNx < 1 || fNy < 1 || fDx <= 0 || fDy <= 0 || meanHeight <= 0 ||
+      basisDz <= 0) {
+    G4Exception("SpikeLatticeSolid::SpikeLatticeSolid()", "", FatalException,
+                ("Invalid dimensions for solid " + name).c_str());
+  }
+  InitProfile(meanHeight, nLayer);
+  InitVolumeAndArea();
+}
+
+void Surface::SpikeLatticeSolid::InitProfile(const G4double meanHeight,
+                                             const G4int nLayer) {
+  fLayerZ.clear();
+  fLayerWx.clear();
+  fLayerWy.clear();
+  switch (fShape) {
+    case Describer::SpikeShape::StandardPyramid:
+    case Describer::SpikeShape::UniformPyramid:
+      // Trd with half length equal to the height, see Spike::GeneratePyramid
+      fHeight = fShape == Describer::SpikeShape::StandardPyramid
+                    ? 2. * meanHeight
+                    : meanHeight;
+      fLayerZ = {0., 1.};
+      fLayerWx = {fDx, kTopWidth};
+      fLayerWy = {fDy, kTopWidth};
+      return;
+    case Describer::SpikeShape::Bump:
+    case Describer::SpikeShape::Peak: {
+      fHeight = meanHeight;
+      const G4int layers = std::max(nLayer, 1);
+      for (G4int i = 0; i < layers; ++i) {
+        const G4double zRel = static_cast<G4double>(i) / layers;
+        // shape functions of Spike::FunctionBump and Spike::FunctionPeak
+        const G4double width = fShape == Describer::SpikeShape::Bump
+                                   ? 1. - zRel * zRel
+                                   : 1. / (5. * zRel + 1.);
+        fLayerZ.push_back(zRel);
+        fLayerWx.push_back(fDx * width);
+        fLayerWy.push_back(fDy * width);
+      }
+      fLayerZ.push_back(1.);
+      fLayerWx.push_back(kTopWidth);
+      fLayerWy.push_back(kTopWidth);
+      return;
+    }
+  }
+}
+
+void Surface::SpikeLatticeSolid::InitVolumeAndArea() {
+  const G4double basisHeight = -fZBottom;
+  const G4double basisVolume = 4. * fX * fY * basisHeight;
+  // top of basis is covered by spikes
+  const G4double basisArea =
+      4. * fX * fY + 4. * fX * basisHeight + 4. * fY * basisHeight;
+  G4double spikeVolume{0};
+  fSpikeArea = 0;
+  fMaxCellArea = 0;
+  fMaxHeight = 0;
+  if (fShape == Describer::SpikeShape::UniformPyramid) {
+    for (G4int ix = 0; ix < fNx; ++ix) {
+      for (G4int iy = 0; iy < fNy; ++iy) {
+        const G4double height = CellHeight(ix, iy);
+        const G4double area = CellSpikeArea(height);
+        spikeVolume += CellSpikeVolume(height);
+        fSpikeArea += area;
+        fMaxCellArea = std::max(fMaxCellArea, area);
+        fMaxHeight = std::max(fMaxHeight, height);
+      }
+    }
+  } else {
+    const G4double cells = static_cast<G4double>(fNx) * fNy;
+    fMaxCellArea = CellSpikeArea(fHeight);
+    fMaxHeight = fHeight;
+    spikeVolume = cells * CellSpikeVolume(fHeight);
+    fSpikeArea = cells * fMaxCellArea;
+  }
+  fCubicVolume = basisVolume + spikeVolume;
+  fSurfaceArea = basisArea + fSpikeArea;
+}
+
+G4double Surface::SpikeLatticeSolid::CellHeight(const G4int ix,
+                                                const G4int iy) const {
+  if (fShape != Describer::SpikeShape::UniformPyramid) {
+    return fHeight;
+  }
+  // gaussian height as in Describer::GetUniformPyramid (Box-Muller)
+  const G4double u1 = HashUniform(fSeed, ix, iy, 0);
+  const G4double u2 = HashUniform(fSeed, ix, iy, 1);
+  const G4double gauss =
+      std::sqrt(-2. * std::log(u1)) * std::cos(CLHEP::twopi * u2);
+  G4double height = fHeight + fHeightDeviation * gauss;
+  if (height <= 0.) {
+    height = 1e-9;
+  }
+  return 2. * height;
+}
+
+G4double Surface::SpikeLatticeSolid::CellSpikeArea(
+    const G4double height) const {
+  G4double area{0};
+  for (std::size_t k = 0; k < NumberOfLayers(); ++k) {
+    const G4double dz = (fLayerZ[k + 1] - fLayerZ[k]) * height;
+    const G4double dWx = fLayerWx[k] - fLayerWx[k + 1];
+    const G4double dWy = fLayerWy[k] - fLayerWy[k + 1];
+    // two trapezoids per direction
+    area += 2. * (fLayerWy[k] + fLayerWy[k + 1]) *
+            std::sqrt(dz * dz + dWx * dWx);
+    area += 2. * (fLayerWx[k] + fLayerWx[k + 1]) *
+            std::sqrt(dz * dz + dWy * dWy);
+  }
+  area += 4. * fLayerWx.back() * fLayerWy.back();
+  return area;
+}
+
+G4double Surface::SpikeLatticeSolid::CellSpikeVolume(
+    const G4double height) const {
+  G4double volume{0};
+  for (std::size_t k = 0; k < NumberOfLayers(); ++k) {
+    const G4double dz = (fLayerZ[k + 1] - fLayerZ[k]) * height;
+    const G4double midX = 0.5 * (fLayerWx[k] + fLayerWx[k + 1]);
+    const G4double midY = 0.5 * (fLayerWy[k] + fLayerWy[k + 1]);
+    // cross-section is quadratic in z, Simpson's rule is exact
+    volume += dz / 6. *
+              (4. * fLayerWx[k] * fLayerWy[k] + 16. * midX * midY +
+               4. * fLayerWx[k + 1] * fLayerWy[k + 1]);
+  }
+  return volume;
+}
+
+G4int Surface::SpikeLatticeSolid::CellX(const G4double x) const {
+  const auto ix = static_cast<G4int>(std::floor((x + fX) / (2. * fDx)));
+  return std::min(std::max(ix, 0), fNx - 1);
+}
+
+G4int Surface::SpikeLatticeSolid::CellY(const G4double y) const {
+  const auto iy = static_cast<G4int>(std::floor((y + fY) / (2. * fDy)));
+  return std::min(std::max(iy, 0), fNy - 1);
+}
+
+void Surface::SpikeLatticeSolid::LayerPlanes(const std::size_t layer,
+                                             const G4double height,
+                                             Plane planes[6]) const {
+  const G4double z0 = fLayerZ[layer] * height;
+  const G4double z1 = fLayerZ[layer + 1] * height;
+  const G4double slopeX = (fLayerWx[layer + 1] - fLayerWx[layer]) / (z1 - z0);
+  const G4double slopeY = (fLayerWy[layer + 1] - fLayerWy[layer]) / (z1 - z0);
+  const G4double dX = fLayerWx[layer] - slopeX * z0;
+  const G4double dY = fLayerWy[layer] - slopeY * z0;
+  planes[0] = Plane{G4ThreeVector(0, 0, -1), -z0};
+  planes[1] = Plane{G4ThreeVector(0, 0, 1), z1};
+  planes[2] = Plane{G4ThreeVector(1, 0, -slopeX), dX};
+  planes[3] = Plane{G4ThreeVector(-1, 0, -slopeX), dX};
+  planes[4] = Plane{G4ThreeVector(0, 1, -slopeY), dY};
+  planes[5] = Plane{G4ThreeVector(0, -1, -slopeY), dY};
+}
+
+void Surface::SpikeLatticeSolid::BasisPlanes(Plane planes[6]) const {
+  planes[0] = Plane{G4ThreeVector(0, 0, -1), -fZBottom};
+  planes[1] = Plane{G4ThreeVector(0, 0, 1), 0.};
+  planes[2] = Plane{G4ThreeVector(1, 0, 0), fX};
+  planes[3] = Plane{G4ThreeVector(-1, 0, 0), fX};
+  planes[4] = Plane{G4ThreeVector(0, 1, 0), fY};
+  planes[5] = Plane{G4ThreeVector(0, -1, 0), fY};
+}
+
+G4double Surface::SpikeLatticeSolid::SpikeDistance(
+    const G4double u, const G4double v, const G4double z,
+    const G4double height) const {
+  const G4double zc = std::min(std::max(z, 0.), height);
+  const G4double zRel = zc / height;
+  const auto k = static_cast<std::size_t>(
+      std::upper_bound(fLayerZ.begin() + 1, fLayerZ.end() - 1, zRel) -
+      (fLayerZ.begin() + 1));
+  const G4double z0 = fLayerZ[k] * height;
+  const G4double z1 = fLayerZ[k + 1] * height;
+  const G4double slopeX = (fLayerWx[k + 1] - fLayerWx[k]) / (z1 - z0);
+  const G4double slopeY = (fLayerWy[k + 1] - fLayerWy[k]) / (z1 - z0);
+  const G4double wx = fLayerWx[k] + slopeX * (zc - z0);
+  const G4double wy = fLayerWy[k] + slopeY * (zc - z0);
+  const G4double distX = (std::fabs(u) - wx) / std::sqrt(1. + slopeX * slopeX);
+  const G4double distY = (std::fabs(v) - wy) / std::sqrt(1. + slopeY * slopeY);
+  return std::max({distX, distY, -z, z - height});
+}
+
+G4bool Surface::SpikeLatticeSolid::ClipConvex(const Plane planes[6],
+                                              const G4ThreeVector &p,
+                                              const G4ThreeVector &v,
+                                              G4double &tIn, G4double &tOut,
+                                              G4int &outPlane) {
+  tIn = -kInfinity;
+  tOut = kInfinity;
+  outPlane = -1;
+  for (G4int i = 0; i < 6; ++i) {
+    const G4double den = planes[i].n.dot(v);
+    const G4double num = planes[i].d - planes[i].n.dot(p);
+    if (den == 0.) {
+      if (num < 0.) {
+        return false;
+      }
+      continue;
+    }
+    const G4double t = num / den;
+    if (den < 0.) {
+      tIn = std::max(tIn, t);
+    } else if (t < tOut) {
+      tOut = t;
+      outPlane = i;
+    }
+  }
+  return tIn < tOut;
+}
+
+G4bool Surface::SpikeLatticeSolid::ClipSlabs(const G4ThreeVector &p,
+                                             const G4ThreeVector &v,
+                                             const G4ThreeVector &lo,
+                                             const G4ThreeVector &hi,
+                                             G4double &tMin, G4double &tMax) {
+  tMin = -kInfinity;
+  tMax = kInfinity;
+  for (G4int axis = 0; axis < 3; ++axis) {
+    if (v[axis] == 0.) {
+      if (p[axis] < lo[axis] || p[axis] > hi[axis]) {
+        return false;
+      }
+      continue;
+    }
+    G4double t0 = (lo[axis] - p[axis]) / v[axis];
+    G4double t1 = (hi[axis] - p[axis]) / v[axis];
+    if (t0 > t1) {
+      std::swap(t0, t1);
+    }
+    tMin = std::max(tMin, t0);
+    tMax = std::min(tMax, t1);
+  }
+  return tMin <= tMax;
+}
+
+template <class F>
+void Surface::SpikeLatticeSolid::WalkCells(const G4ThreeVector &p,
+                                           const G4ThreeVector &v,
+                                           const G4double tMin,
+                                           const G4double tMax,
+                                           F &&visit) const {
+  if (tMin > tMax) {
+    return;
+  }
+  const G4ThreeVector start = p + tMin * v;
+  G4int ix = CellX(start.x());
+  G4int iy = CellY(start.y());
+  const G4double widthX = 2. * fDx;
+  const G4double widthY = 2. * fDy;
+
+  G4int stepX{0};
+  G4double nextX{kInfinity};
+  G4double deltaX{kInfinity};
+  if (v.x() > 0.) {
+    stepX = 1;
+    nextX = (-fX + (ix + 1) * widthX - p.x()) / v.x();
+    deltaX = widthX / v.x();
+  } else if (v.x() < 0.) {
+    stepX = -1;
+    nextX = (-fX + ix * widthX - p.x()) / v.x();
+    deltaX = -widthX / v.x();
+  }
+  G4int stepY{0};
+  G4double nextY{kInfinity};
+  G4double deltaY{kInfinity};
+  if (v.y() > 0.) {
+    stepY = 1;
+    nextY = (-fY + (iy + 1) * widthY - p.y()) / v.y();
+    deltaY = widthY / v.y();
+  } else if (v.y() < 0.) {
+    stepY = -1;
+    nextY = (-fY + iy * widthY - p.y()) / v.y();
+    deltaY = -widthY / v.y();
+  }
+
+  G4double t = tMin;
+  while (true) {
+    const G4double tExit = std::min({nextX, nextY, tMax});
+    if (!visit(ix, iy, t, tExit) || tExit >= tMax) {
+      return;
+    }
+    if (nextX <= nextY) {
+      ix += stepX;
+      t = nextX;
+      nextX += deltaX;
+    } else {
+      iy += stepY;
+      t = nextY;
+      nextY += deltaY;
+    }
+    if (ix < 0 || ix >= fNx || iy < 0 || iy >= fNy) {
+      return;
+    }
+  }
+}
+
+EInside Surface::SpikeLatticeSolid::Inside(const G4ThreeVector &p) const {
+  const G4double x = p.x();
+  const G4double y = p.y();
+  const G4double z = p.z();
+  if (std::fabs(x) > fX + fHalfTolerance ||
+      std::fabs(y) > fY + fHalfTolerance || z < fZBottom - fHalfTolerance ||
+      z > fMaxHeight + fHalfTolerance) {
+    return kOutside;
+  }
+  const G4double distBasis = std::max(
+      {std::fabs(x) - fX, std::fabs(y) - fY, fZBottom - z, z});
+  const G4int ix = CellX(x);
+  const G4int iy = CellY(y);
+  const G4double u = x - CellCenterX(ix);
+  const G4double v = y - CellCenterY(iy);
+  const G4double distSpike = SpikeDistance(u, v, z, CellHeight(ix, iy));
+
+  if (distBasis < -fHalfTolerance || distSpike < -fHalfTolerance) {
+    return kInside;
+  }
+  if (distBasis > fHalfTolerance && distSpike > fHalfTolerance) {
+    return kOutside;
+  }
+  if (distBasis >= -fHalfTolerance && distBasis <= fHalfTolerance &&
+      distSpike >= -fHalfTolerance && distSpike <= fHalfTolerance) {
+    // top of basis is covered by the spike bases, except for the edges
+    const G4bool onBase = std::fabs(z) <= fHalfTolerance;
+    const G4bool withinBase = std::fabs(u) < fLayerWx[0] - fHalfTolerance &&
+                              std::fabs(v) < fLayerWy[0] - fHalfTolerance;
+    const G4bool withinPatch = std::fabs(x) < fX - fHalfTolerance &&
+                               std::fabs(y) < fY - fHalfTolerance;
+    if (onBase && withinBase && withinPatch) {
+      return kInside;
+    }
+  }
+  return kSurface;
+}
+
+G4ThreeVector Surface::SpikeLatticeSolid::SurfaceNormal(
+    const G4ThreeVector &p) const {
+  struct Candidate {
+    G4double dist;
+    G4ThreeVector normal;
+  };
+  Candidate candidates[8];
+  G4int nCandidates{0};
+
+  const G4double x = p.x();
+  const G4double y = p.y();
+  const G4double z = p.z();
+  candidates[nCandidates++] =
+      Candidate{std::fabs(z - fZBottom), G4ThreeVector(0, 0, -1)};
+  if (z <= fHalfTolerance) {
+    candidates[nCandidates++] = Candidate{
+        std::fabs(fX - std::fabs(x)), G4ThreeVector(x < 0 ? -1 : 1, 0, 0)};
+    candidates[nCandidates++] = Candidate{
+        std::fabs(fY - std::fabs(y)), G4ThreeVector(0, y < 0 ? -1 : 1, 0)};
+  }
+  if (z >= -fHalfTolerance) {
+    const G4int ix = CellX(x);
+    const G4int iy = CellY(y);
+    const G4double u = x - CellCenterX(ix);
+    const G4double v = y - CellCenterY(iy);
+    const G4double height = CellHeight(ix, iy);
+    const G4double zc = std::min(std::max(z, 0.), height);
+    const auto k = static_cast<std::size_t>(
+        std::upper_bound(fLayerZ.begin() + 1, fLayerZ.end() - 1,
+                         zc / height) -
+        (fLayerZ.begin() + 1));
+    Plane planes[6];
+    LayerPlanes(k, height, planes);
+    const Plane &planeX = u < 0 ? planes[3] : planes[2];
+    const Plane &planeY = v < 0 ? planes[5] : planes[4];
+    const G4ThreeVector local(u, v, z);
+    candidates[nCandidates++] =
+        Candidate{std::fabs(planeX.n.dot(local) - planeX.d) / planeX.n.mag(),
+                  planeX.n.unit()};
+    candidates[nCandidates++] =
+        Candidate{std::fabs(planeY.n.dot(local) - planeY.d) / planeY.n.mag(),
+                  planeY.n.unit()};
+    candidates[nCandidates++] =
+        Candidate{std::fabs(z - height), G4ThreeVector(0, 0, 1)};
+  }
+
+  G4ThreeVector sum(0, 0, 0);
+  G4int nearest{0};
+  for (G4int i = 0; i < nCandidates; ++i) {
+    if (candidates[i].dist <= fHalfTolerance) {
+      sum += candidates[i].normal;
+    }
+    if (candidates[i].dist < candidates[nearest].dist) {
+      nearest = i;
+    }
+  }
+  if (sum.mag2() > 0.) {
+    return sum.unit();
+  }
+  return candidates[nearest].normal;
+}
+
+G4double Surface::SpikeLatticeSolid::DistanceToIn(
+    const G4ThreeVector &p, const G4ThreeVector &v) const {
+  const G4ThreeVector tolerance(fHalfTolerance, fHalfTolerance,
+                                fHalfTolerance);
+  const G4ThreeVector lo = G4ThreeVector(-fX, -fY, fZBottom) - tolerance;
+  const G4ThreeVector hi = G4ThreeVector(fX, fY, fMaxHeight) + tolerance;
+  G4double tMin{0};
+  G4double tMax{0};
+  if (!ClipSlabs(p, v, lo, hi, tMin, tMax) || tMax < fHalfTolerance) {
+    return kInfinity;
+  }
+
+  G4double best{kInfinity};
+  Plane planes[6];
+  G4double tIn{0};
+  G4double tOut{0};
+  G4int outPlane{-1};
+  BasisPlanes(planes);
+  if (ClipConvex(planes, p, v, tIn, tOut, outPlane) && tOut > fHalfTolerance) {
+    best = std::max(tIn, 0.);
+  }
+
+  // spikes are only in the slab above the basis
+  const G4ThreeVector loSpikes(lo.x(), lo.y(), -fHalfTolerance);
+  if (ClipSlabs(p, v, loSpikes, hi, tMin, tMax)) {
+    WalkCells(p, v, std::max(tMin, 0.), std::min(tMax, best),
+              [&](const G4int ix, const G4int iy, const G4double tCellIn,
+                  const G4double tCellOut) {
+                if (tCellIn > best) {
+                  return false;
+                }
+                const G4ThreeVector local =
+                    p - G4ThreeVector(CellCenterX(ix), CellCenterY(iy), 0);
+                const G4double height = CellHeight(ix, iy);
+                for (std::size_t k = 0; k < NumberOfLayers(); ++k) {
+                  LayerPlanes(k, height, planes);
+                  if (ClipConvex(planes, local, v, tIn, tOut, outPlane) &&
+                      tOut > fHalfTolerance) {
+                    best = std::min(best, std::max(tIn, 0.));
+                  }
+                }
+                // spikes do not leave their cell, first hit is final
+                return best > tCellOut;
+              });
+  }
+  return best < fHalfTolerance ? 0. : best;
+}
+
+G4double Surface::SpikeLatticeSolid::DistanceToIn(
+    const G4ThreeVector &p) const {
+  const G4double x = p.x();
+  const G4double y = p.y();
+  const G4double z = p.z();
+  const G4double distBox = std::max({std::fabs(x) - fX, std::fabs(y) - fY,
+                                     fZBottom - z, z - fMaxHeight});
+  if (distBox > 0.) {
+    return distBox;
+  }
+  const G4int ix = CellX(x);
+  const G4int iy = CellY(y);
+  const G4ThreeVector local(x - CellCenterX(ix), y - CellCenterY(iy), z);
+  const G4double height = CellHeight(ix, iy);
+
+  // a convex layer is not closer than its most distant plane
+  G4double distSpike{kInfinity};
+  Plane planes[6];
+  for (std::size_t k = 0; k < NumberOfLayers(); ++k) {
+    LayerPlanes(k, height, planes);
+    G4double distLayer{-kInfinity};
+    for (const Plane &plane : planes) {
+      distLayer =
+          std::max(distLayer, (plane.n.dot(local) - plane.d) / plane.n.mag());
+    }
+    distSpike = std::min(distSpike, distLayer);
+  }
+  // spikes of other cells do not leave their cell
+  const G4double distNeighbour =
+      std::min(fDx - std::fabs(local.x()), fDy - std::fabs(local.y()));
+  const G4double safety = std::min({distSpike, distNeighbour, z});
+  return safety > 0. ? safety : 0.;
+}
+
+G4double Surface::SpikeLatticeSolid::DistanceToOut(
+    const G4ThreeVector &p, const G4ThreeVector &v, const G4bool calcNorm,
+    G4bool *validNorm, G4ThreeVector *n) const {
+  const G4ThreeVector tolerance(fHalfTolerance, fHalfTolerance,
+                                fHalfTolerance);
+  const G4ThreeVector loSpikes =
+      G4ThreeVector(-fX, -fY, 0.) - tolerance;
+  const G4ThreeVector hi = G4ThreeVector(fX, fY, fMaxHeight) + tolerance;
+  G4double tMin{0};
+  G4double tMax{0};
+  const G4bool crossesSpikes = ClipSlabs(p, v, loSpikes, hi, tMin, tMax);
+  tMin = std::max(tMin, 0.);
+
+  // extend the inside interval of the ray as long as a part of the solid
+  // continues it
+  G4double end{0};
+  G4ThreeVector normal(0, 0, 1);
+  G4bool exitBasis{false};
+  Plane planes[6];
+  G4double tIn{0};
+  G4double tOut{0};
+  G4int outPlane{-1};
+  G4bool extended{true};
+  while (extended) {
+    extended = false;
+    BasisPlanes(planes);
+    if (ClipConvex(planes, p, v, tIn, tOut, outPlane) &&
+        tIn <= end + fHalfTolerance && tOut > end + fHalfTolerance) {
+      end = tOut;
+      normal = planes[outPlane].n;
+      exitBasis = true;
+      extended = true;
+    }
+    if (!crossesSpikes || tMin > end + fHalfTolerance) {
+      continue;
+    }
+    WalkCells(p, v, tMin, tMax,
+              [&](const G4int ix, const G4int iy, const G4double tCellIn,
+                  const G4double) {
+                if (tCellIn > end + fHalfTolerance) {
+                  return false;
+                }
+                const G4ThreeVector local =
+                    p - G4ThreeVector(CellCenterX(ix), CellCenterY(iy), 0);
+                const G4double height = CellHeight(ix, iy);
+                G4bool grown{true};
+                while (grown) {
+                  grown = false;
+                  for (std::size_t k = 0; k < NumberOfLayers(); ++k) {
+                    LayerPlanes(k, height, planes);
+                    if (ClipConvex(planes, local, v, tIn, tOut, outPlane) &&
+                        tIn <= end + fHalfTolerance &&
+                        tOut > end + fHalfTolerance) {
+                      end = tOut;
+                      normal = planes[outPlane].n;
+                      exitBasis = false;
+                      grown = true;
+                      extended = true;
+                    }
+                  }
+                }
+                return true;
+              });
+  }
+
+  if (calcNorm) {
+    // solid is behind the sides and the bottom of the basis
+    *validNorm = exitBasis && normal.z() <= 0.;
+    *n = normal.unit();
+  }
+  return end < fHalfTolerance ? 0. : end;
+}
+
+G4double Surface::SpikeLatticeSolid::DistanceToOut(
+    const G4ThreeVector &p) const {
+  const G4double x = p.x();
+  const G4double y = p.y();
+  const G4double z = p.z();
+  const G4double distBasis =
+      std::min({fX - std::fabs(x), fY - std::fabs(y), z - fZBottom});
+
+  const G4int ix = CellX(x);
+  const G4int iy = CellY(y);
+  const G4ThreeVector local(x - CellCenterX(ix), y - CellCenterY(iy), z);
+  const G4double height = CellHeight(ix, iy);
+  // faces of the spike, not closer than their planes
+  G4double distSpike{std::fabs(z - height)};
+  Plane planes[6];
+  for (std::size_t k = 0; k < NumberOfLayers(); ++k) {
+    LayerPlanes(k, height, planes);
+    for (G4int i = 2; i < 6; ++i) {
+      distSpike = std::min(
+          distSpike,
+          std::fabs(planes[i].n.dot(local) - planes[i].d) / planes[i].n.mag());
+    }
+  }
+  distSpike = std::min({distSpike, fDx - std::fabs(local.x()),
+                        fDy - std::fabs(local.y())});
+  // all spike faces are above the basis
+  if (z < 0.) {
+    distSpike = std::max(distSpike, -z);
+  }
+  const G4double safety = std::min(distBasis, distSpike);
+  return safety > 0. ? safety : 0.;
+}
+
+void Surface::SpikeLatticeSolid::BoundingLimits(G4ThreeVector &pMin,
+                                                G4ThreeVector &pMax) const {
+  pMin.set(-fX, -fY, fZBottom);
+  pMax.set(fX, fY, fMaxHeight);
+}
+
+G4bool Surface::SpikeLatticeSolid::CalculateExtent(
+    const EAxis pAxis, const G4VoxelLimits &pVoxelLimit,
+    const G4AffineTransform &pTransform, G4double &pMin,
+    G4double &pMax) const {
+  G4ThreeVector bmin;
+  G4ThreeVector bmax;
+  BoundingLimits(bmin, bmax);
+  G4BoundingEnvelope bbox(bmin, bmax);
+  return bbox.CalculateExtent(pAxis, pVoxelLimit, pTransform, pMin, pMax);
+}
+
+G4ThreeVector Surface::SpikeLatticeSolid::GetPointOnSurface() const {
+  const G4double basisHeight = -fZBottom;
+  const G4double areaBottom = 4. * fX * fY;
+  const G4double areaSideX = 2. * fY * basisHeight;  // one face
+  const G4double areaSideY = 2. * fX * basisHeight;
+  const G4double areaBasis = areaBottom + 2. * areaSideX + 2. * areaSideY;
+
+  G4double select = G4UniformRand() * (areaBasis + fSpikeArea);
+  if (select < areaBasis) {
+    const G4double rx = (2. * G4UniformRand() - 1.);
+    const G4double ry = (2. * G4UniformRand() - 1.);
+    const G4double rz = fZBottom * G4UniformRand();
+    if (select < areaBottom) {
+      return {rx * fX, ry * fY, fZBottom};
+    }
+    select -= areaBottom;
+    if (select < 2. * areaSideX) {
+      return {select < areaSideX ? -fX : fX, ry * fY, rz};
+    }
+    select -= 2. * areaSideX;
+    return {rx * fX, select < areaSideY ? -fY : fY, rz};
+  }
+
+  // cell weighted by its area (only differs for UniformPyramid)
+  G4int ix{0};
+  G4int iy{0};
+  G4double height{fHeight};
+  G4double cellArea{0};
+  do {
+    ix = std::min(static_cast<G4int>(G4UniformRand() * fNx), fNx - 1);
+    iy = std::min(static_cast<G4int>(G4UniformRand() * fNy), fNy - 1);
+    height = CellHeight(ix, iy);
+    cellArea = CellSpikeArea(height);
+  } while (G4UniformRand() * fMaxCellArea > cellArea);
+  const G4double cx = CellCenterX(ix);
+  const G4double cy = CellCenterY(iy);
+
+  select = G4UniformRand() * cellArea;
+  for (std::size_t k = 0; k < NumberOfLayers(); ++k) {
+    const G4double z0 = fLayerZ[k] * height;
+    const G4double z1 = fLayerZ[k + 1] * height;
+    const G4double dz = z1 - z0;
+    const G4double dWx = fLayerWx[k] - fLayerWx[k + 1];
+    const G4double dWy = fLayerWy[k] - fLayerWy[k + 1];
+    const G4double faceX =
+        (fLayerWy[k] + fLayerWy[k + 1]) * std::sqrt(dz * dz + dWx * dWx);
+    const G4double faceY =
+        (fLayerWx[k] + fLayerWx[k + 1]) * std::sqrt(dz * dz + dWy * dWy);
+    if (select >= 2. * (faceX + faceY)) {
+      select -= 2. * (faceX + faceY);
+      continue;
+    }
+    const G4bool alongY = select < 2. * faceX;  // face normal in x
+    const std::vector<G4double> &along = alongY ? fLayerWy : fLayerWx;
+    const std::vector<G4double> &across = alongY ? fLayerWx : fLayerWy;
+    const G4double sign =
+        (alongY ? select < faceX : select < 2. * faceX + faceY) ? 1. : -1.;
+    // width of the trapezoid is linear in z
+    const G4double maxWidth = std::max(along[k], along[k + 1]);
+    G4double fraction{0};
+    G4double width{0};
+    do {
+      fraction = G4UniformRand();
+      width = along[k] + fraction * (along[k + 1] - along[k]);
+    } while (G4UniformRand() * maxWidth > width);
+    const G4double position = (2. * G4UniformRand() - 1.) * width;
+    const G4double offset =
+        sign * (across[k] + fraction * (across[k + 1] - across[k]));
+    const G4double z = z0 + fraction * dz;
+    if (alongY) {
+      return {cx + offset, cy + position, z};
+    }
+    return {cx + position, cy + offset, z};
+  }
+  // top of the spike
+  return {cx + (2. * G4UniformRand() - 1.) * fLayerWx.back(),
+          cy + (2. * G4UniformRand() - 1.) * fLayerWy.back(), height};
+}
+
+G4GeometryType Surface::SpikeLatticeSolid::GetEntityType() const {
+  return {"SpikeLatticeSolid"};
+}
+
+G4VSolid *Surface::SpikeLatticeSolid::Clone() const {
+  return new SpikeLatticeSolid(*this);
+}
+
+std::ostream &Surface::SpikeLatticeSolid::StreamInfo(std::ostream &os) const {
+  const G4int oldPrecision = os.precision(16);
+  os << "-----------------------------------------------------------\n"
+     << "    *** Dump for solid - " << GetName() << " ***\n"
+     << "    ===================================================\n"
+     << " Solid type: SpikeLatticeSolid\n"
+     << " Parameters: \n"
+     << "   spikes in x      : " << fNx << "\n"
+     << "   spikes in y      : " << fNy << "\n"
+     << "   half width cell x: " << fDx / mm << " mm \n"
+     << "   half width cell y: " << fDy / mm << " mm \n"
+     << "   spike height     : " << fHeight / mm << " mm \n"
+     << "   max spike height : " << fMaxHeight / mm << " mm \n"
+     << "   layers per spike : " << NumberOfLayers() << "\n"
+     << "   basis bottom     : " << fZBottom / mm << " mm \n"
+     << "-----------------------------------------------------------\n";
+  os.precision(oldPrecision);
+  return os;
+}
+
+void Surface::SpikeLatticeSolid::DescribeYourselfTo(
+    G4VGraphicsScene &scene) const {
+  scene.AddSolid(*this);
+}
+
+G4Polyhedron *Surface::SpikeLatticeSolid::CreatePolyhedron() const {
+  const std::size_t layers = NumberOfLayers();
+  const std::size_t cells = static_cast<std::size_t>(fNx) * fNy;
+  const auto nVertices = static_cast<G4int>(8 + cells * 4 * (layers + 1));
+  const auto nFacets = static_cast<G4int>(6 + cells * (4 * layers + 1));
+  auto *polyhedron = new G4PolyhedronArbitrary(nVertices, nFacets);
+
+  polyhedron->AddVertex(G4ThreeVector(-fX, -fY, fZBottom));
+  polyhedron->AddVertex(G4ThreeVector(fX, -fY, fZBottom));
+  polyhedron->AddVertex(G4ThreeVector(fX, fY, fZBottom));
+  polyhedron->AddVertex(G4ThreeVector(-fX, fY, fZBottom));
+  polyhedron->AddVertex(G4ThreeVector(-fX, -fY, 0));
+  polyhedron->AddVertex(G4ThreeVector(fX, -fY, 0));
+  polyhedron->AddVertex(G4ThreeVector(fX, fY, 0));
+  polyhedron->AddVertex(G4ThreeVector(-fX, fY, 0));
+  polyhedron->AddFacet(1, 4, 3, 2);
+  polyhedron->AddFacet(5, 6, 7, 8);
+  polyhedron->AddFacet(1, 2, 6, 5);
+  polyhedron->AddFacet(2, 3, 7, 6);
+  polyhedron->AddFacet(3, 4, 8, 7);
+  polyhedron->AddFacet(4, 1, 5, 8);
+
+  G4int offset{9};
+  for (G4int ix = 0; ix < fNx; ++ix) {
+    for (G4int iy = 0; iy < fNy; ++iy) {
+      const G4double cx = CellCenterX(ix);
+      const G4double cy = CellCenterY(iy);
+      const G4double height = CellHeight(ix, iy);
+      // corners of each layer boundary: (+,-), (+,+), (-,+), (-,-)
+      for (std::size_t k = 0; k <= layers; ++k) {
+        const G4double z = fLayerZ[k] * height;
+        polyhedron->AddVertex(
+            G4ThreeVector(cx + fLayerWx[k], cy - fLayerWy[k], z));
+        polyhedron->AddVertex(
+            G4ThreeVector(cx + fLayerWx[k], cy + fLayerWy[k], z));
+        polyhedron->AddVertex(
+            G4ThreeVector(cx - fLayerWx[k], cy + fLayerWy[k], z));
+        polyhedron->AddVertex(
+            G4ThreeVector(cx - fLayerWx[k], cy - fLayerWy[k], z));
+      }
+      for (std::size_t k = 0; k < layers; ++k) {
+        const G4int b = offset + static_cast<G4int>(4 * k);
+        const G4int t = b + 4;
+        polyhedron->AddFacet(b, b + 1, t + 1, t);          // +x
+        polyhedron->AddFacet(b + 1, b + 2, t + 2, t + 1);  // +y
+        polyhedron->AddFacet(b + 2, b + 3, t + 3, t + 2);  // -x
+        polyhedron->AddFacet(b + 3, b, t, t + 3);          // -y
+      }
+      const G4int top = offset + static_cast<G4int>(4 * layers);
+      polyhedron->AddFacet(top, top + 1, top + 2, top + 3);
+      offset += static_cast<G4int>(4 * (layers + 1));
+    }
+  }
+  polyhedron->SetReferences();
+  return polyhedron;
+}
+
+void Surface::SpikeLatticeSolid::FillFacetStore(FacetStore *store) const {
+  auto addQuad = [store](const G4ThreeVector &a, const G4ThreeVector &b,
+                         const G4ThreeVector &c, const G4ThreeVector &d) {
+    store->AppendFacet(a, b, c);
+    store->AppendFacet(a, c, d);
+  };
+  const std::size_t layers = NumberOfLayers();
+  for (G4int ix = 0; ix < fNx; ++ix) {
+    for (G4int iy = 0; iy < fNy; ++iy) {
+      const G4double cx = CellCenterX(ix);
+      const G4double cy = CellCenterY(iy);
+      const G4double height = CellHeight(ix, iy);
+      auto corner = [&](const std::size_t k, const G4double sx,
+                        const G4double sy) {
+        return G4ThreeVector(cx + sx * fLayerWx[k], cy + sy * fLayerWy[k],
+                             fLayerZ[k] * height);
+      };
+      // vertices ordered counterclockwise seen from outside
+      for (std::size_t k = 0; k < layers; ++k) {
+        addQuad(corner(k, 1, -1), corner(k, 1, 1), corner(k + 1, 1, 1),
+                corner(k + 1, 1, -1));
+        addQuad(corner(k, 1, 1), corner(k, -1, 1), corner(k + 1, -1, 1),
+                corner(k + 1, 1, 1));
+        addQuad(corner(k, -1, 1), corner(k, -1, -1), corner(k + 1, -1, -1),
+                corner(k + 1, -1, 1));
+        addQuad(corner(k, -1, -1), corner(k, 1, -1), corner(k + 1, 1, -1),
+                corner(k + 1, -1, -1));
+      }
+      addQuad(corner(layers, 1, -1), corner(layers, 1, 1),
+              corner(layers, -1, 1), corner(layers, -1, -1));
+    }
+  }
+}
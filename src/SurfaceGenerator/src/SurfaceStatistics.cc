@@ -0,0 +1,176 @@
+/**
+ * @brief Implementation of SurfaceStatistics
+ * @author agent
+ * @date 2026-10-17
+ * @file SurfaceStatistics.cc
+ */
+
+#include "SurfaceGenerator/include/SurfaceStatistics.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "Service/include/ParallelFor.hh"
+#include "SurfaceGenerator/include/FacetStore.hh"
+
+namespace {
+constexpr G4int kBlockSize{4096};  ///< facets per partial sum
+
+struct Facet {
+  G4double projected;  ///< projected area on xy
+  G4double z[3];
+};
+
+Facet Project(const Surface::FacetStore &store, const std::size_t i) {
+  return {store.GetFacetArea(i) * std::abs(store.GetSurfaceNormal(i).z()),
+          {store.GetVertex(i, 0).z(), store.GetVertex(i, 1).z(),
+           store.GetVertex(i, 2).z()}};
+}
+
+// Sums of the first pass
+struct HeightSums {
+  G4double projected{0};
+  G4double volume{0};  ///< integral of z
+  G4double area{0};
+  G4double min{std::numeric_limits<G4double>::max()};
+  G4double max{std::numeric_limits<G4double>::lowest()};
+
+  void Add(const Surface::FacetStore &store, const std::size_t i) {
+    const Facet f = Project(store, i);
+    projected += f.projected;
+    volume += f.projected * (f.z[0] + f.z[1] + f.z[2]) / 3.;
+    area += store.GetFacetArea(i);
+    min = std::min({min, f.z[0], f.z[1], f.z[2]});
+    max = std::max({max, f.z[0], f.z[1], f.z[2]});
+  }
+  HeightSums &operator+=(const HeightSums &other) {
+    projected += other.projected;
+    volume += other.volume;
+    area += other.area;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    return *this;
+  }
+};
+
+// Sums of the second pass, heights relative to the mean
+struct MomentSums {
+  G4double absolute{0};  ///< integral of |z|
+  G4double moment[3]{0, 0, 0};  ///< integrals of z^2, z^3, z^4
+
+  void Add(const Surface::FacetStore &store, const std::size_t i,
+           const G4double mean) {
+    const Facet f = Project(store, i);
+    const G4double a = f.z[0] - mean;
+    const G4double b = f.z[1] - mean;
+    const G4double c = f.z[2] - mean;
+    // complete homogeneous polynomials h_k(a, b, c)
+    const G4double g1 = a + b;
+    const G4double g2 = a * a + b * g1;
+    const G4double g3 = a * a * a + b * g2;
+    const G4double g4 = a * a * a * a + b * g3;
+    const G4double h1 = g1 + c;
+    const G4double h2 = g2 + c * h1;
+    const G4double h3 = g3 + c * h2;
+    const G4double h4 = g4 + c * h3;
+    const G4double integral1 = f.projected * h1 / 3.;
+    moment[0] += f.projected * h2 / 6.;
+    moment[1] += f.projected * h3 / 10.;
+    moment[2] += f.projected * h4 / 15.;
+
+    const G4double heights[3] = {a, b, c};
+    G4int positive{0};
+    G4int negative{0};
+    for (const G4double height : heights) {
+      positive += height > 0 ? 1 : 0;
+      negative += height < 0 ? 1 : 0;
+    }
+    if (positive == 0 || negative == 0) {
+      absolute += std::abs(integral1);
+      return;
+    }
+    // single vertex on its side of the mean plane, the triangle cut off at it
+    // has the area share d^2 / ((d - e1) (d - e2))
+    G4int single{0};
+    for (G4int i = 0; i < 3; ++i) {
+      if ((positive == 1 && heights[i] > 0) ||
+          (positive != 1 && heights[i] < 0)) {
+        single = i;
+      }
+    }
+    const G4double d = heights[single];
+    const G4double e1 = heights[(single + 1) % 3];
+    const G4double e2 = heights[(single + 2) % 3];
+    const G4double cut = f.projected * d * d * d / ((d - e1) * (d - e2)) / 3.;
+    absolute += std::abs(cut) + std::abs(integral1 - cut);
+  }
+  MomentSums &operator+=(const MomentSums &other) {
+    absolute += other.absolute;
+    for (G4int k = 0; k < 3; ++k) {
+      moment[k] += other.moment[k];
+    }
+    return *this;
+  }
+};
+
+// Sums fixed blocks of facets in parallel and adds the blocks pairwise
+template <class Sums, class F>
+Sums SumBlocks(const Surface::FacetStore &store, const G4int threads,
+               F &&add) {
+  const G4int count = store.Size();
+  const G4int blocks = (count + kBlockSize - 1) / kBlockSize;
+  std::vector<Sums> partial(std::max(blocks, 1));
+  Surface::ParallelFor(blocks, threads, 1,
+                       [&](G4int, G4int begin, G4int end) {
+                         for (G4int block = begin; block < end; ++block) {
+                           const G4int last =
+                               std::min(count, (block + 1) * kBlockSize);
+                           for (G4int i = block * kBlockSize; i < last; ++i) {
+                             add(partial[block], i);
+                           }
+                         }
+                       });
+  for (std::size_t stride = 1; stride < partial.size(); stride *= 2) {
+    for (std::size_t i = 0; i + stride < partial.size(); i += 2 * stride) {
+      partial[i] += partial[i + stride];
+    }
+  }
+  return partial.front();
+}
+}  // namespace
+
+Surface::SurfaceStatistics Surface::SurfaceStatistics::Compute(
+    const FacetStore &store, G4int threads) {
+  if (threads <= 0) {
+    threads =
+        static_cast<G4int>(std::max(1u, std::thread::hardware_concurrency()));
+  }
+  SurfaceStatistics statistics;
+  const HeightSums heights = SumBlocks<HeightSums>(
+      store, threads,
+      [&store](HeightSums &sums, G4int i) { sums.Add(store, i); });
+  statistics.Area = heights.area;
+  statistics.ProjectedSurface = heights.projected;
+  if (heights.projected <= 0) {
+    return statistics;
+  }
+  const G4double mean = heights.volume / heights.projected;
+  statistics.MeanHeight = mean;
+  statistics.Sv = mean - std::min(mean, heights.min);
+  statistics.Sp = std::max(mean, heights.max) - mean;
+  statistics.Sz = statistics.Sp + statistics.Sv;
+
+  const MomentSums moments = SumBlocks<MomentSums>(
+      store, threads,
+      [&store, mean](MomentSums &sums, G4int i) { sums.Add(store, i, mean); });
+  const G4double projected = heights.projected;
+  statistics.Sa = moments.absolute / projected;
+  statistics.Sq = std::sqrt(moments.moment[0] / projected);
+  const G4double sq2 = statistics.Sq * statistics.Sq;
+  statistics.Ssk = moments.moment[1] / projected / (sq2 * statistics.Sq);
+  statistics.Sku = moments.moment[2] / projected / (sq2 * sq2);
+  return statistics;
+}
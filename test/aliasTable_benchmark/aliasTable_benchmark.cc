@@ -0,0 +1,110 @@
+// Author agent
+// Date 26-10-17
+// File: Benchmark of bin selection used for primary generation
+// Compares the former scan over the cumulative distribution with the alias
+// table for 10^2 to 10^6 bins and reports chi2/ndf of the alias table draws.
+
+#include <chrono>
+#include <iomanip>
+#include <vector>
+
+#include "G4ios.hh"
+#include "Randomize.hh"
+#include "Service/include/AliasTable.hh"
+
+namespace {
+
+// selection as done before the alias table existed
+size_t ScanSelect(const std::vector<G4double> &cumulative, G4double random) {
+  for (size_t i = 0; i < cumulative.size(); ++i) {
+    if (random <= cumulative[i]) {
+      return i;
+    }
+  }
+  return cumulative.size();
+}
+
+template <class F>
+G4double TimePerDraw(const std::vector<G4double> &randoms, const F &select,
+                     size_t &checksum) {
+  const auto start = std::chrono::steady_clock::now();
+  for (const G4double random : randoms) {
+    checksum += select(random);
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<G4double, std::nano>(stop - start).count() /
+         static_cast<G4double>(randoms.size());
+}
+
+}  // namespace
+
+int main() {
+  constexpr size_t nAliasDraws = 10000000;
+  constexpr G4double scanWork = 1e9;  // bins times draws for the scan
+
+  G4cout << std::setw(10) << "Bins" << std::setw(20) << "scan [ns/draw]"
+         << std::setw(20) << "alias [ns/draw]" << std::setw(15) << "chi2/ndf"
+         << G4endl;
+
+  for (const size_t nBins : {100ul, 1000ul, 10000ul, 100000ul, 1000000ul}) {
+    // facet like weights, every tenth bin empty
+    std::vector<G4double> weights(nBins);
+    for (size_t i = 0; i < nBins; ++i) {
+      weights[i] = (i % 10 == 9) ? 0. : 0.5 + G4UniformRand();
+    }
+    G4double total{0};
+    for (const G4double w : weights) {
+      total += w;
+    }
+    std::vector<G4double> cumulative;
+    cumulative.reserve(nBins);
+    G4double sum{0};
+    for (const G4double w : weights) {
+      sum += w;
+      cumulative.push_back(sum / total);
+    }
+    const Surface::AliasTable table(weights);
+
+    const auto nScanDraws =
+        static_cast<size_t>(scanWork / static_cast<G4double>(nBins));
+    std::vector<G4double> randoms(nAliasDraws);
+    for (G4double &r : randoms) {
+      r = G4UniformRand();
+    }
+    const std::vector<G4double> scanRandoms(randoms.begin(),
+                                            randoms.begin() + nScanDraws);
+
+    size_t scanSum{0};
+    size_t aliasSum{0};
+    const G4double scan = TimePerDraw(
+        scanRandoms,
+        [&cumulative](G4double r) { return ScanSelect(cumulative, r); },
+        scanSum);
+    const G4double alias = TimePerDraw(
+        randoms, [&table](G4double r) { return table.Sample(r); }, aliasSum);
+
+    std::vector<size_t> counts(nBins, 0);
+    for (const G4double r : randoms) {
+      ++counts[table.Sample(r)];
+    }
+    G4double chi2{0};
+    size_t ndf{0};
+    G4bool emptyHit{false};
+    for (size_t i = 0; i < nBins; ++i) {
+      const G4double expected = table.GetProbability(i) * nAliasDraws;
+      if (expected <= 0) {
+        emptyHit |= counts[i] > 0;
+        continue;
+      }
+      const G4double diff = static_cast<G4double>(counts[i]) - expected;
+      chi2 += diff * diff / expected;
+      ++ndf;
+    }
+
+    G4cout << std::setw(10) << nBins << std::setw(20) << scan << std::setw(20)
+           << alias << std::setw(15) << chi2 / static_cast<G4double>(ndf - 1)
+           << (emptyHit ? "   empty bin sampled!" : "")
+           << (scanSum + aliasSum == 0 ? "   no draws!" : "") << G4endl;
+  }
+  return 0;
+}
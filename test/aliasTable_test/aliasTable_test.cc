@@ -0,0 +1,81 @@
+// Author agent
+// Date 26-10-17
+// File: Test of the sampling frequencies of AliasTable
+// A uniform grid of random numbers has to reproduce the weights exactly, and
+// random draws have to agree with the weights within their statistical error.
+// Bins with zero weight are never returned.
+
+#include <cmath>
+#include <vector>
+
+#include "G4ios.hh"
+#include "Randomize.hh"
+#include "Service/include/AliasTable.hh"
+#include "UnitTest.hh"
+
+using Surface::Test::Check;
+
+namespace {
+
+void TestWeights(const std::vector<G4double> &weights, const G4String &name) {
+  const Surface::AliasTable table(weights);
+  G4double sum{0.};
+  for (const G4double weight : weights) {
+    sum += weight;
+  }
+  Check(table.Size() == weights.size(), name + ": size");
+  for (std::size_t i = 0; i < weights.size(); ++i) {
+    Check(std::fabs(table.GetProbability(i) - weights[i] / sum) < 1e-12,
+          name + ": probability of bin " + std::to_string(i));
+  }
+
+  // every bin covers an interval of [0,1) of its probability
+  const std::size_t grid = 1000 * weights.size();
+  std::vector<std::size_t> gridCounts(weights.size(), 0);
+  for (std::size_t k = 0; k < grid; ++k) {
+    ++gridCounts.at(table.Sample((static_cast<G4double>(k) + 0.5) /
+                                 static_cast<G4double>(grid)));
+  }
+  for (std::size_t i = 0; i < weights.size(); ++i) {
+    const G4double expected = static_cast<G4double>(grid) * weights[i] / sum;
+    // each bin of the table may cut a grid point
+    Check(std::fabs(static_cast<G4double>(gridCounts[i]) - expected) <=
+              2. * static_cast<G4double>(weights.size()),
+          name + ": grid frequency of bin " + std::to_string(i));
+  }
+
+  // random draws within 5 sigma of the expectation
+  const G4int draws = 1000000;
+  std::vector<G4int> counts(weights.size(), 0);
+  for (G4int n = 0; n < draws; ++n) {
+    ++counts.at(table.Sample());
+  }
+  for (std::size_t i = 0; i < weights.size(); ++i) {
+    const G4double p = weights[i] / sum;
+    const G4double expected = draws * p;
+    if (p == 0.) {
+      Check(counts[i] == 0, name + ": zero weight bin " + std::to_string(i) +
+                                " returned");
+      continue;
+    }
+    const G4double sigma = std::sqrt(expected * (1. - p));
+    Check(std::fabs(counts[i] - expected) < 5. * sigma + 1.,
+          name + ": frequency of bin " + std::to_string(i));
+  }
+}
+
+}  // namespace
+
+int main() {
+  TestWeights({1.}, "single bin");
+  TestWeights({1., 2., 3., 4.}, "linear");
+  TestWeights({0., 5., 0., 0., 1., 0.}, "zero weights");
+  TestWeights({1e-6, 1., 1e6}, "wide range");
+  std::vector<G4double> many(1000);
+  for (std::size_t i = 0; i < many.size(); ++i) {
+    many[i] = static_cast<G4double>((i * 7919) % 101);
+  }
+  TestWeights(many, "1000 bins");
+
+  return Surface::Test::Result("AliasTable");
+}
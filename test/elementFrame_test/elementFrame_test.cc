@@ -0,0 +1,88 @@
+// Author agent
+// Date 26-10-17
+// File: Test of the envelope frame of LogicalSurface
+//
+// Pins the z frame of the elements inside the envelope. Before bounding
+// limits were used the half height of the envelope was the x extent of the
+// element and z=0 of the element was on the bottom of the envelope. Now the
+// half height is half the z range and the bottom of the element is on the
+// bottom of the envelope, for every z frame of the solid.
+
+#include <cmath>
+
+#include "G4ThreeVector.hh"
+#include "Surface/LogicalSurface.hh"
+#include "UnitTest.hh"
+
+using Surface::Test::Check;
+
+namespace {
+
+G4bool Near(const G4double a, const G4double b) {
+  return std::abs(a - b) < 1e-12;
+}
+
+G4bool Near(const G4ThreeVector &a, const G4ThreeVector &b) {
+  return Near(a.x(), b.x()) && Near(a.y(), b.y()) && Near(a.z(), b.z());
+}
+
+/// the element lies in its cell: min on -half_size, max on +half_size
+void CheckInsideCell(const G4ThreeVector &min, const G4ThreeVector &max,
+                     const G4String &what) {
+  const auto frame = Surface::LogicalSurface::element_frame(min, max);
+  Check(Near(min + frame.offset, -frame.half_size), what + ": lower corner");
+  Check(Near(max + frame.offset, frame.half_size), what + ": upper corner");
+}
+
+}  // namespace
+
+int main() {
+  using Surface::LogicalSurface;
+  const G4double x = 2.;
+  const G4double y = 3.;
+  const G4double height = 1.;
+  const G4double body = 0.5;
+
+  // bottom at z=0 (height field, meshes of the GDML files): z=0 stays on the
+  // bottom of the envelope, as in the old frame; only the half height
+  // changes from the x extent to height / 2
+  {
+    const G4ThreeVector min(-x, -y, 0);
+    const G4ThreeVector max(x, y, height);
+    const auto frame = LogicalSurface::element_frame(min, max);
+    Check(Near(frame.half_size, G4ThreeVector(x, y, height / 2)),
+          "bottom at z=0: half size");
+    Check(Near(frame.offset.z(), -frame.half_size.z()),
+          "bottom at z=0: z=0 on the bottom of the envelope");
+    CheckInsideCell(min, max, "bottom at z=0");
+  }
+
+  // body below z=0 (mesh of the python tool): the old frame put z=0 on the
+  // bottom of the envelope and the body below it, now the body bottom is on
+  // the bottom of the envelope and z=0 moves up by the body height
+  {
+    const G4ThreeVector min(-x, -y, -body);
+    const G4ThreeVector max(x, y, height);
+    const auto frame = LogicalSurface::element_frame(min, max);
+    Check(Near(frame.half_size.z(), (height + body) / 2),
+          "body below z=0: half height");
+    Check(Near(frame.offset.z(), -frame.half_size.z() + body),
+          "body below z=0: z=0 a body height above the envelope bottom");
+    CheckInsideCell(min, max, "body below z=0");
+  }
+
+  // solid not centred on x=y=0: half size from the range, element shifted
+  // to the centre of its cell
+  {
+    const G4ThreeVector min(0, 1., 0);
+    const G4ThreeVector max(2 * x, 1. + 2 * y, height);
+    const auto frame = LogicalSurface::element_frame(min, max);
+    Check(Near(frame.half_size, G4ThreeVector(x, y, height / 2)),
+          "off centre: half size");
+    Check(Near(frame.offset, G4ThreeVector(-x, -1. - y, -height / 2)),
+          "off centre: offset");
+    CheckInsideCell(min, max, "off centre");
+  }
+
+  return Surface::Test::Result("ElementFrame");
+}
@@ -0,0 +1,224 @@
+// Author agent
+// Date 26-10-17
+// File: Test of HeightFieldSolid against the tessellated surface mesh
+// Builds the same height map as G4TessellatedSolid (mesh of the GDML export)
+// and as HeightFieldSolid, compares Inside(), DistanceToIn() and
+// DistanceToOut() for random points and directions in the bounding box, and
+// reads a height field back from a .hmap file.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "G4QuadrangularFacet.hh"
+#include "G4RandomDirection.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TessellatedSolid.hh"
+#include "G4TriangularFacet.hh"
+#include "G4ios.hh"
+#include "Randomize.hh"
+#include "Surface/HeightFieldSolid.hh"
+#include "UnitTest.hh"
+
+using Surface::Test::Check;
+
+namespace {
+
+std::vector<float> RandomHeights(const G4int n, const G4double bodyHeight) {
+  std::vector<float> heights(static_cast<size_t>(n) * n);
+  for (G4int iy = 0; iy < n; ++iy) {
+    for (G4int ix = 0; ix < n; ++ix) {
+      const G4double wave = std::sin(0.3 * ix) * std::cos(0.2 * iy);
+      heights[iy * n + ix] = static_cast<float>(
+          bodyHeight + (1. + wave + G4UniformRand()) * um);
+    }
+  }
+  return heights;
+}
+
+// same facets as Surface.generate_surface_mesh_from_height_map
+G4TessellatedSolid *BuildMesh(const G4String &name, const G4int n,
+                              const G4double length,
+                              const std::vector<float> &heights) {
+  auto *solid = new G4TessellatedSolid(name);
+  const G4double step = length / (n - 1);
+  auto top = [&](G4int ix, G4int iy) {
+    return G4ThreeVector(-0.5 * length + ix * step, -0.5 * length + iy * step,
+                         heights[iy * n + ix]);
+  };
+  auto bottom = [&](G4int ix, G4int iy) {
+    return G4ThreeVector(-0.5 * length + ix * step, -0.5 * length + iy * step,
+                         0);
+  };
+  for (G4int iy = 0; iy < n - 1; ++iy) {
+    for (G4int ix = 0; ix < n - 1; ++ix) {
+      solid->AddFacet(new G4TriangularFacet(top(ix, iy), top(ix + 1, iy),
+                                            top(ix + 1, iy + 1), ABSOLUTE));
+      solid->AddFacet(new G4TriangularFacet(top(ix, iy), top(ix + 1, iy + 1),
+                                            top(ix, iy + 1), ABSOLUTE));
+    }
+  }
+  const G4int last = n - 1;
+  for (G4int i = 0; i < last; ++i) {
+    solid->AddFacet(new G4QuadrangularFacet(bottom(i, 0), bottom(i + 1, 0),
+                                            top(i + 1, 0), top(i, 0),
+                                            ABSOLUTE));
+    solid->AddFacet(new G4QuadrangularFacet(
+        bottom(i + 1, last), bottom(i, last), top(i, last), top(i + 1, last),
+        ABSOLUTE));
+    solid->AddFacet(new G4QuadrangularFacet(bottom(0, i + 1), bottom(0, i),
+                                            top(0, i), top(0, i + 1),
+                                            ABSOLUTE));
+    solid->AddFacet(new G4QuadrangularFacet(
+        bottom(last, i), bottom(last, i + 1), top(last, i + 1), top(last, i),
+        ABSOLUTE));
+  }
+  solid->AddFacet(new G4QuadrangularFacet(bottom(0, 0), bottom(0, last),
+                                          bottom(last, last), bottom(last, 0),
+                                          ABSOLUTE));
+  solid->SetSolidClosed(true);
+  return solid;
+}
+
+void Compare(const G4String &tag, const G4VSolid *mesh,
+             const G4VSolid *field) {
+  constexpr std::size_t nPoints = 20000;
+  const G4double tolerance = 10. * kCarTolerance;
+  G4ThreeVector pMin;
+  G4ThreeVector pMax;
+  field->BoundingLimits(pMin, pMax);
+
+  std::size_t insideMismatch{0};
+  std::size_t toInMismatch{0};
+  std::size_t toOutMismatch{0};
+  std::size_t rays{0};
+  for (std::size_t i = 0; i < nPoints; ++i) {
+    const G4ThreeVector point{
+        pMin.x() + G4UniformRand() * (pMax.x() - pMin.x()),
+        pMin.y() + G4UniformRand() * (pMax.y() - pMin.y()),
+        pMin.z() + G4UniformRand() * (pMax.z() - pMin.z())};
+    const EInside insideMesh = mesh->Inside(point);
+    const EInside insideField = field->Inside(point);
+    // points within the tolerance of a surface may be classified either way
+    if (insideMesh == kSurface || insideField == kSurface) {
+      continue;
+    }
+    if (insideMesh != insideField) {
+      ++insideMismatch;
+      continue;
+    }
+    ++rays;
+    const G4ThreeVector direction = G4RandomDirection();
+    if (insideMesh == kOutside) {
+      const G4double distMesh = mesh->DistanceToIn(point, direction);
+      const G4double distField = field->DistanceToIn(point, direction);
+      const G4bool bothMiss = distMesh == kInfinity && distField == kInfinity;
+      if (!bothMiss && std::abs(distMesh - distField) > tolerance) {
+        ++toInMismatch;
+      }
+    } else {
+      const G4double distMesh = mesh->DistanceToOut(point, direction);
+      const G4double distField = field->DistanceToOut(point, direction);
+      if (std::abs(distMesh - distField) > tolerance) {
+        ++toOutMismatch;
+      }
+    }
+  }
+  Check(insideMismatch == 0,
+        tag + ": Inside differs for " + std::to_string(insideMismatch) +
+            " points");
+  // rays grazing an edge may be resolved differently by the two solids
+  Check(toInMismatch * 1000 <= rays,
+        tag + ": DistanceToIn differs for " + std::to_string(toInMismatch) +
+            " of " + std::to_string(rays) + " rays");
+  Check(toOutMismatch * 1000 <= rays,
+        tag + ": DistanceToOut differs for " + std::to_string(toOutMismatch) +
+            " of " + std::to_string(rays) + " rays");
+}
+
+// height field file as written by HeightFieldWriter.py
+void WriteHeightField(const G4String &filename, const std::uint32_t nx,
+                      const std::uint32_t ny, const G4double lengthUm,
+                      const G4double bodyHeightUm,
+                      const std::vector<float> &heightsUm) {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  const char magic[8] = "SC4HMAP";
+  const std::uint32_t version{1};
+  const G4double header[3]{lengthUm, lengthUm, bodyHeightUm};
+  file.write(magic, sizeof(magic));
+  file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+  file.write(reinterpret_cast<const char *>(&nx), sizeof(nx));
+  file.write(reinterpret_cast<const char *>(&ny), sizeof(ny));
+  file.write(reinterpret_cast<const char *>(header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(heightsUm.data()),
+             static_cast<std::streamsize>(heightsUm.size() * sizeof(float)));
+}
+
+void TestFile() {
+  const G4String filename{"heightField_test.hmap"};
+  const G4int n{7};
+  const G4double lengthUm{20.};
+  const G4double bodyHeightUm{4.};
+  // multiples of 1/4 um, exact in float in both frames
+  std::vector<float> fileHeights(static_cast<size_t>(n) * n);
+  std::vector<float> heights(fileHeights.size());
+  for (std::size_t i = 0; i < fileHeights.size(); ++i) {
+    fileHeights[i] = 0.25f * static_cast<float>(i % 5);
+    heights[i] = static_cast<float>((fileHeights[i] + bodyHeightUm) * um);
+  }
+  WriteHeightField(filename, n, n, lengthUm, bodyHeightUm, fileHeights);
+  auto *loaded = Surface::HeightFieldSolid::FromFile("Loaded", filename);
+  const Surface::HeightFieldSolid direct("Direct", n, n, lengthUm * um,
+                                         lengthUm * um, heights);
+  std::remove(filename.c_str());
+
+  Check(loaded->GetNx() == n && loaded->GetNy() == n, "file: grid size");
+  Check(std::abs(loaded->GetHalfLengthX() - 0.5 * lengthUm * um) <
+            kCarTolerance,
+        "file: length");
+  G4ThreeVector pMin;
+  G4ThreeVector pMax;
+  loaded->BoundingLimits(pMin, pMax);
+  Check(std::abs(pMin.z()) < kCarTolerance, "file: bottom at z=0");
+  Check(std::abs(pMax.z() - (bodyHeightUm + 1.) * um) < kCarTolerance,
+        "file: top of the surface");
+  Check(std::abs(loaded->GetTopSurfaceArea() - direct.GetTopSurfaceArea()) <
+            1e-9 * direct.GetTopSurfaceArea(),
+        "file: top surface area");
+  Compare("file", &direct, loaded);
+  delete loaded;
+}
+
+}  // namespace
+
+int main() {
+  const G4double length = 100. * um;
+  const G4double bodyHeight = 10. * um;
+
+  for (const G4int n : {2, 17, 50}) {
+    const G4String tag = std::to_string(n);
+    const std::vector<float> heights = RandomHeights(n, bodyHeight);
+    auto *tessellated = BuildMesh("Mesh" + tag, n, length, heights);
+    tessellated->Voxelize();
+    auto *heightField = new Surface::HeightFieldSolid("Field" + tag, n, n,
+                                                      length, length, heights);
+    G4ThreeVector meshMin;
+    G4ThreeVector meshMax;
+    G4ThreeVector fieldMin;
+    G4ThreeVector fieldMax;
+    tessellated->BoundingLimits(meshMin, meshMax);
+    heightField->BoundingLimits(fieldMin, fieldMax);
+    Check((meshMin - fieldMin).mag() < 10. * kCarTolerance &&
+              (meshMax - fieldMax).mag() < 10. * kCarTolerance,
+          tag + ": bounding limits differ");
+    Compare(tag, tessellated, heightField);
+    delete tessellated;
+    delete heightField;
+  }
+  TestFile();
+
+  return Surface::Test::Result("HeightFieldSolid");
+}
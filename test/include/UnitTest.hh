@@ -0,0 +1,50 @@
+/**
+ * @brief Checks shared by the unit tests
+ * @author agent
+ * @date 2026-10-17
+ * @file UnitTest.hh
+ */
+
+#ifndef TEST_INCLUDE_UNITTEST_HH
+#define TEST_INCLUDE_UNITTEST_HH
+
+#include <cstdlib>
+
+#include "G4String.hh"
+#include "G4Types.hh"
+#include "G4ios.hh"
+
+namespace Surface {
+namespace Test {
+
+/// Number of failed checks of the test
+inline G4int &Failures() {
+  static G4int failures{0};
+  return failures;
+}
+
+/// Reports what as failed if condition is false, the test continues
+inline void Check(const G4bool condition, const G4String &what) {
+  if (!condition) {
+    G4cerr << "FAILED: " << what << G4endl;
+    ++Failures();
+  }
+}
+
+/**
+ * @brief Prints the result of the test
+ * @return exit code of the test, EXIT_FAILURE if a check failed
+ */
+inline int Result(const G4String &name) {
+  if (Failures() > 0) {
+    G4cerr << Failures() << " checks failed" << G4endl;
+    return EXIT_FAILURE;
+  }
+  G4cout << name << " test passed" << G4endl;
+  return EXIT_SUCCESS;
+}
+
+}  // namespace Test
+}  // namespace Surface
+
+#endif  // TEST_INCLUDE_UNITTEST_HH
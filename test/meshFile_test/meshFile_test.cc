@@ -0,0 +1,161 @@
+// Author agent
+// Date 26-10-17
+// File: Test of the binary mesh file reader
+// Writes a closed height map surface (layout of the python tool) as .smesh
+// file with float64 and float32 vertices, reads it back with MeshFile and
+// compares vertices, faces and the tessellated solid built from it.
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "G4SystemOfUnits.hh"
+#include "G4TessellatedSolid.hh"
+#include "G4ios.hh"
+#include "Surface/MeshFile.hh"
+#include "UnitTest.hh"
+
+using Surface::Test::Check;
+
+namespace {
+
+struct Mesh {
+  std::vector<std::array<G4double, 3>> vertices;  // um
+  std::vector<std::array<std::uint32_t, 3>> faces;
+};
+
+// grid of n x n points, two triangles per cell, walls and bottom at z=0
+Mesh BuildMesh(const G4int n, const G4double length) {
+  Mesh mesh;
+  const G4double step = length / (n - 1);
+  for (G4int iy = 0; iy < n; ++iy) {
+    for (G4int ix = 0; ix < n; ++ix) {
+      const G4double height = 10. + std::sin(0.3 * ix) * std::cos(0.2 * iy);
+      mesh.vertices.push_back(
+          {-0.5 * length + ix * step, -0.5 * length + iy * step, height});
+    }
+  }
+  auto top = [n](G4int ix, G4int iy) {
+    return static_cast<std::uint32_t>(iy * n + ix);
+  };
+  for (G4int iy = 0; iy < n - 1; ++iy) {
+    for (G4int ix = 0; ix < n - 1; ++ix) {
+      mesh.faces.push_back({top(ix, iy), top(ix + 1, iy), top(ix + 1, iy + 1)});
+      mesh.faces.push_back({top(ix, iy), top(ix + 1, iy + 1), top(ix, iy + 1)});
+    }
+  }
+  // counter clockwise ring of boundary points, copied to z=0
+  std::vector<std::uint32_t> ring;
+  for (G4int i = 0; i < n - 1; ++i) ring.push_back(top(i, 0));
+  for (G4int i = 0; i < n - 1; ++i) ring.push_back(top(n - 1, i));
+  for (G4int i = n - 1; i > 0; --i) ring.push_back(top(i, n - 1));
+  for (G4int i = n - 1; i > 0; --i) ring.push_back(top(0, i));
+  const auto first_bottom = static_cast<std::uint32_t>(mesh.vertices.size());
+  for (const auto idx : ring) {
+    mesh.vertices.push_back({mesh.vertices[idx][0], mesh.vertices[idx][1], 0});
+  }
+  const auto ring_size = static_cast<std::uint32_t>(ring.size());
+  for (std::uint32_t i = 0; i < ring_size; ++i) {
+    const std::uint32_t next = (i + 1) % ring_size;
+    mesh.faces.push_back({first_bottom + i, first_bottom + next, ring[next]});
+    mesh.faces.push_back({first_bottom + i, ring[next], ring[i]});
+  }
+  // bottom as fan around the first corner
+  const std::uint32_t corner[4] = {0, static_cast<std::uint32_t>(n - 1),
+                                   static_cast<std::uint32_t>(2 * (n - 1)),
+                                   static_cast<std::uint32_t>(3 * (n - 1))};
+  mesh.faces.push_back({first_bottom + corner[0], first_bottom + corner[2],
+                        first_bottom + corner[1]});
+  mesh.faces.push_back({first_bottom + corner[0], first_bottom + corner[3],
+                        first_bottom + corner[2]});
+  return mesh;
+}
+
+// same layout as MeshWriter.py
+template <class T>
+void WriteMesh(const Mesh &mesh, const G4String &filename) {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  const char magic[8] = "SC4MESH";
+  const std::uint32_t version{1};
+  const std::uint32_t vertex_bytes{sizeof(T)};
+  const std::uint64_t n_vertices{mesh.vertices.size()};
+  const std::uint64_t n_faces{mesh.faces.size()};
+  const G4double unit{1e-3};
+  file.write(magic, sizeof(magic));
+  file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+  file.write(reinterpret_cast<const char *>(&vertex_bytes),
+             sizeof(vertex_bytes));
+  file.write(reinterpret_cast<const char *>(&n_vertices), sizeof(n_vertices));
+  file.write(reinterpret_cast<const char *>(&n_faces), sizeof(n_faces));
+  file.write(reinterpret_cast<const char *>(&unit), sizeof(unit));
+  for (const auto &vertex : mesh.vertices) {
+    for (const G4double coordinate : vertex) {
+      const auto value = static_cast<T>(coordinate);
+      file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+  }
+  file.write(reinterpret_cast<const char *>(mesh.faces.data()),
+             static_cast<std::streamsize>(n_faces * 3 *
+                                          sizeof(std::uint32_t)));
+}
+
+template <class T>
+void TestRoundTrip(const G4String &tag, const Mesh &mesh) {
+  const G4String filename = "meshFile_test_" + tag + ".smesh";
+  WriteMesh<T>(mesh, filename);
+  {
+    const Surface::MeshFile file(filename);
+    Check(file.GetNumberOfVertices() == mesh.vertices.size(),
+          tag + ": number of vertices");
+    Check(file.GetNumberOfFaces() == mesh.faces.size(),
+          tag + ": number of faces");
+
+    std::size_t vertexMismatch{0};
+    for (std::uint64_t i = 0; i < file.GetNumberOfVertices(); ++i) {
+      const G4ThreeVector expected(
+          static_cast<T>(mesh.vertices[i][0]) * um,
+          static_cast<T>(mesh.vertices[i][1]) * um,
+          static_cast<T>(mesh.vertices[i][2]) * um);
+      if ((file.GetVertex(i) - expected).mag() > 1e-12 * mm) {
+        ++vertexMismatch;
+      }
+    }
+    Check(vertexMismatch == 0, tag + ": vertices differ");
+
+    std::size_t faceMismatch{0};
+    std::uint32_t face[3];
+    for (std::uint64_t i = 0; i < file.GetNumberOfFaces(); ++i) {
+      file.GetFace(i, face);
+      if (face[0] != mesh.faces[i][0] || face[1] != mesh.faces[i][1] ||
+          face[2] != mesh.faces[i][2]) {
+        ++faceMismatch;
+      }
+    }
+    Check(faceMismatch == 0, tag + ": faces differ");
+
+    G4TessellatedSolid *solid = file.BuildTessellatedSolid("Mesh" + tag);
+    Check(static_cast<std::size_t>(solid->GetNumberOfFacets()) ==
+              mesh.faces.size(),
+          tag + ": number of facets");
+    Check(solid->GetSolidClosed(), tag + ": solid not closed");
+    Check(solid->Inside(G4ThreeVector(0, 0, 5. * um)) == kInside,
+          tag + ": point in the body");
+    Check(solid->Inside(G4ThreeVector(0, 0, 20. * um)) == kOutside,
+          tag + ": point above the surface");
+    delete solid;
+  }
+  std::remove(filename.c_str());
+}
+
+}  // namespace
+
+int main() {
+  const Mesh mesh = BuildMesh(20, 100.);
+  TestRoundTrip<G4double>("float64", mesh);
+  TestRoundTrip<float>("float32", mesh);
+
+  return Surface::Test::Result("MeshFile");
+}
@@ -0,0 +1,181 @@
+// Author agent
+// Date 26-10-17
+// File: Benchmark of the surface mesh loaders
+// Writes the same height map surface (~10^6 facets, layout of the python tool)
+// as GDML file and as binary mesh file, then compares file size and the time
+// to obtain a closed G4TessellatedSolid from each.
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+#include "G4GDMLParser.hh"
+#include "G4SolidStore.hh"
+#include "G4TessellatedSolid.hh"
+#include "G4ios.hh"
+#include "Randomize.hh"
+#include "Surface/MeshFile.hh"
+
+namespace {
+
+struct Mesh {
+  std::vector<std::array<G4double, 3>> vertices;  // um
+  std::vector<std::array<std::uint32_t, 3>> faces;
+};
+
+G4double MilliSince(const std::chrono::steady_clock::time_point start) {
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<G4double, std::milli>(stop - start).count();
+}
+
+// grid of n x n points, two triangles per cell, walls and bottom at z=0
+Mesh BuildMesh(const G4int n, const G4double length) {
+  Mesh mesh;
+  const G4double step = length / (n - 1);
+  for (G4int iy = 0; iy < n; ++iy) {
+    for (G4int ix = 0; ix < n; ++ix) {
+      const G4double height =
+          10. + std::sin(0.3 * ix) * std::cos(0.2 * iy) + G4UniformRand();
+      mesh.vertices.push_back(
+          {-0.5 * length + ix * step, -0.5 * length + iy * step, height});
+    }
+  }
+  auto top = [n](G4int ix, G4int iy) {
+    return static_cast<std::uint32_t>(iy * n + ix);
+  };
+  for (G4int iy = 0; iy < n - 1; ++iy) {
+    for (G4int ix = 0; ix < n - 1; ++ix) {
+      mesh.faces.push_back({top(ix, iy), top(ix + 1, iy), top(ix + 1, iy + 1)});
+      mesh.faces.push_back({top(ix, iy), top(ix + 1, iy + 1), top(ix, iy + 1)});
+    }
+  }
+  // counter clockwise ring of boundary points, copied to z=0
+  std::vector<std::uint32_t> ring;
+  for (G4int i = 0; i < n - 1; ++i) ring.push_back(top(i, 0));
+  for (G4int i = 0; i < n - 1; ++i) ring.push_back(top(n - 1, i));
+  for (G4int i = n - 1; i > 0; --i) ring.push_back(top(i, n - 1));
+  for (G4int i = n - 1; i > 0; --i) ring.push_back(top(0, i));
+  const auto first_bottom = static_cast<std::uint32_t>(mesh.vertices.size());
+  for (const auto idx : ring) {
+    mesh.vertices.push_back({mesh.vertices[idx][0], mesh.vertices[idx][1], 0});
+  }
+  const auto ring_size = static_cast<std::uint32_t>(ring.size());
+  for (std::uint32_t i = 0; i < ring_size; ++i) {
+    const std::uint32_t next = (i + 1) % ring_size;
+    mesh.faces.push_back({first_bottom + i, first_bottom + next, ring[next]});
+    mesh.faces.push_back({first_bottom + i, ring[next], ring[i]});
+  }
+  // bottom as fan around the first corner
+  const std::uint32_t corner[4] = {0, static_cast<std::uint32_t>(n - 1),
+                                   static_cast<std::uint32_t>(2 * (n - 1)),
+                                   static_cast<std::uint32_t>(3 * (n - 1))};
+  mesh.faces.push_back({first_bottom + corner[0], first_bottom + corner[2],
+                        first_bottom + corner[1]});
+  mesh.faces.push_back({first_bottom + corner[0], first_bottom + corner[3],
+                        first_bottom + corner[2]});
+  return mesh;
+}
+
+// same layout as GDMLWriter.py
+void WriteGDML(const Mesh &mesh, const G4String &filename) {
+  std::ofstream file(filename);
+  file << std::setprecision(17);
+  file << "<?xml version='1.0' encoding='UTF-8'?>\n<gdml>\n  <define>\n";
+  for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+    file << "    <position name=\"v" << i << "\" unit=\"um\" x=\""
+         << mesh.vertices[i][0] << "\" y=\"" << mesh.vertices[i][1]
+         << "\" z=\"" << mesh.vertices[i][2] << "\" />\n";
+  }
+  file << "  </define>\n  <materials />\n  <solids>\n    <tessellated "
+       << "aunit=\"degree\" lunit=\"um\" name=\"gdml_mesh\">\n";
+  for (const auto &face : mesh.faces) {
+    file << "      <triangular vertex1=\"v" << face[0] << "\" vertex2=\"v"
+         << face[1] << "\" vertex3=\"v" << face[2]
+         << "\" type=\"ABSOLUTE\" />\n";
+  }
+  file << "    </tessellated>\n  </solids>\n  <structure />\n  <userinfo />\n"
+       << "  <setup name=\"tessellated_surface\" version=\"1.0\">\n"
+       << "    <world ref=\"World\" />\n  </setup>\n</gdml>\n";
+}
+
+// same layout as MeshWriter.py
+void WriteMesh(const Mesh &mesh, const G4String &filename) {
+  std::ofstream file(filename, std::ios::binary);
+  const char magic[8] = "SC4MESH";
+  const std::uint32_t version{1};
+  const std::uint32_t vertex_bytes{8};
+  const std::uint64_t n_vertices{mesh.vertices.size()};
+  const std::uint64_t n_faces{mesh.faces.size()};
+  const G4double unit{1e-3};
+  file.write(magic, sizeof(magic));
+  file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+  file.write(reinterpret_cast<const char *>(&vertex_bytes),
+             sizeof(vertex_bytes));
+  file.write(reinterpret_cast<const char *>(&n_vertices), sizeof(n_vertices));
+  file.write(reinterpret_cast<const char *>(&n_faces), sizeof(n_faces));
+  file.write(reinterpret_cast<const char *>(&unit), sizeof(unit));
+  file.write(reinterpret_cast<const char *>(mesh.vertices.data()),
+             static_cast<std::streamsize>(n_vertices * 3 * sizeof(G4double)));
+  file.write(reinterpret_cast<const char *>(mesh.faces.data()),
+             static_cast<std::streamsize>(n_faces * 3 *
+                                          sizeof(std::uint32_t)));
+}
+
+G4double FileSize(const G4String &filename) {
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  return static_cast<G4double>(file.tellg()) / 1e6;
+}
+
+}  // namespace
+
+int main() {
+  const G4int n = 708;  // 2 * 707^2 + walls ~ 10^6 facets
+  const G4String gdmlFile = "meshLoader_benchmark.gdml";
+  const G4String meshFile = "meshLoader_benchmark.smesh";
+
+  const Mesh mesh = BuildMesh(n, 100.);
+  WriteGDML(mesh, gdmlFile);
+  WriteMesh(mesh, meshFile);
+  G4cout << "Facets: " << mesh.faces.size()
+         << " vertices: " << mesh.vertices.size() << G4endl;
+
+  auto start = std::chrono::steady_clock::now();
+  G4GDMLParser parser;
+  parser.Read(gdmlFile, false);
+  auto *gdmlSolid = dynamic_cast<G4TessellatedSolid *>(
+      G4SolidStore::GetInstance()->GetSolid("gdml_mesh"));
+  const G4double gdmlTime = MilliSince(start);
+
+  start = std::chrono::steady_clock::now();
+  Surface::MeshFile file(meshFile);
+  G4double sum{0};
+  for (std::uint64_t i = 0; i < file.GetNumberOfVertices(); ++i) {
+    sum += file.GetVertex(i).z();
+  }
+  const G4double scanTime = MilliSince(start);
+
+  start = std::chrono::steady_clock::now();
+  auto *meshSolid = file.BuildTessellatedSolid("binary_mesh");
+  const G4double meshTime = MilliSince(start);
+
+  G4cout << std::setw(10) << "Format" << std::setw(14) << "size [MB]"
+         << std::setw(14) << "load [ms]" << std::setw(12) << "facets"
+         << G4endl;
+  G4cout << std::setw(10) << "GDML" << std::setw(14) << FileSize(gdmlFile)
+         << std::setw(14) << gdmlTime << std::setw(12)
+         << (gdmlSolid ? gdmlSolid->GetNumberOfFacets() : 0) << G4endl;
+  G4cout << std::setw(10) << "smesh" << std::setw(14) << FileSize(meshFile)
+         << std::setw(14) << scanTime + meshTime << std::setw(12)
+         << meshSolid->GetNumberOfFacets() << G4endl;
+  G4cout << "smesh map + vertex scan [ms]: " << scanTime
+         << " solid build [ms]: " << meshTime << G4endl;
+  G4cout << "checksum " << sum << G4endl;
+  std::remove(gdmlFile.c_str());
+  std::remove(meshFile.c_str());
+  return 0;
+}
@@ -0,0 +1,126 @@
+// Author agent
+// Date 26-10-17
+// File: Benchmark of per step trigger lookup in PortalControl
+// Compares the former name compare + linear PortalStore scan with the
+// pointer keyed trigger index for 1, 10 and 1000 registered portals.
+
+#include <chrono>
+#include <iomanip>
+#include <vector>
+
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4NistManager.hh"
+#include "G4PVPlacement.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ThreeVector.hh"
+#include "Portal/include/PortalStore.hh"
+#include "Portal/include/SimplePortal.hh"
+#include "Randomize.hh"
+
+namespace {
+
+struct StepVolumes {
+  const G4VPhysicalVolume *pre;
+  const G4VPhysicalVolume *post;
+};
+
+// lookup as done before the trigger index existed
+G4int LegacyLookup(const Surface::PortalStore &store, const StepVolumes &step) {
+  const G4String preVolName = step.pre->GetName();
+  const G4String postVolName = step.post->GetName();
+  if (preVolName == postVolName) return -1;
+  for (size_t i = 0; i < store.size(); ++i) {
+    if (store[i]->GetTrigger() == step.post) {
+      return static_cast<G4int>(i);
+    }
+  }
+  return -1;
+}
+
+G4int IndexLookup(const Surface::PortalStore &store, const StepVolumes &step) {
+  if (step.pre == step.post) return -1;
+  return store.FindTrigger(step.post);
+}
+
+template <class F>
+G4double TimePerStep(const std::vector<StepVolumes> &steps, const F &lookup,
+                     G4int &checksum) {
+  const auto start = std::chrono::steady_clock::now();
+  for (const auto &step : steps) {
+    checksum += lookup(step);
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<G4double, std::nano>(stop - start).count() /
+         static_cast<G4double>(steps.size());
+}
+
+}  // namespace
+
+int main() {
+  G4Material *mat = G4NistManager::Instance()->FindOrBuildMaterial("G4_Galactic");
+  auto *solidWorld = new G4Box("World", 10 * m, 10 * m, 10 * m);
+  auto *logicWorld = new G4LogicalVolume(solidWorld, mat, "World");
+
+  constexpr G4int nSteps = 10000000;
+  constexpr G4double portalFraction = 0.01;  // 1% of steps touch a portal
+
+  G4cout << std::setw(10) << "Portals" << std::setw(20) << "legacy [ns/step]"
+         << std::setw(20) << "index [ns/step]" << G4endl;
+
+  for (const G4int nPortals : {1, 10, 1000}) {
+    Surface::PortalStore store;
+    std::vector<G4VPhysicalVolume *> triggers;
+    std::vector<G4VPhysicalVolume *> others;
+    auto *solid = new G4Box("Box", 1 * mm, 1 * mm, 1 * mm);
+    auto *logic = new G4LogicalVolume(solid, mat, "Box");
+    for (G4int i = 0; i < nPortals; ++i) {
+      const G4ThreeVector pos{0., 0., 3. * i * mm};
+      auto *phys = new G4PVPlacement(nullptr, pos, logic,
+                                     "Trigger_" + std::to_string(i),
+                                     logicWorld, false, i, false);
+      auto *portal = new Surface::SimplePortal("Portal_" + std::to_string(i),
+                                               phys, pos);
+      portal->SetTrigger(phys);
+      store.push_back(portal);
+      triggers.push_back(phys);
+    }
+    for (G4int i = 0; i < 10; ++i) {
+      const G4ThreeVector pos{5 * m, 0., 3. * i * mm};
+      others.push_back(new G4PVPlacement(nullptr, pos, logic,
+                                         "Other_" + std::to_string(i),
+                                         logicWorld, false, i, false));
+    }
+    store.BuildTriggerIndex();
+
+    std::vector<StepVolumes> steps;
+    steps.reserve(nSteps);
+    for (G4int i = 0; i < nSteps; ++i) {
+      const G4VPhysicalVolume *pre =
+          others[static_cast<size_t>(G4UniformRand() * others.size())];
+      const G4VPhysicalVolume *post = pre;
+      if (G4UniformRand() < portalFraction) {
+        post = triggers[static_cast<size_t>(G4UniformRand() * triggers.size())];
+      } else if (G4UniformRand() < 0.1) {
+        post = others[static_cast<size_t>(G4UniformRand() * others.size())];
+      }
+      steps.push_back(StepVolumes{pre, post});
+    }
+
+    G4int legacySum{0};
+    G4int indexSum{0};
+    const G4double legacy = TimePerStep(
+        steps,
+        [&store](const StepVolumes &s) { return LegacyLookup(store, s); },
+        legacySum);
+    const G4double index = TimePerStep(
+        steps,
+        [&store](const StepVolumes &s) { return IndexLookup(store, s); },
+        indexSum);
+
+    G4cout << std::setw(10) << nPortals << std::setw(20) << legacy
+           << std::setw(20) << index
+           << (legacySum == indexSum ? "" : "   result mismatch!") << G4endl;
+  }
+  return 0;
+}
@@ -0,0 +1,73 @@
+// Author agent
+// Date 26-10-17
+// File: Test of the trigger lookup of PortalStore
+// The trigger index has to follow every change of the store: adding,
+// replacing, erasing and re-adding portals.
+
+#include <string>
+#include <vector>
+
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4NistManager.hh"
+#include "G4PVPlacement.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ThreeVector.hh"
+#include "Portal/include/PortalStore.hh"
+#include "Portal/include/SimplePortal.hh"
+#include "UnitTest.hh"
+
+using Surface::Test::Check;
+
+int main() {
+  G4Material *mat =
+      G4NistManager::Instance()->FindOrBuildMaterial("G4_Galactic");
+  auto *solidWorld = new G4Box("World", 1 * m, 1 * m, 1 * m);
+  auto *logicWorld = new G4LogicalVolume(solidWorld, mat, "World");
+  auto *solid = new G4Box("Box", 1 * mm, 1 * mm, 1 * mm);
+  auto *logic = new G4LogicalVolume(solid, mat, "Box");
+
+  std::vector<G4VPhysicalVolume *> triggers;
+  std::vector<Surface::SimplePortal *> portals;
+  for (G4int i = 0; i < 4; ++i) {
+    const G4ThreeVector pos{0., 0., 3. * i * mm};
+    auto *phys = new G4PVPlacement(nullptr, pos, logic,
+                                   "Trigger_" + std::to_string(i), logicWorld,
+                                   false, i, false);
+    auto *portal =
+        new Surface::SimplePortal("Portal_" + std::to_string(i), phys, pos);
+    portal->SetTrigger(phys);
+    triggers.push_back(phys);
+    portals.push_back(portal);
+  }
+
+  Surface::PortalStore store;
+  store.push_back(portals[0]);
+  store.push_back(portals[1]);
+  store.BuildTriggerIndex();
+  Check(store.GetPortalOfTrigger(triggers[0]) == portals[0], "first portal");
+  Check(store.GetPortalOfTrigger(triggers[1]) == portals[1], "second portal");
+  Check(!store.IsTrigger(triggers[2]), "unknown trigger");
+
+  // added after the index was built
+  store.push_back(portals[2]);
+  Check(store.GetPortalOfTrigger(triggers[2]) == portals[2], "added portal");
+
+  // replaced, the size of the store does not change
+  store.SetPortal(1, portals[3]);
+  Check(!store.IsTrigger(triggers[1]), "replaced portal still indexed");
+  Check(store.GetPortalOfTrigger(triggers[3]) == portals[3],
+        "replacing portal");
+
+  // erased and re-added, the size of the store does not change either
+  store.erase(store.begin());
+  store.push_back(portals[1]);
+  Check(!store.IsTrigger(triggers[0]), "erased portal still indexed");
+  Check(store.FindTrigger(triggers[1]) == 2, "index of re-added portal");
+  Check(store.FindTrigger(triggers[3]) == 0, "index after erase");
+
+  store.clear();
+  Check(!store.IsTrigger(triggers[3]), "cleared store");
+
+  return Surface::Test::Result("PortalStore");
+}
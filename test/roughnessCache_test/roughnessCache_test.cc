@@ -0,0 +1,164 @@
+// Author agent
+// Date 26-10-17
+// File: Test of the build cache of RoughnessHelper
+// Builds the same roughness with the same seed into a fresh cache directory.
+// The first build generates and writes the cache file, the second one is
+// restored from it: facets, voxels and the following random numbers have to
+// be identical. Another seed has to give another cache file, a corrupted file
+// has to be rebuilt.
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+#include "Randomize.hh"
+#include "Service/include/G4Voxelizer_Green.hh"
+#include "Service/include/RoughnessHelper.hh"
+#include "SurfaceGenerator/include/FacetStore.hh"
+#include "UnitTest.hh"
+
+using Surface::Test::Check;
+
+namespace {
+
+struct BuildResult {
+  std::vector<G4ThreeVector> vertices;
+  G4double area;
+  std::vector<G4double> boundaries[3];
+  G4int maxBoundary[3];
+  std::vector<std::vector<G4int>> candidates;
+  G4double nextRandom;
+};
+
+BuildResult Build(const G4String &name, const G4String &cacheDir,
+                  const long seed) {
+  G4Random::setTheSeed(seed);
+  Surface::RoughnessHelper helper(name, Surface::VerboseLevel::Error);
+  helper.SetSpikeDx(1. * um);
+  helper.SetSpikeDy(1. * um);
+  helper.SetSpikeMeanHeight(2. * um);
+  helper.SetSpikeHeightDeviation(0.2 * um);
+  helper.SetSpikeform("UniformPyramid");
+  helper.SetSpikeNLayer(3);
+  helper.SetSpikeNx(20);
+  helper.SetSpikeNy(20);
+  helper.SetBasisDx(20. * um);
+  helper.SetBasisDy(20. * um);
+  helper.SetBasisHeight(1. * um);
+  helper.SetBoundaryX(50);
+  helper.SetBoundaryY(50);
+  helper.SetBoundaryZ(50);
+  helper.SetMaterial("G4_Si");
+  helper.SetCacheDir(cacheDir);
+  helper.Generate();
+
+  BuildResult result{};
+  result.nextRandom = G4UniformRand();
+  auto *store = helper.FacetStore();
+  store->CloseFacetStore();
+  result.area = store->GetArea();
+  for (std::size_t i = 0; i < static_cast<std::size_t>(store->Size()); ++i) {
+    for (G4int k = 0; k < 3; ++k) {
+      result.vertices.push_back(store->GetVertex(i, k));
+    }
+  }
+  auto &voxelizer =
+      (Surface::G4Voxelizer_Green &)helper.SolidRoughness()->GetVoxels();
+  for (G4int axis = 0; axis < 3; ++axis) {
+    result.boundaries[axis] = voxelizer.GetBoundary(axis);
+    result.maxBoundary[axis] = voxelizer.GetMaxBoundary(axis);
+  }
+  std::vector<G4int> voxel(3);
+  std::vector<G4int> candidates;
+  const G4int nx = static_cast<G4int>(result.boundaries[0].size()) - 1;
+  const G4int ny = static_cast<G4int>(result.boundaries[1].size()) - 1;
+  const G4int nz = static_cast<G4int>(result.boundaries[2].size()) - 1;
+  for (voxel[2] = 0; voxel[2] < nz; ++voxel[2]) {
+    for (voxel[1] = 0; voxel[1] < ny; ++voxel[1]) {
+      for (voxel[0] = 0; voxel[0] < nx; ++voxel[0]) {
+        voxelizer.GetCandidatesVoxelArray(voxel, candidates);
+        result.candidates.push_back(candidates);
+      }
+    }
+  }
+  return result;
+}
+
+void Compare(const G4String &tag, const BuildResult &expected,
+             const BuildResult &result) {
+  Check(!expected.vertices.empty(), tag + ": no facets");
+  Check(expected.vertices == result.vertices, tag + ": facets differ");
+  Check(expected.area == result.area, tag + ": area differs");
+  for (G4int axis = 0; axis < 3; ++axis) {
+    Check(expected.boundaries[axis] == result.boundaries[axis],
+          tag + ": boundaries differ on axis " + std::to_string(axis));
+    Check(expected.maxBoundary[axis] == result.maxBoundary[axis],
+          tag + ": max boundary differs on axis " + std::to_string(axis));
+  }
+  Check(expected.candidates == result.candidates,
+        tag + ": voxel candidates differ");
+  Check(expected.nextRandom == result.nextRandom,
+        tag + ": random numbers after the build differ");
+}
+
+std::vector<std::string> CacheFiles(const G4String &directory) {
+  std::vector<std::string> files;
+  DIR *dir = opendir(directory.c_str());
+  if (dir == nullptr) {
+    return files;
+  }
+  while (const dirent *entry = readdir(dir)) {
+    const std::string name = entry->d_name;
+    const std::string extension = ".cache";
+    if (name.size() > extension.size() &&
+        name.compare(name.size() - extension.size(), extension.size(),
+                     extension) == 0) {
+      files.push_back(directory + "/" + name);
+    }
+  }
+  closedir(dir);
+  return files;
+}
+
+}  // namespace
+
+int main() {
+  const G4String cacheDir =
+      "roughnessCache_test_" + std::to_string(getpid());
+  const long seed{4711};
+
+  const BuildResult miss = Build("miss", cacheDir, seed);
+  std::vector<std::string> files = CacheFiles(cacheDir);
+  Check(files.size() == 1, "one cache file after the first build");
+
+  const BuildResult hit = Build("hit", cacheDir, seed);
+  Compare("restored", miss, hit);
+  Check(CacheFiles(cacheDir).size() == 1, "cache hit wrote a new file");
+
+  const BuildResult other = Build("other", cacheDir, seed + 1);
+  Check(other.vertices != miss.vertices, "other seed gives the same facets");
+  Check(CacheFiles(cacheDir).size() == 2, "other seed uses the same file");
+
+  // a corrupted file is a miss and is written again
+  if (!files.empty()) {
+    std::ofstream(files.front(), std::ios::binary | std::ios::trunc)
+        << "SC4RGHC";
+    const BuildResult rebuilt = Build("rebuilt", cacheDir, seed);
+    Compare("rebuilt", miss, rebuilt);
+    const BuildResult restored = Build("restored", cacheDir, seed);
+    Compare("restored after rebuild", miss, restored);
+  }
+
+  for (const auto &file : CacheFiles(cacheDir)) {
+    std::remove(file.c_str());
+  }
+  rmdir(cacheDir.c_str());
+
+  return Surface::Test::Result("RoughnessCache");
+}
@@ -0,0 +1,145 @@
+// Author agent
+// Date 26-10-17
+// File: Test of ShiftTable
+// Samples a table with counts proportional to the depth (density ~ x) for
+// several ranges. All depths have to lie within the range, the share of draws
+// below a depth and the range probability have to match the closed form
+// values. Also checks an empty range, SampleWithin() and reloading a table.
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+#include "Service/include/ShiftTable.hh"
+#include "UnitTest.hh"
+
+using Surface::Test::Check;
+
+namespace {
+
+constexpr G4int kDraws{200000};
+
+// tolerance of 5 sigma for a share p of kDraws draws
+G4double ShareTolerance(const G4double p) {
+  return 5. * std::sqrt(p * (1. - p) / kDraws) + 1e-9;
+}
+
+void WriteTable(const std::string &filename,
+                const std::vector<std::pair<G4double, G4double>> &points) {
+  std::ofstream file(filename);
+  for (const auto &point : points) {
+    file << point.first << "," << point.second << "\n";
+  }
+}
+
+// counts equal to the depth on 0, 10, ..., 100 nm: P(x < d) = (d / 100)^2
+std::vector<std::pair<G4double, G4double>> Triangle() {
+  std::vector<std::pair<G4double, G4double>> points;
+  for (G4int i = 0; i <= 10; ++i) {
+    points.emplace_back(10. * i, 10. * i);
+  }
+  return points;
+}
+
+G4double TriangleCumulative(const G4double depth) {
+  return depth * depth / 1e4;
+}
+
+void TestRange(Surface::ShiftTable &table, const G4double min,
+               const G4double max) {
+  const G4String tag = "range [" + std::to_string(min) + ", " +
+                       std::to_string(max) + "] nm";
+  table.SetRange(min * nm, max * nm);
+  const G4double inRange = TriangleCumulative(max) - TriangleCumulative(min);
+  Check(std::abs(table.GetRangeProbability() - inRange) < 1e-12,
+        tag + ": range probability");
+  Check(!table.IsRangeEmpty(), tag + ": range empty");
+
+  const G4double middle = 0.5 * (min + max);
+  const G4double expected =
+      (TriangleCumulative(middle) - TriangleCumulative(min)) / inRange;
+  G4int outside{0};
+  G4int below{0};
+  for (G4int i = 0; i < kDraws; ++i) {
+    const G4double depth = table.Sample() / nm;
+    if (depth < min || depth > max) {
+      ++outside;
+    }
+    if (depth < middle) {
+      ++below;
+    }
+  }
+  Check(outside == 0, tag + ": " + std::to_string(outside) +
+                          " depths outside of the range");
+  const G4double share = static_cast<G4double>(below) / kDraws;
+  Check(std::abs(share - expected) < ShareTolerance(expected),
+        tag + ": share below " + std::to_string(middle) + " nm is " +
+            std::to_string(share) + " instead of " + std::to_string(expected));
+}
+
+}  // namespace
+
+int main() {
+  const std::string filename = "shiftTable_test.csv";
+  Surface::ShiftTable table;
+  Check(!table.Load("shiftTable_test_missing.csv"), "missing file loaded");
+
+  WriteTable(filename, Triangle());
+  Check(table.Load(filename), "table not loaded");
+  Check(table.IsReady(), "table not ready");
+
+  TestRange(table, 0, 100);
+  TestRange(table, 50, 100);
+  TestRange(table, 12.5, 13.5);  // within one table bin
+  TestRange(table, 0, 35);
+
+  // no probability in the range, the full table is sampled
+  table.SetRange(200 * nm, 300 * nm);
+  Check(table.IsRangeEmpty(), "range outside of the table not empty");
+  G4bool inTable{true};
+  for (G4int i = 0; i < 1000; ++i) {
+    const G4double depth = table.Sample() / nm;
+    inTable = inTable && depth >= 0 && depth <= 100;
+  }
+  Check(inTable, "empty range: depth outside of the table");
+
+  // intervals [10, 20] and [70, 80] nm hold 3 % and 15 % of the table
+  table.SetRange(0, 100 * nm);
+  const std::vector<Surface::ShiftTable::Interval> intervals = {
+      {10 * nm, 20 * nm}, {70 * nm, 80 * nm}};
+  G4int inFirst{0};
+  G4int outside{0};
+  G4double share{0};
+  for (G4int i = 0; i < kDraws; ++i) {
+    G4double depth{0};
+    if (!table.SampleWithin(intervals, depth, share)) {
+      ++outside;
+      continue;
+    }
+    depth /= nm;
+    if (depth >= 10 && depth <= 20) {
+      ++inFirst;
+    } else if (depth < 70 || depth > 80) {
+      ++outside;
+    }
+  }
+  Check(outside == 0, "SampleWithin: depth outside of the intervals");
+  Check(std::abs(share - 0.18) < 1e-12, "SampleWithin: share");
+  const G4double firstShare = static_cast<G4double>(inFirst) / kDraws;
+  Check(std::abs(firstShare - 3. / 18.) < ShareTolerance(3. / 18.),
+        "SampleWithin: share of the first interval");
+
+  // loading replaces the table: uniform on [0, 10] nm
+  WriteTable(filename, {{0., 1.}, {5., 1.}, {10., 1.}});
+  Check(table.Load(filename), "second table not loaded");
+  table.SetRange(0, 100 * nm);
+  Check(table.GetSampledRange().second <= 10 * nm,
+        "second table appended to the first");
+  std::remove(filename.c_str());
+
+  return Surface::Test::Result("ShiftTable");
+}
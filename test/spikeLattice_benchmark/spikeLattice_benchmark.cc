@@ -0,0 +1,156 @@
+// Author agent
+// Date 26-10-17
+// File: Benchmark of the roughness solid representations
+// Builds the same roughness as G4MultiUnion and as SpikeLatticeSolid for
+// several lattice sizes and spike shapes, compares build time, navigation time
+// per call and counts disagreeing Inside() results.
+
+#include <chrono>
+#include <iomanip>
+#include <vector>
+
+#include "G4RandomDirection.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4VSolid.hh"
+#include "G4ios.hh"
+#include "Randomize.hh"
+#include "Service/include/RoughnessHelper.hh"
+
+namespace {
+
+struct Timing {
+  G4double build;
+  G4double inside;
+  G4double toIn;
+  G4double toOut;
+};
+
+G4double NanoSince(const std::chrono::steady_clock::time_point start,
+                   const size_t calls) {
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<G4double, std::nano>(stop - start).count() /
+         static_cast<G4double>(calls);
+}
+
+Surface::RoughnessHelper *Build(const G4String &name,
+                                const Surface::RoughnessSolid type,
+                                const Surface::Spikeform form, const G4int n,
+                                G4double &buildTime) {
+  const G4double spikeWidth = 1. * um;
+  auto *helper =
+      new Surface::RoughnessHelper(name, Surface::VerboseLevel::Error);
+  helper->SetSolidType(type);
+  helper->SetSpikeform(form);
+  helper->SetSpikeNx(n);
+  helper->SetSpikeNy(n);
+  helper->SetSpikeDx(spikeWidth);
+  helper->SetSpikeDy(spikeWidth);
+  helper->SetSpikeMeanHeight(2. * spikeWidth);
+  helper->SetSpikeHeightDeviation(0.5 * spikeWidth);
+  helper->SetSpikeNLayer(5);
+  helper->SetBasisDx(n * spikeWidth);
+  helper->SetBasisDy(n * spikeWidth);
+  helper->SetBasisHeight(spikeWidth);
+  helper->SetMaterial("G4_Si");
+  const auto start = std::chrono::steady_clock::now();
+  helper->Generate();
+  buildTime = NanoSince(start, 1) * 1e-6;  // ms
+  return helper;
+}
+
+Timing Measure(const G4VSolid *solid, const std::vector<G4ThreeVector> &points,
+               const std::vector<G4ThreeVector> &directions, G4double &sum) {
+  Timing timing{0, 0, 0, 0};
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &point : points) {
+    sum += solid->Inside(point);
+  }
+  timing.inside = NanoSince(start, points.size());
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < points.size(); ++i) {
+    const G4double dist = solid->DistanceToIn(points[i], directions[i]);
+    sum += dist < kInfinity ? dist : 0;
+  }
+  timing.toIn = NanoSince(start, points.size());
+  start = std::chrono::steady_clock::now();
+  size_t calls{0};
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (solid->Inside(points[i]) == kInside) {
+      sum += solid->DistanceToOut(points[i], directions[i]);
+      ++calls;
+    }
+  }
+  timing.toOut = NanoSince(start, calls > 0 ? calls : 1);
+  return timing;
+}
+
+void PrintRow(const G4String &label, const G4int n, const Timing &timing) {
+  G4cout << std::setw(14) << label << std::setw(6) << n << std::setw(14)
+         << timing.build << std::setw(14) << timing.inside << std::setw(14)
+         << timing.toIn << std::setw(14) << timing.toOut << G4endl;
+}
+
+}  // namespace
+
+int main() {
+  constexpr size_t nPoints = 100000;
+  G4double checksum{0};
+
+  G4cout << std::setw(14) << "Solid" << std::setw(6) << "N" << std::setw(14)
+         << "build [ms]" << std::setw(14) << "Inside [ns]" << std::setw(14)
+         << "DistIn [ns]" << std::setw(14) << "DistOut [ns]" << std::setw(12)
+         << "mismatch" << G4endl;
+
+  const std::vector<std::pair<G4String, Surface::Spikeform>> forms = {
+      {"Pyramid", Surface::Spikeform::StandardPyramid},
+      {"Bump", Surface::Spikeform::Bump}};
+  for (const auto &form : forms) {
+    for (const G4int n : {10, 30, 100}) {
+      const G4String tag = form.first + std::to_string(n);
+      Timing multiUnion{0, 0, 0, 0};
+      Timing lattice{0, 0, 0, 0};
+      auto *helperUnion =
+          Build("Union" + tag, Surface::RoughnessSolid::MultiUnion,
+                form.second, n, multiUnion.build);
+      auto *helperLattice =
+          Build("Lattice" + tag, Surface::RoughnessSolid::SpikeLattice,
+                form.second, n, lattice.build);
+
+      // points in the bounding box of the roughness, isotropic directions
+      G4ThreeVector pMin;
+      G4ThreeVector pMax;
+      helperUnion->GetSolid()->BoundingLimits(pMin, pMax);
+      std::vector<G4ThreeVector> points(nPoints);
+      std::vector<G4ThreeVector> directions(nPoints);
+      for (size_t i = 0; i < nPoints; ++i) {
+        points[i] = {pMin.x() + G4UniformRand() * (pMax.x() - pMin.x()),
+                     pMin.y() + G4UniformRand() * (pMax.y() - pMin.y()),
+                     pMin.z() + G4UniformRand() * (pMax.z() - pMin.z())};
+        directions[i] = G4RandomDirection();
+      }
+
+      size_t mismatch{0};
+      for (const auto &point : points) {
+        if (helperUnion->GetSolid()->Inside(point) !=
+            helperLattice->GetSolid()->Inside(point)) {
+          ++mismatch;
+        }
+      }
+
+      const Timing timeUnion = Measure(helperUnion->GetSolid(), points,
+                                       directions, checksum);
+      const Timing timeLattice = Measure(helperLattice->GetSolid(), points,
+                                         directions, checksum);
+      PrintRow("MultiUnion", n,
+               {multiUnion.build, timeUnion.inside, timeUnion.toIn,
+                timeUnion.toOut});
+      PrintRow("SpikeLattice", n,
+               {lattice.build, timeLattice.inside, timeLattice.toIn,
+                timeLattice.toOut});
+      G4cout << std::setw(14) << form.first << std::setw(74) << mismatch
+             << G4endl;
+    }
+  }
+  G4cout << "checksum " << checksum << G4endl;
+  return 0;
+}
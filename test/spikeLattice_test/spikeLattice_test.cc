@@ -0,0 +1,137 @@
+// Author agent
+// Date 26-10-17
+// File: Test of SpikeLatticeSolid against the G4MultiUnion roughness
+// Builds the same roughness as G4MultiUnion and as SpikeLatticeSolid and
+// compares Inside() and DistanceToIn() for random points and directions in
+// the bounding box. UniformPyramid is not compared, its heights differ by
+// construction.
+
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "G4RandomDirection.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4VSolid.hh"
+#include "G4ios.hh"
+#include "Randomize.hh"
+#include "Service/include/RoughnessHelper.hh"
+#include "UnitTest.hh"
+
+using Surface::Test::Check;
+
+namespace {
+
+Surface::RoughnessHelper *Build(const G4String &name,
+                                const Surface::RoughnessSolid type,
+                                const Surface::Spikeform form, const G4int n) {
+  const G4double spikeWidth = 1. * um;
+  auto *helper =
+      new Surface::RoughnessHelper(name, Surface::VerboseLevel::Error);
+  helper->SetSolidType(type);
+  helper->SetSpikeform(form);
+  helper->SetSpikeNx(n);
+  helper->SetSpikeNy(n);
+  helper->SetSpikeDx(spikeWidth);
+  helper->SetSpikeDy(spikeWidth);
+  helper->SetSpikeMeanHeight(2. * spikeWidth);
+  helper->SetSpikeHeightDeviation(0.5 * spikeWidth);
+  helper->SetSpikeNLayer(5);
+  helper->SetBasisDx(n * spikeWidth);
+  helper->SetBasisDy(n * spikeWidth);
+  helper->SetBasisHeight(spikeWidth);
+  helper->SetMaterial("G4_Si");
+  helper->Generate();
+  return helper;
+}
+
+void Compare(const G4String &tag, const G4VSolid *reference,
+             const G4VSolid *lattice) {
+  constexpr std::size_t nPoints = 20000;
+  const G4double tolerance = 10. * kCarTolerance;
+  G4ThreeVector pMin;
+  G4ThreeVector pMax;
+  reference->BoundingLimits(pMin, pMax);
+
+  std::size_t insideMismatch{0};
+  std::size_t distanceMismatch{0};
+  std::size_t safetyTooLarge{0};
+  std::size_t outside{0};
+  for (std::size_t i = 0; i < nPoints; ++i) {
+    const G4ThreeVector point{
+        pMin.x() + G4UniformRand() * (pMax.x() - pMin.x()),
+        pMin.y() + G4UniformRand() * (pMax.y() - pMin.y()),
+        pMin.z() + G4UniformRand() * (pMax.z() - pMin.z())};
+    const EInside insideReference = reference->Inside(point);
+    const EInside insideLattice = lattice->Inside(point);
+    // points within the tolerance of a surface may be classified either way
+    if (insideReference == kSurface || insideLattice == kSurface) {
+      continue;
+    }
+    if (insideReference != insideLattice) {
+      ++insideMismatch;
+      continue;
+    }
+    if (insideReference != kOutside) {
+      continue;
+    }
+    ++outside;
+    const G4ThreeVector direction = G4RandomDirection();
+    const G4double distReference = reference->DistanceToIn(point, direction);
+    const G4double distLattice = lattice->DistanceToIn(point, direction);
+    const G4bool bothMiss = distReference == kInfinity &&
+                            distLattice == kInfinity;
+    if (!bothMiss && std::abs(distReference - distLattice) > tolerance) {
+      ++distanceMismatch;
+    }
+    // the safety must never exceed the distance along any direction
+    if (lattice->DistanceToIn(point) > distLattice + tolerance) {
+      ++safetyTooLarge;
+    }
+  }
+  Check(insideMismatch == 0,
+        tag + ": Inside differs for " + std::to_string(insideMismatch) +
+            " points");
+  Check(outside > nPoints / 10, tag + ": too few points outside");
+  // rays grazing an edge may be resolved differently by the two solids
+  Check(distanceMismatch * 1000 <= outside,
+        tag + ": DistanceToIn differs for " +
+            std::to_string(distanceMismatch) + " of " +
+            std::to_string(outside) + " rays");
+  Check(safetyTooLarge == 0,
+        tag + ": safety larger than the distance for " +
+            std::to_string(safetyTooLarge) + " points");
+}
+
+}  // namespace
+
+int main() {
+  const std::vector<std::pair<G4String, Surface::Spikeform>> forms = {
+      {"Pyramid", Surface::Spikeform::StandardPyramid},
+      {"Bump", Surface::Spikeform::Bump},
+      {"Peak", Surface::Spikeform::Peak}};
+  for (const auto &form : forms) {
+    for (const G4int n : {1, 4, 10}) {
+      const G4String tag = form.first + std::to_string(n);
+      auto *helperUnion = Build("Union" + tag,
+                                Surface::RoughnessSolid::MultiUnion,
+                                form.second, n);
+      auto *helperLattice = Build("Lattice" + tag,
+                                  Surface::RoughnessSolid::SpikeLattice,
+                                  form.second, n);
+      G4ThreeVector unionMin;
+      G4ThreeVector unionMax;
+      G4ThreeVector latticeMin;
+      G4ThreeVector latticeMax;
+      helperUnion->GetSolid()->BoundingLimits(unionMin, unionMax);
+      helperLattice->GetSolid()->BoundingLimits(latticeMin, latticeMax);
+      Check((unionMin - latticeMin).mag() < 10. * kCarTolerance &&
+                (unionMax - latticeMax).mag() < 10. * kCarTolerance,
+            tag + ": bounding limits differ");
+      Compare(tag, helperUnion->GetSolid(), helperLattice->GetSolid());
+    }
+  }
+
+  return Surface::Test::Result("SpikeLatticeSolid");
+}
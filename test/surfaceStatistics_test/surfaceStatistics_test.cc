@@ -0,0 +1,129 @@
+// Author agent
+// Date 26-10-17
+// File: Test of SurfaceStatistics
+// Compares the roughness parameters of a flat and of a tilted plane with their
+// closed form values, checks that a random height field gives identical
+// results on one and on several threads and that FacetStore::GetStatistics()
+// follows appended facets.
+
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+#include "Randomize.hh"
+#include "SurfaceGenerator/include/FacetStore.hh"
+#include "SurfaceGenerator/include/SurfaceStatistics.hh"
+#include "UnitTest.hh"
+
+using Surface::Test::Check;
+
+namespace {
+
+void CheckClose(const G4double value, const G4double expected,
+                const G4double tolerance, const G4String &what) {
+  Check(std::abs(value - expected) <= tolerance,
+        what + ": " + std::to_string(value) + " instead of " +
+            std::to_string(expected));
+}
+
+// n x n grid cells of 1 um, two facets per cell
+void FillGrid(Surface::FacetStore &store, const G4int n,
+              const std::function<G4double(G4int, G4int)> &height) {
+  auto vertex = [&](G4int i, G4int j) {
+    return G4ThreeVector(i * um, j * um, height(i, j));
+  };
+  for (G4int i = 0; i < n; ++i) {
+    for (G4int j = 0; j < n; ++j) {
+      store.AppendFacet(vertex(i, j), vertex(i + 1, j), vertex(i + 1, j + 1));
+      store.AppendFacet(vertex(i, j), vertex(i + 1, j + 1), vertex(i, j + 1));
+    }
+  }
+}
+
+G4bool Identical(const Surface::SurfaceStatistics &a,
+                 const Surface::SurfaceStatistics &b) {
+  return a.ProjectedSurface == b.ProjectedSurface &&
+         a.MeanHeight == b.MeanHeight && a.Sz == b.Sz && a.Sa == b.Sa &&
+         a.Sv == b.Sv && a.Sp == b.Sp && a.Sku == b.Sku && a.Ssk == b.Ssk &&
+         a.Sq == b.Sq && a.Area == b.Area;
+}
+
+void TestFlat() {
+  Surface::FacetStore store("flat");
+  const G4double z = 3. * um;
+  FillGrid(store, 10, [z](G4int, G4int) { return z; });
+  const auto statistics = Surface::SurfaceStatistics::Compute(store, 1);
+  const G4double tolerance = 1e-12 * mm;
+  CheckClose(statistics.MeanHeight, z, tolerance, "flat: mean height");
+  CheckClose(statistics.Sa, 0, tolerance, "flat: Sa");
+  CheckClose(statistics.Sq, 0, tolerance, "flat: Sq");
+  CheckClose(statistics.Sz, 0, tolerance, "flat: Sz");
+  CheckClose(statistics.Area, 100. * um * um, 1e-9 * um * um, "flat: area");
+  CheckClose(statistics.ProjectedSurface, 100. * um * um, 1e-9 * um * um,
+             "flat: projected area");
+}
+
+// z = slope * x, heights uniform in [0, slope * L]
+void TestTilted() {
+  Surface::FacetStore store("tilted");
+  const G4int n{10};
+  const G4double slope{0.5};
+  FillGrid(store, n, [slope](G4int i, G4int) { return slope * i * um; });
+  const auto statistics = Surface::SurfaceStatistics::Compute(store, 1);
+  const G4double range = slope * n * um;
+  const G4double tolerance = 1e-9 * range;
+  CheckClose(statistics.MeanHeight, range / 2, tolerance, "tilted: mean");
+  CheckClose(statistics.Sa, range / 4, tolerance, "tilted: Sa");
+  CheckClose(statistics.Sq, range / std::sqrt(12.), tolerance, "tilted: Sq");
+  CheckClose(statistics.Ssk, 0, 1e-9, "tilted: Ssk");
+  CheckClose(statistics.Sku, 1.8, 1e-9, "tilted: Sku");
+  CheckClose(statistics.Sp, range / 2, tolerance, "tilted: Sp");
+  CheckClose(statistics.Sv, range / 2, tolerance, "tilted: Sv");
+  CheckClose(statistics.Sz, range, tolerance, "tilted: Sz");
+  const G4double projected = n * n * um * um;
+  CheckClose(statistics.ProjectedSurface, projected, 1e-9 * projected,
+             "tilted: projected area");
+  CheckClose(statistics.Area, projected * std::sqrt(1. + slope * slope),
+             1e-9 * projected, "tilted: area");
+}
+
+void TestThreads() {
+  Surface::FacetStore store("random");
+  const G4int n{100};  // 20000 facets, several blocks
+  std::vector<G4double> height((n + 1) * (n + 1));
+  for (auto &h : height) {
+    h = G4UniformRand() * um;
+  }
+  FillGrid(store, n,
+           [&](G4int i, G4int j) { return height[i * (n + 1) + j]; });
+  const auto single = Surface::SurfaceStatistics::Compute(store, 1);
+  for (const G4int threads : {2, 3, 8, 0}) {
+    Check(Identical(single, Surface::SurfaceStatistics::Compute(store,
+                                                               threads)),
+          "results differ with " + std::to_string(threads) + " threads");
+  }
+  Check(single.Sa > 0 && single.Sa <= single.Sq && single.Sq <= single.Sz,
+        "random: Sa <= Sq <= Sz");
+  Check(Identical(single, store.GetStatistics()),
+        "FacetStore::GetStatistics differs");
+
+  // a facet far above the surface changes the cached statistics
+  store.AppendFacet(G4ThreeVector(0, 0, 10. * um),
+                    G4ThreeVector(1. * um, 0, 10. * um),
+                    G4ThreeVector(1. * um, 1. * um, 10. * um));
+  Check(store.GetStatistics().Sp > single.Sp,
+        "FacetStore::GetStatistics ignores appended facet");
+}
+
+}  // namespace
+
+int main() {
+  TestFlat();
+  TestTilted();
+  TestThreads();
+
+  return Surface::Test::Result("SurfaceStatistics");
+}
@@ -0,0 +1,116 @@
+// Author agent
+// Date 26-10-17
+// File: Test of VertexFileWriter and VertexFileReader
+// Writes numbered vertices with a small block size, so blocks are written
+// and read in the background, and reads them back. The full file, a range and
+// the shards of the file have to return the written records in order, the
+// shards have to cover the file without overlap and a range has to be
+// replayed from its start after its end. Also checks that files which are not
+// vertex files are rejected.
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "G4ios.hh"
+#include "Service/include/VertexFile.hh"
+#include "UnitTest.hh"
+
+using Surface::Test::Check;
+
+namespace {
+
+constexpr std::size_t kBlockSize{64};
+constexpr std::uint64_t kVertices{1003};
+
+// record i is recognised by its position and cell
+Surface::VertexRecord Record(const std::uint64_t i) {
+  const auto x = static_cast<G4double>(i);
+  return Surface::VertexRecord{{x, -x, 0.5 * x},
+                               {0., 0., 1.},
+                               static_cast<std::int32_t>(i % 100),
+                               static_cast<std::int32_t>(i / 100)};
+}
+
+G4bool Equal(const Surface::VertexRecord &a, const Surface::VertexRecord &b) {
+  for (G4int k = 0; k < 3; ++k) {
+    if (a.position[k] != b.position[k] || a.normal[k] != b.normal[k]) {
+      return false;
+    }
+  }
+  return a.cellX == b.cellX && a.cellY == b.cellY;
+}
+
+// reads n records and compares them to the records first, first + 1, ...
+G4bool ReadsRecords(Surface::VertexFileReader &reader,
+                    const std::uint64_t first, const std::uint64_t n) {
+  G4bool equal{true};
+  for (std::uint64_t i = 0; i < n; ++i) {
+    equal = Equal(reader.Next(), Record(first + i)) && equal;
+  }
+  return equal;
+}
+
+}  // namespace
+
+int main() {
+  const std::string filename = "vertexStream_test.bin";
+  {
+    Surface::VertexFileWriter writer(filename, kBlockSize);
+    Check(writer.Open(), "temporary file not created");
+    for (std::uint64_t i = 0; i < kVertices; ++i) {
+      writer.Append(Record(i));
+    }
+    Check(writer.GetSize() == kVertices, "writer size");
+    Check(writer.Close(), "file not written");
+  }
+
+  Surface::VertexFileReader reader(kBlockSize);
+  Check(reader.Open(filename), "file not read");
+  Check(reader.GetSize() == kVertices, "reader size");
+  Check(reader.GetRangeSize() == kVertices, "default range is not the file");
+  Check(ReadsRecords(reader, 0, kVertices), "records of the file");
+  Check(reader.GetRestarts() == 0, "restart within the file");
+
+  // a range starts over at its first record
+  reader.SetRange(100, 150);
+  Check(reader.GetRangeBegin() == 100, "range begin");
+  Check(reader.GetRangeSize() == 150, "range size");
+  Check(ReadsRecords(reader, 100, 150), "records of the range");
+  Check(ReadsRecords(reader, 100, 10), "records of the replayed range");
+  Check(reader.GetRestarts() == 1, "restarts of the range");
+
+  reader.SetRange(kVertices - 10, 100);
+  Check(reader.GetRangeSize() == 10, "range not clipped to the file");
+
+  // shards are disjoint, cover the file and differ by at most one record
+  constexpr std::uint64_t nShards{4};
+  std::uint64_t next{0};
+  for (std::uint64_t shard = 0; shard < nShards; ++shard) {
+    reader.SetShard(shard, nShards);
+    const std::string name = "shard " + std::to_string(shard);
+    const std::uint64_t size = reader.GetRangeSize();
+    Check(reader.GetRangeBegin() == next, name + " does not follow");
+    Check(size == kVertices / nShards || size == kVertices / nShards + 1,
+          name + " size");
+    Check(ReadsRecords(reader, next, size), "records of " + name);
+    next += size;
+  }
+  Check(next == kVertices, "shards do not cover the file");
+  reader.SetShard(nShards, nShards);
+  Check(reader.GetRangeSize() == 0, "shard outside of the shards");
+
+  // not a vertex file
+  {
+    std::ofstream file(filename, std::ios::trunc);
+    file << "position,normal\n0,0,0,0,0,1\n";
+  }
+  Check(!reader.Open(filename), "text file read as vertex file");
+  Check(reader.GetRangeSize() == 0, "range of a rejected file");
+  std::remove(filename.c_str());
+  Check(!reader.Open(filename), "missing file read");
+
+  return Surface::Test::Result("VertexStream");
+}
@@ -0,0 +1,127 @@
+// Author agent
+// Date 26-10-17
+// File: Test of VoxelTuner
+// Tunes the voxel boundaries of a union of randomly placed boxes with a large,
+// a tight and a too small memory limit. The chosen setting has to respect the
+// limit (or be the coarsest one), the union has to be left voxelized with it
+// and Inside() has to agree with a loop over all nodes.
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "G4Box.hh"
+#include "G4MultiUnion.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+#include "Randomize.hh"
+#include "Service/include/G4Voxelizer_Green.hh"
+#include "Service/include/VoxelTuner.hh"
+#include "UnitTest.hh"
+
+using Surface::Test::Check;
+
+namespace {
+
+std::vector<G4ThreeVector> RandomPositions(const G4int nodes) {
+  std::vector<G4ThreeVector> positions;
+  const G4int side = static_cast<G4int>(std::sqrt(nodes));
+  for (G4int i = 0; i < nodes; ++i) {
+    positions.emplace_back((i % side) * um, (i / side) * um,
+                           G4UniformRand() * um);
+  }
+  return positions;
+}
+
+G4MultiUnion *BuildUnion(G4Box &box,
+                         const std::vector<G4ThreeVector> &positions) {
+  auto *munion = new G4MultiUnion("union");
+  for (const auto &position : positions) {
+    munion->AddNode(box, G4Transform3D(G4RotationMatrix(), position));
+  }
+  return munion;
+}
+
+Surface::G4Voxelizer_Green &Voxelizer(G4MultiUnion *munion) {
+  return (Surface::G4Voxelizer_Green &)munion->GetVoxels();
+}
+
+// Inside() through the voxels against a loop over all nodes
+G4bool InsideAgrees(const G4MultiUnion *munion, const G4Box &box,
+                    const std::vector<G4ThreeVector> &positions) {
+  G4ThreeVector pMin;
+  G4ThreeVector pMax;
+  munion->BoundingLimits(pMin, pMax);
+  for (G4int i = 0; i < 2000; ++i) {
+    const G4ThreeVector point{
+        pMin.x() + G4UniformRand() * (pMax.x() - pMin.x()),
+        pMin.y() + G4UniformRand() * (pMax.y() - pMin.y()),
+        pMin.z() + G4UniformRand() * (pMax.z() - pMin.z())};
+    G4bool inAnyNode{false};
+    G4bool onAnySurface{false};
+    for (const auto &position : positions) {
+      const EInside inside = box.Inside(point - position);
+      inAnyNode = inAnyNode || inside == kInside;
+      onAnySurface = onAnySurface || inside == kSurface;
+    }
+    if (onAnySurface && !inAnyNode) {
+      continue;  // surface of a node, may be inside the union
+    }
+    if ((munion->Inside(point) == kInside) != inAnyNode) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Surface::VoxelTuner::Setting Tune(const G4String &tag, G4Box &box,
+                                  const std::vector<G4ThreeVector> &positions,
+                                  const std::size_t memoryLimit) {
+  G4MultiUnion *munion = BuildUnion(box, positions);
+  Surface::VoxelTuner tuner(munion, memoryLimit, 256);
+  const Surface::VoxelTuner::Setting chosen = tuner.Tune();
+  Check(chosen.cost >= 0, tag + ": chosen setting not measured");
+  Check(Voxelizer(munion).AllocatedMemory() == chosen.memory,
+        tag + ": memory of the union differs from the chosen setting");
+
+  // the union is left voxelized with the chosen setting
+  G4MultiUnion *reference = BuildUnion(box, positions);
+  Voxelizer(reference).SetMaxBoundary(
+      chosen.maxBoundary[0], chosen.maxBoundary[1], chosen.maxBoundary[2]);
+  Voxelizer(reference).Voxelize(reference);
+  for (G4int axis = 0; axis < 3; ++axis) {
+    Check(Voxelizer(munion).GetBoundary(axis) ==
+              Voxelizer(reference).GetBoundary(axis),
+          tag + ": boundaries differ from the chosen setting on axis " +
+              std::to_string(axis));
+  }
+  Check(InsideAgrees(munion, box, positions), tag + ": Inside differs");
+  delete reference;
+  delete munion;
+  return chosen;
+}
+
+}  // namespace
+
+int main() {
+  G4Box box("node", 0.6 * um, 0.6 * um, 1. * um);
+  const auto positions = RandomPositions(2500);
+
+  // nothing fits, the coarsest setting is taken
+  const auto coarsest = Tune("small limit", box, positions, 1);
+  Check(coarsest.maxBoundary[0] == coarsest.maxBoundary[1] &&
+            coarsest.maxBoundary[1] == coarsest.maxBoundary[2],
+        "small limit: coarsest setting not chosen");
+
+  const auto large = Tune("large limit", box, positions, 1000000000);
+  Check(large.memory <= 1000000000, "large limit: memory above the limit");
+
+  // the coarsest setting fits, finer ones may not
+  if (large.memory > coarsest.memory) {
+    const std::size_t tightLimit = (large.memory + coarsest.memory) / 2;
+    const auto tight = Tune("tight limit", box, positions, tightLimit);
+    Check(tight.memory <= tightLimit, "tight limit: memory above the limit");
+  }
+
+  return Surface::Test::Result("VoxelTuner");
+}
@@ -0,0 +1,132 @@
+// Author agent
+// Date 26-10-17
+// File: Test of the voxel build for G4MultiUnion
+// Voxelizes the same union of randomly placed boxes with one and with several
+// threads and checks that boundaries and candidates of every voxel are
+// identical, and that Inside() of the voxelized union agrees with a loop over
+// all nodes.
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "G4Box.hh"
+#include "G4MultiUnion.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+#include "Randomize.hh"
+#include "Service/include/G4Voxelizer_Green.hh"
+#include "UnitTest.hh"
+
+using Surface::Test::Check;
+
+namespace {
+
+std::vector<G4ThreeVector> RandomPositions(const G4int nodes) {
+  std::vector<G4ThreeVector> positions;
+  const G4int side = static_cast<G4int>(std::sqrt(nodes));
+  for (G4int i = 0; i < nodes; ++i) {
+    positions.emplace_back((i % side) * um, (i / side) * um,
+                           G4UniformRand() * um);
+  }
+  return positions;
+}
+
+G4MultiUnion *BuildUnion(G4Box &box,
+                         const std::vector<G4ThreeVector> &positions) {
+  auto *munion = new G4MultiUnion("union");
+  for (const auto &position : positions) {
+    munion->AddNode(box, G4Transform3D(G4RotationMatrix(), position));
+  }
+  return munion;
+}
+
+void Voxelize(G4MultiUnion *munion, const G4int threads) {
+  Surface::G4Voxelizer_Green::SetBuildThreads(threads);
+  auto &voxelizer = (Surface::G4Voxelizer_Green &)munion->GetVoxels();
+  voxelizer.SetMaxBoundary(100, 100, 100);
+  voxelizer.Voxelize(munion);
+}
+
+G4bool Identical(G4MultiUnion *first, G4MultiUnion *second) {
+  auto &a = (Surface::G4Voxelizer_Green &)first->GetVoxels();
+  auto &b = (Surface::G4Voxelizer_Green &)second->GetVoxels();
+  for (G4int axis = 0; axis < 3; ++axis) {
+    if (a.GetBoundary(axis) != b.GetBoundary(axis)) {
+      return false;
+    }
+  }
+  std::vector<G4int> voxel(3);
+  std::vector<G4int> candidatesA;
+  std::vector<G4int> candidatesB;
+  const G4int nx = static_cast<G4int>(a.GetBoundary(0).size()) - 1;
+  const G4int ny = static_cast<G4int>(a.GetBoundary(1).size()) - 1;
+  const G4int nz = static_cast<G4int>(a.GetBoundary(2).size()) - 1;
+  for (voxel[2] = 0; voxel[2] < nz; ++voxel[2]) {
+    for (voxel[1] = 0; voxel[1] < ny; ++voxel[1]) {
+      for (voxel[0] = 0; voxel[0] < nx; ++voxel[0]) {
+        a.GetCandidatesVoxelArray(voxel, candidatesA);
+        b.GetCandidatesVoxelArray(voxel, candidatesB);
+        const G4int index = a.GetVoxelsIndex(voxel);
+        if (candidatesA != candidatesB ||
+            a.IsEmpty(index) != b.IsEmpty(index) ||
+            a.GetCandidates(voxel) != b.GetCandidates(voxel)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Inside() through the voxels against a loop over all nodes
+G4bool InsideAgrees(const G4MultiUnion *munion, const G4Box &box,
+                    const std::vector<G4ThreeVector> &positions) {
+  G4ThreeVector pMin;
+  G4ThreeVector pMax;
+  munion->BoundingLimits(pMin, pMax);
+  for (G4int i = 0; i < 2000; ++i) {
+    const G4ThreeVector point{
+        pMin.x() + G4UniformRand() * (pMax.x() - pMin.x()),
+        pMin.y() + G4UniformRand() * (pMax.y() - pMin.y()),
+        pMin.z() + G4UniformRand() * (pMax.z() - pMin.z())};
+    G4bool inAnyNode{false};
+    G4bool onAnySurface{false};
+    for (const auto &position : positions) {
+      const EInside inside = box.Inside(point - position);
+      inAnyNode = inAnyNode || inside == kInside;
+      onAnySurface = onAnySurface || inside == kSurface;
+    }
+    if (onAnySurface && !inAnyNode) {
+      continue;  // surface of a node, may be inside the union
+    }
+    if ((munion->Inside(point) == kInside) != inAnyNode) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main() {
+  G4Box box("node", 0.6 * um, 0.6 * um, 1. * um);
+  for (const G4int nodes : {100, 2500}) {
+    const G4String tag = std::to_string(nodes) + " nodes";
+    const auto positions = RandomPositions(nodes);
+    auto *serial = BuildUnion(box, positions);
+    Voxelize(serial, 1);
+    for (const G4int threads : {2, 3, 8}) {
+      auto *parallel = BuildUnion(box, positions);
+      Voxelize(parallel, threads);
+      Check(Identical(serial, parallel),
+            tag + ": voxels differ with " + std::to_string(threads) +
+                " threads");
+      delete parallel;
+    }
+    Check(InsideAgrees(serial, box, positions), tag + ": Inside differs");
+    delete serial;
+  }
+
+  return Surface::Test::Result("G4Voxelizer_Green");
+}